@@ -405,6 +405,27 @@ typedef struct TigArtBlitInfo {
     /* 0028 */ TigVideoBuffer* scratch_video_buffer;
 } TigArtBlitInfo;
 
+// Art cache lookup counters, see `tig_art_cache_stats`.
+typedef struct TigArtCacheStats {
+    // Number of lookups resolved by the art id index (no path building).
+    unsigned int hits;
+
+    // Number of lookups which had to build path (and possibly load the art).
+    unsigned int misses;
+
+    // Total number of index slots inspected across all lookups. Divide by
+    // `hits + misses` to obtain average probe length.
+    unsigned int probes;
+
+    // Longest probe sequence seen so far.
+    unsigned int max_probe_length;
+
+    // Snapshot of the current cache size at the time of the call.
+    int entries;
+    int index_length;
+    int index_capacity;
+} TigArtCacheStats;
+
 typedef bool(TigArtBlitPaletteAdjustCallback)(tig_art_id_t art_id, TigPaletteModifyInfo* modify_info);
 
 int tig_art_init(TigInitInfo* init_info);
@@ -414,6 +435,20 @@ int tig_art_misc_id_create(unsigned int num, unsigned int palette, tig_art_id_t*
 void tig_art_flush();
 int tig_art_exists(tig_art_id_t art_id);
 int tig_art_touch(tig_art_id_t art_id);
+
+// Requests art to be loaded into the cache in the background.
+//
+// The file is read immediately, but decoding happens on worker threads. The
+// result is moved into the cache during `tig_art_ping`, or right away when the
+// art is requested earlier. Falls back to `tig_art_touch` when workers are not
+// available.
+int tig_art_prefetch(tig_art_id_t art_id);
+
+// Requests several arts at once, see `tig_art_prefetch`. Files are read with
+// `tig_file_read_batch`, so archived ones are inflated in parallel. Arts which
+// do not fit into the queue are loaded synchronously.
+int tig_art_prefetch_batch(const tig_art_id_t* art_ids, int count);
+
 void tig_art_set_palette_adjust_callback(TigArtBlitPaletteAdjustCallback* callback);
 TigArtBlitPaletteAdjustCallback* tig_art_get_palette_adjust_callback();
 void tig_art_cache_invalidate_palettes();
@@ -519,8 +554,24 @@ tig_art_id_t tig_art_eye_candy_id_scale_set(tig_art_id_t art_id, int value);
 int tig_art_id_flags_get(tig_art_id_t art_id);
 void tig_art_apply_palette_adjustment(tig_art_id_t art_id, TigPalette src_palette, TigPalette dst_palette);
 void tig_art_cache_set_video_memory_fullness(int fullness);
+void tig_art_cache_stats(TigArtCacheStats* stats);
+void tig_art_cache_reset_stats();
 tig_art_id_t tig_art_id_reset(tig_art_id_t art_id);
 
+// Expands RLE-encoded frame pixels at `*dst_ptr` and advances it past them.
+// Bytes between the decoded pixels and `dst_end` may be overwritten. Returns
+// `false` if the data is malformed.
+bool tig_art_rle_decode(const uint8_t* src, size_t src_size, uint8_t** dst_ptr, uint8_t* dst_end);
+
+// Enables or disables span kernels in unstretched 32 bpp `tig_art_blit` (they
+// are enabled by default). With kernels disabled every blit goes thru the
+// per-pixel loops, which is how kernels are checked.
+void tig_art_blit_set_span_enabled(bool enabled);
+
+// Returns `true` if `tig_art_blit` has a span kernel for `flags` in the
+// current color format.
+bool tig_art_blit_has_span(unsigned int flags);
+
 #ifdef __cplusplus
 }
 #endif
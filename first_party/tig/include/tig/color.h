@@ -67,6 +67,10 @@ int sub_52C540(tig_color_t color);
 unsigned int tig_color_index_of(tig_color_t color);
 unsigned int tig_color_to_24_bpp(int red, int green, int blue);
 
+// Sums the components of `cnt` colors from `src` into `dst`, saturating the
+// same way as `tig_color_add`. Uses SIMD when colors are in 8-8-8 format.
+void tig_color_add_span(uint32_t* dst, const uint32_t* src, int cnt);
+
 // Creates platform-specific color from RGB components (0-255).
 static inline tig_color_t tig_color_make(int red, int green, int blue)
 {
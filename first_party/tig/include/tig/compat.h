@@ -22,12 +22,24 @@ extern "C" {
 
 void compat_windows_path_to_native(char* path);
 void compat_resolve_path(char* path);
+
+// Drops cached directory listings affected by removing or renaming `path`:
+// the directory containing it, and `path` itself along with everything below
+// it when it is a directory. Files created in a cached directory are picked
+// up automatically.
+void compat_invalidate_path(const char* path);
+void compat_clear_path_cache();
 void compat_append_path(char* path, size_t size, const char* comp);
 void compat_join_path_ex(char* path, size_t size, ...);
 #define compat_join_path(path, size, ...) compat_join_path_ex(path, size, __VA_ARGS__, NULL)
 void compat_splitpath(const char* path, char* drive, char* dir, char* fname, char* ext);
 void compat_makepath(char* path, const char* drive, const char* dir, const char* fname, const char* ext);
 
+// Maps entire file into memory for reading. The `handle` is an opaque value
+// which should be passed to `compat_unmap_file` along with `data` and `size`.
+bool compat_map_file(const char* path, const void** data_ptr, size_t* size_ptr, void** handle_ptr);
+void compat_unmap_file(const void* data, size_t size, void* handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,12 @@ typedef struct TigDatabase {
     /* 0014 */ TigGuid guid;
     /* 0024 */ int field_24;
     /* 0028 */ char* name_table;
+
+    // Contents of the archive mapped into memory, or `NULL` if the archive
+    // could not be mapped and is accessed with regular file I/O.
+    const unsigned char* data;
+    size_t data_size;
+    void* data_handle;
 } TigDatabase;
 
 #define TIG_DATABASE_ENTRY_PLAIN 0x01
@@ -82,6 +88,32 @@ void tig_database_rewind(TigDatabaseFileHandle* stream);
 void tig_database_clearerr(TigDatabaseFileHandle* stream);
 int tig_database_feof(TigDatabaseFileHandle* stream);
 int tig_database_ferror(TigDatabaseFileHandle* stream);
+bool tig_database_view(TigDatabaseFileHandle* stream, const void** data_ptr, size_t* size_ptr);
+
+// Reads entire contents of every stream in `streams` into `buffers` (allocated
+// with `MALLOC`, the size is the entry size), spreading decompression across
+// worker threads. Stream positions are not respected and become unspecified,
+// streams are meant to be closed afterwards. `NULL` streams are skipped.
+//
+// Returns `false` if any of the streams could not be read, the corresponding
+// buffers are `NULL`.
+//
+// NOTE: Only one batch can be in flight, call from the main thread.
+bool tig_database_read_batch(TigDatabaseFileHandle** streams, void** buffers, int count);
+
+// Sets the number of batch workers, `0` reads batches on the calling thread,
+// negative value picks the count based on the number of cores (default).
+void tig_database_batch_set_workers(int count);
+void tig_database_batch_exit();
+
+// Retrieves the database and the entry the stream is reading.
+void tig_database_file_entry(TigDatabaseFileHandle* stream, TigDatabase** database_ptr, TigDatabaseEntry** entry_ptr);
+
+// Reads entire contents of the entry into a buffer allocated with `MALLOC`
+// (the size is the entry size). The entry is read through a private handle
+// which is not registered with the database, so this function can be called
+// from any thread as long as the database stays open.
+bool tig_database_read_detached(TigDatabase* database, TigDatabaseEntry* entry, void** data_ptr);
 
 #ifdef __cplusplus
 }
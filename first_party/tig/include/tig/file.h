@@ -1,6 +1,7 @@
 #ifndef TIG_FILE_H_
 #define TIG_FILE_H_
 
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "tig/guid.h"
@@ -33,6 +34,51 @@ typedef struct TigFileList {
     TigFileInfo* entries;
 } TigFileList;
 
+// Counters of file lookups in directory repositories, see
+// `tig_file_index_stats`.
+typedef struct TigFileIndexStats {
+    // Number of lookups which could be served by the index.
+    unsigned int lookups;
+
+    // Number of lookups resolved with a single probe of the known repository.
+    unsigned int hits;
+
+    // Number of lookups resolved as missing without probing repositories.
+    unsigned int negative_hits;
+
+    // Number of lookups which had to probe every directory repository.
+    unsigned int misses;
+
+    // Number of index entries which turned out to be out of date.
+    unsigned int stale;
+
+    // Number of file system probes (`fopen`, `tig_find_first_file`) made
+    // while looking up files in directory repositories.
+    unsigned int probes;
+
+    // Number of index entries dropped because of writes.
+    unsigned int invalidations;
+
+    // Number of times the entire index was dropped.
+    unsigned int flushes;
+} TigFileIndexStats;
+
+// Compress archived files with zlib. Such archives can only be read by
+// `tig_file_unarchive`, but not by the original game.
+#define TIG_FILE_ARCHIVE_COMPRESS 0x01
+
+// Write archive on the worker thread, see `tig_file_archive_wait`.
+#define TIG_FILE_ARCHIVE_BACKGROUND 0x02
+
+// Called after every file is written to the archive. When archiving in the
+// background, this function is called on the worker thread.
+typedef void(TigFileArchiveProgressFunc)(int done, int total);
+
+// Called on the main thread once a background archive is complete (see
+// `tig_file_archive_ping` and `tig_file_archive_wait`). Failed archives are
+// removed before this function is called.
+typedef void(TigFileArchiveDoneFunc)(bool success);
+
 bool tig_file_mkdir(const char* path);
 bool tig_file_rmdir(const char* path);
 bool tig_file_empty_directory(const char* path);
@@ -41,6 +87,25 @@ bool tig_file_is_directory(const char* path);
 bool tig_file_copy_directory(const char* dst, const char* src);
 bool tig_file_archive(const char* dst, const char* src);
 bool tig_file_unarchive(const char* src, const char* dst);
+
+// Archives directory into `.tfai`/`.tfaf` pair like `tig_file_archive`, but
+// with optional compression and writing in the background. The directory is
+// read into memory before this function returns, so the caller is free to
+// modify it right away. When writing in the background, the return value only
+// tells whether the archive was started, the outcome is reported to
+// `done_func`.
+bool tig_file_archive_ex(const char* dst, const char* src, unsigned int flags, TigFileArchiveProgressFunc* progress_func, TigFileArchiveDoneFunc* done_func);
+
+// Waits for the background archive (if any) to complete. Returns `false` if
+// the archive could not be written (in which case it's removed).
+bool tig_file_archive_wait();
+
+// Completes the background archive if the worker is done with it, does not
+// block.
+void tig_file_archive_ping();
+
+void tig_file_index_stats(TigFileIndexStats* stats);
+void tig_file_index_reset_stats();
 int tig_file_init(TigInitInfo* init_info);
 void tig_file_exit();
 bool tig_file_repository_add(const char* path);
@@ -81,6 +146,19 @@ void tig_file_rewind(TigFile* stream);
 void tig_file_clearerr(TigFile* stream);
 int tig_file_feof(TigFile* stream);
 int tig_file_ferror(TigFile* stream);
+
+// Provides read-only access to the entire contents of the file without
+// copying. Only available for files stored uncompressed in memory-mapped
+// archives (or compressed files which were already inflated as a whole after
+// seeking backwards), returns `false` otherwise (the caller should fall back
+// to `tig_file_fread`). The data remains valid until the stream is closed.
+bool tig_file_view(TigFile* stream, const void** data_ptr, size_t* size_ptr);
+
+// Opens read-only stream over the memory buffer. The buffer should be
+// allocated with `MALLOC`, the stream takes ownership of it and releases it when
+// closed.
+TigFile* tig_file_fopen_memory(void* data, size_t size);
+
 void sub_5308A0(int a1, int a2);
 void sub_5308C0(int a1, int a2);
 bool tig_file_lock(const char* filename, const void* owner, size_t size);
@@ -91,6 +169,45 @@ bool tig_file_copy(const char* src, const char* dst);
 
 SDL_IOStream* tig_file_io_open(const char* path, const char* mode);
 
+typedef struct TigFileBatchEntry {
+    const char* path;
+
+    // Entire contents of the file allocated with `MALLOC` (owned by the
+    // caller), or `NULL` if the file could not be read.
+    void* data;
+    size_t size;
+} TigFileBatchEntry;
+
+// Reads entire contents of several files at once. Archived files are
+// decompressed by a pool of worker threads (see
+// `tig_database_read_batch`).
+//
+// Returns `false` if any of the files could not be read.
+bool tig_file_read_batch(TigFileBatchEntry* entries, int count);
+
+// File detached from the file system by `tig_file_detach`.
+typedef struct TigFileSource {
+    // Loose file, owned by the source.
+    FILE* plain_stream;
+
+    // Archived file.
+    struct TigDatabase* database;
+    struct TigDatabaseEntry* entry;
+} TigFileSource;
+
+// Finds the file the same way `tig_file_fopen` does and detaches it from the
+// file system, so that it can be read with `tig_file_read_detached` on another
+// thread. Must be called on the main thread, repositories are not thread-safe.
+bool tig_file_detach(const char* path, TigFileSource* source);
+
+// Reads entire contents of the detached file into a buffer allocated with
+// `MALLOC`, and releases the source. Only touches handles of its own, so it can
+// be called from any thread as long as the repositories stay in place.
+bool tig_file_read_detached(TigFileSource* source, void** data_ptr, size_t* size_ptr);
+
+// Releases the detached file which is not going to be read.
+void tig_file_source_release(TigFileSource* source);
+
 #ifdef __cplusplus
 }
 #endif
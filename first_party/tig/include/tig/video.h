@@ -107,6 +107,25 @@ typedef struct TigVideoBufferSaveToBmpInfo {
     /* 010C */ TigRect* rect;
 } TigVideoBufferSaveToBmpInfo;
 
+// Main surface to texture upload counters, see `tig_video_upload_stats`.
+typedef struct TigVideoUploadStats {
+    // Number of flips.
+    unsigned int frames;
+
+    // Number of flips which uploaded entire surface (first frame, gamma
+    // changes).
+    unsigned int full_uploads;
+
+    // Number of `SDL_UpdateTexture` calls.
+    unsigned int rects;
+
+    // Number of bytes uploaded during the last flip.
+    uint64_t last_frame_bytes;
+
+    // Number of bytes uploaded since the stats were reset.
+    uint64_t total_bytes;
+} TigVideoUploadStats;
+
 int tig_video_init(TigInitInfo* init_info);
 void tig_video_exit();
 int tig_video_window_get(SDL_Window** window_ptr);
@@ -126,6 +145,8 @@ int tig_video_3d_end_scene();
 int tig_video_check_gamma_control();
 int tig_video_fade(tig_color_t color, int steps, float duration, TigFadeFlags flags);
 int tig_video_set_gamma(float gamma);
+void tig_video_upload_stats(TigVideoUploadStats* stats);
+void tig_video_upload_reset_stats();
 int tig_video_buffer_create(TigVideoBufferCreateInfo* vb_create_info, TigVideoBuffer** video_buffer);
 int tig_video_buffer_destroy(TigVideoBuffer* video_buffer);
 int tig_video_buffer_data(TigVideoBuffer* video_buffer, TigVideoBufferData* video_buffer_data);
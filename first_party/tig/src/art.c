@@ -3,6 +3,14 @@
 #include <limits.h>
 #include <stdio.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ART_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ART_NEON
+#endif
+
 #include "tig/bmp.h"
 #include "tig/color.h"
 #include "tig/core.h"
@@ -143,6 +151,51 @@ typedef struct TigArtHeader {
 
 #define TIG_ART_CACHE_ENTRY_MODIFIED 0x02
 
+typedef struct TigArtCacheIndexSlot {
+    tig_art_id_t key;
+    int cache_entry_index;
+} TigArtCacheIndexSlot;
+
+#define TIG_ART_CACHE_INDEX_INITIAL_CAPACITY 1024
+
+// Cursor over art file contents read into memory.
+typedef struct TigArtFileReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+} TigArtFileReader;
+
+#define TIG_ART_PREFETCH_MAX_JOBS 64
+#define TIG_ART_PREFETCH_MAX_WORKERS 4
+
+typedef enum TigArtPrefetchJobState {
+    TIG_ART_PREFETCH_JOB_FREE,
+    TIG_ART_PREFETCH_JOB_QUEUED,
+    TIG_ART_PREFETCH_JOB_DECODING,
+    TIG_ART_PREFETCH_JOB_DONE,
+} TigArtPrefetchJobState;
+
+typedef struct TigArtPrefetchJob {
+    TigArtPrefetchJobState state;
+    unsigned int seq;
+    tig_art_id_t key;
+    tig_art_id_t art_id;
+    char path[TIG_MAX_PATH];
+    uint8_t* data;
+    size_t data_size;
+    TigArtHeader hdr;
+    uint32_t* raw_palette_tbl[MAX_PALETTES];
+    art_size_t size;
+    int rc;
+} TigArtPrefetchJob;
+
+// Blits a single row of `count` pixels from palette-indexed `src` (advancing by
+// `src_step`) into 32 bpp `dst`, see `art_blit_span_func`.
+//
+// The `alpha` is the constant alpha for translucent spans, `phase` is the
+// checkerboard parity of the first pixel for stippled spans.
+typedef void(ArtBlitSpanFunc)(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase);
+
 typedef struct TigArtCacheEntry {
     /* 0000 */ unsigned int flags;
     /* 0004 */ char path[TIG_MAX_PATH];
@@ -161,21 +214,47 @@ static int art_get_video_buffer(int cache_entry_index, tig_art_id_t art_id, TigV
 static int art_blit_flags_to_video_blit_flags(unsigned int art_blt_flags, unsigned int* vb_blt_flags_ptr);
 static int art_blit_software(int cache_entry_index, TigArtBlitInfo* blit_info);
 static int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info);
+static ArtBlitSpanFunc* art_blit_span_func(unsigned int flags);
 static int tig_art_cache_get_or_load_entry(tig_art_id_t art_id);
 static void tig_art_cache_check_fullness();
 static int tig_art_cache_entry_compare_time(const void* a1, const void* a2);
 static int tig_art_cache_entry_compare_name(const void* a1, const void* a2);
 static int tig_art_build_path(unsigned int art_id, char* path);
 static bool tig_art_cache_find(const char* path, int* index);
+static tig_art_id_t tig_art_cache_index_key(tig_art_id_t art_id);
+static bool tig_art_cache_index_find(tig_art_id_t key, int* cache_entry_index_ptr);
+static void tig_art_cache_index_insert(tig_art_id_t key, int cache_entry_index);
+static void tig_art_cache_index_shift(int cache_entry_index);
+static void tig_art_cache_index_grow();
+static void tig_art_cache_index_clear();
 static bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int index);
 static void tig_art_cache_entry_unload(int cache_entry_index);
 static void art_invalidate(int cache_entry_index);
 static void tig_art_cache_entry_free_video_buffers(int cache_entry_index);
-static int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, void** palettes, int a5, art_size_t* size_ptr);
+static void tig_art_cache_entry_insert(tig_art_id_t art_id, const char* path, int cache_entry_index, TigArtHeader* hdr, TigPalette* palette_tbl, art_size_t size);
+static int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, TigPalette* palette_tbl, art_size_t* size_ptr);
+static int tig_art_file_read(const char* filename, uint8_t** data_ptr, size_t* size_ptr);
+static int tig_art_file_read_stream(TigFile* stream, uint8_t** data_ptr, size_t* size_ptr);
+static int tig_art_file_decode(tig_art_id_t art_id, const uint8_t* data, size_t data_size, TigArtHeader* hdr, uint32_t** raw_palette_tbl, art_size_t* size_ptr);
+static void art_blit_span_copy(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase);
+static void art_blit_span_add(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase);
+static void art_blit_span_sub(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase);
+static void art_blit_span_alpha_const(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase);
+static void art_blit_span_stipple(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase);
+static void tig_art_file_load_palettes(tig_art_id_t art_id, TigArtHeader* hdr, uint32_t** raw_palette_tbl, TigPalette* palette_tbl, art_size_t* size_ptr);
 static int art_header_get_num_rotations(TigArtHeader* hdr);
-static void tig_art_file_load_cleanup(TigFile* stream, TigArtHeader* hdr, TigPalette* palette_tbl);
+static void tig_art_file_load_cleanup(TigArtHeader* hdr, uint32_t** raw_palette_tbl);
 static void art_header_free_frame_data(TigArtHeader* hdr);
-static bool art_read_header(TigArtHeader* hdr, TigFile* stream);
+static bool art_read_header(TigArtHeader* hdr, TigArtFileReader* reader);
+static bool tig_art_prefetch_init();
+static void tig_art_prefetch_exit();
+static int SDLCALL tig_art_prefetch_worker(void* userdata);
+static TigArtPrefetchJob* tig_art_prefetch_find_job(tig_art_id_t key);
+static TigArtPrefetchJob* tig_art_prefetch_alloc_job();
+static bool tig_art_prefetch_complete(tig_art_id_t key, int cache_entry_index);
+static void tig_art_prefetch_publish(TigArtPrefetchJob* job);
+static void tig_art_prefetch_discard(TigArtPrefetchJob* job);
+static void tig_art_prefetch_cancel_all();
 
 // 0x5BE880
 static int tig_art_tile_edge_map_1[16] = {
@@ -368,6 +447,46 @@ static TigArtIdResetFunc* tig_art_id_reset_func;
 // 0x604754
 static int tig_art_check_stretch_blit_divide_by_zero;
 
+// Open-addressing hash index from normalized art id (see
+// `tig_art_cache_index_key`) to cache entry index. It sits in front of the
+// path-sorted `tig_art_cache_entries` so that resident art can be found
+// without building path.
+//
+// The index is kept in sync on insertion (which shifts cache entries), and
+// simply dropped when cache entries are reordered or evicted. Dropped keys are
+// re-added lazily on the next lookup.
+static TigArtCacheIndexSlot* tig_art_cache_index_slots;
+
+// Number of slots in `tig_art_cache_index_slots`. Always a power of two.
+static int tig_art_cache_index_capacity;
+
+// Number of occupied slots in `tig_art_cache_index_slots`.
+static int tig_art_cache_index_length;
+
+static TigArtCacheStats tig_art_cache_stats_data;
+
+// Prefetch worker pool.
+//
+// Art files are read on the main thread (file system is not thread-safe), and
+// decoded (header parsing, RLE unpacking, mirroring) by workers. Decoded art
+// is moved into the cache on the main thread, either in `tig_art_ping`, or
+// on demand when the art is requested before that.
+//
+// The mutex guards job states. Job contents are owned by whoever moved job
+// into `QUEUED` (main thread), `DECODING` (worker), or `DONE` (main thread)
+// state.
+static SDL_Mutex* tig_art_prefetch_mutex;
+static SDL_Condition* tig_art_prefetch_queued_cond;
+static SDL_Condition* tig_art_prefetch_done_cond;
+static SDL_Thread* tig_art_prefetch_workers[TIG_ART_PREFETCH_MAX_WORKERS];
+static int tig_art_prefetch_workers_count;
+static bool tig_art_prefetch_quit;
+static unsigned int tig_art_prefetch_seq;
+static TigArtPrefetchJob tig_art_prefetch_jobs[TIG_ART_PREFETCH_MAX_JOBS];
+
+// Whether `art_blit` uses span kernels, see `tig_art_blit_set_span_enabled`.
+static bool tig_art_blit_span_enabled = true;
+
 // 0x500590
 int tig_art_init(TigInitInfo* init_info)
 {
@@ -382,6 +501,11 @@ int tig_art_init(TigInitInfo* init_info)
     tig_art_cache_entries_length = 0;
     tig_art_cache_entries = (TigArtCacheEntry*)MALLOC(sizeof(TigArtCacheEntry) * tig_art_cache_entries_capacity);
 
+    tig_art_cache_index_capacity = TIG_ART_CACHE_INDEX_INITIAL_CAPACITY;
+    tig_art_cache_index_slots = (TigArtCacheIndexSlot*)MALLOC(sizeof(TigArtCacheIndexSlot) * tig_art_cache_index_capacity);
+    tig_art_cache_index_clear();
+    tig_art_cache_reset_stats();
+
     tig_memory_get_system_status(&total_memory, &available_memory);
 
     // Prevent overlow on x64.
@@ -405,6 +529,10 @@ int tig_art_init(TigInitInfo* init_info)
 
     tig_art_use_3d_textures = tig_video_3d_check_initialized() == TIG_OK;
 
+    if (!tig_art_prefetch_init()) {
+        tig_debug_printf("Art: prefetch workers are not available, prefetch is synchronous\n");
+    }
+
     return TIG_OK;
 }
 
@@ -412,6 +540,7 @@ int tig_art_init(TigInitInfo* init_info)
 void tig_art_exit()
 {
     if (tig_art_initialized) {
+        tig_art_prefetch_exit();
         tig_art_flush();
 
         if (tig_art_cache_entries != NULL) {
@@ -421,6 +550,13 @@ void tig_art_exit()
             tig_art_cache_entries_capacity = 0;
         }
 
+        if (tig_art_cache_index_slots != NULL) {
+            FREE(tig_art_cache_index_slots);
+            tig_art_cache_index_slots = NULL;
+            tig_art_cache_index_capacity = 0;
+            tig_art_cache_index_length = 0;
+        }
+
         tig_art_initialized = false;
     }
 }
@@ -428,6 +564,22 @@ void tig_art_exit()
 // 0x5006D0
 void tig_art_ping()
 {
+    int index;
+    bool done;
+
+    if (tig_art_prefetch_workers_count == 0) {
+        return;
+    }
+
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        done = tig_art_prefetch_jobs[index].state == TIG_ART_PREFETCH_JOB_DONE;
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+        if (done) {
+            tig_art_prefetch_publish(&(tig_art_prefetch_jobs[index]));
+        }
+    }
 }
 
 // 0x501DD0
@@ -454,11 +606,14 @@ void tig_art_flush()
         return;
     }
 
+    tig_art_prefetch_cancel_all();
+
     for (index = 0; index < tig_art_cache_entries_length; index++) {
         tig_art_cache_entry_unload(index);
     }
 
     tig_art_cache_entries_length = 0;
+    tig_art_cache_index_clear();
 }
 
 // 0x502220
@@ -489,6 +644,200 @@ int tig_art_touch(tig_art_id_t art_id)
     return TIG_OK;
 }
 
+int tig_art_prefetch(tig_art_id_t art_id)
+{
+    tig_art_id_t key;
+    char path[TIG_MAX_PATH];
+    int cache_entry_index;
+    TigArtPrefetchJob* job;
+    int rc;
+
+    if (tig_art_prefetch_workers_count == 0) {
+        return tig_art_touch(art_id);
+    }
+
+    key = tig_art_cache_index_key(art_id);
+
+    if (tig_art_cache_index_find(key, &cache_entry_index)) {
+        return TIG_OK;
+    }
+
+    SDL_LockMutex(tig_art_prefetch_mutex);
+    job = tig_art_prefetch_find_job(key);
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    if (job != NULL) {
+        return TIG_OK;
+    }
+
+    if (tig_art_build_path(art_id, path) != TIG_OK) {
+        return TIG_ERR_GENERIC;
+    }
+
+    if (tig_art_cache_find(path, &cache_entry_index)) {
+        tig_art_cache_index_insert(key, cache_entry_index);
+        return TIG_OK;
+    }
+
+    job = tig_art_prefetch_alloc_job();
+    if (job == NULL) {
+        // Queue is full, try to make some room by moving finished jobs into
+        // the cache.
+        tig_art_ping();
+
+        job = tig_art_prefetch_alloc_job();
+        if (job == NULL) {
+            return TIG_ERR_OUT_OF_HANDLES;
+        }
+    }
+
+    rc = tig_art_file_read(path, &(job->data), &(job->data_size));
+    if (rc != TIG_OK) {
+        // Let synchronous path deal with missing art (it falls back to
+        // `badart.art`).
+        return rc;
+    }
+
+    job->key = key;
+    job->art_id = art_id;
+    strcpy(job->path, path);
+    job->rc = TIG_ERR_GENERIC;
+
+    SDL_LockMutex(tig_art_prefetch_mutex);
+    job->seq = tig_art_prefetch_seq++;
+    job->state = TIG_ART_PREFETCH_JOB_QUEUED;
+    SDL_SignalCondition(tig_art_prefetch_queued_cond);
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    return TIG_OK;
+}
+
+int tig_art_prefetch_batch(const tig_art_id_t* art_ids, int count)
+{
+    TigFileBatchEntry* entries;
+    tig_art_id_t* keys;
+    tig_art_id_t* ids;
+    char(*paths)[TIG_MAX_PATH];
+    tig_art_id_t key;
+    int cache_entry_index;
+    TigArtPrefetchJob* job;
+    int free_jobs;
+    int batch_size;
+    int index;
+    int other;
+
+    if (tig_art_prefetch_workers_count == 0) {
+        for (index = 0; index < count; index++) {
+            tig_art_touch(art_ids[index]);
+        }
+        return TIG_OK;
+    }
+
+    // Make some room by moving finished jobs into the cache.
+    tig_art_ping();
+
+    // Only the main thread takes free jobs, so they can be counted up front.
+    free_jobs = 0;
+    SDL_LockMutex(tig_art_prefetch_mutex);
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        if (tig_art_prefetch_jobs[index].state == TIG_ART_PREFETCH_JOB_FREE) {
+            free_jobs++;
+        }
+    }
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    entries = (TigFileBatchEntry*)MALLOC(sizeof(*entries) * count);
+    keys = (tig_art_id_t*)MALLOC(sizeof(*keys) * count);
+    ids = (tig_art_id_t*)MALLOC(sizeof(*ids) * count);
+    paths = (char(*)[TIG_MAX_PATH])MALLOC(sizeof(*paths) * count);
+
+    batch_size = 0;
+    for (index = 0; index < count; index++) {
+        key = tig_art_cache_index_key(art_ids[index]);
+
+        if (tig_art_cache_index_find(key, &cache_entry_index)) {
+            continue;
+        }
+
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        job = tig_art_prefetch_find_job(key);
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+        if (job != NULL) {
+            continue;
+        }
+
+        for (other = 0; other < batch_size; other++) {
+            if (keys[other] == key) {
+                break;
+            }
+        }
+
+        if (other < batch_size) {
+            continue;
+        }
+
+        if (tig_art_build_path(art_ids[index], paths[batch_size]) != TIG_OK) {
+            continue;
+        }
+
+        if (tig_art_cache_find(paths[batch_size], &cache_entry_index)) {
+            tig_art_cache_index_insert(key, cache_entry_index);
+            continue;
+        }
+
+        if (batch_size == free_jobs) {
+            // Queue is full, load the rest synchronously.
+            tig_art_touch(art_ids[index]);
+            continue;
+        }
+
+        keys[batch_size] = key;
+        ids[batch_size] = art_ids[index];
+        entries[batch_size].path = paths[batch_size];
+        batch_size++;
+    }
+
+    // Archived files are inflated by the batch workers in parallel.
+    if (batch_size != 0) {
+        tig_file_read_batch(entries, batch_size);
+    }
+
+    for (index = 0; index < batch_size; index++) {
+        if (entries[index].data == NULL) {
+            // Let synchronous path deal with missing art (it falls back to
+            // `badart.art`).
+            continue;
+        }
+
+        if (entries[index].size == 0) {
+            FREE(entries[index].data);
+            continue;
+        }
+
+        job = tig_art_prefetch_alloc_job();
+        job->data = (uint8_t*)entries[index].data;
+        job->data_size = entries[index].size;
+        job->key = keys[index];
+        job->art_id = ids[index];
+        strcpy(job->path, paths[index]);
+        job->rc = TIG_ERR_GENERIC;
+
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        job->seq = tig_art_prefetch_seq++;
+        job->state = TIG_ART_PREFETCH_JOB_QUEUED;
+        SDL_SignalCondition(tig_art_prefetch_queued_cond);
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+    }
+
+    FREE(paths);
+    FREE(ids);
+    FREE(keys);
+    FREE(entries);
+
+    return TIG_OK;
+}
+
 // 0x5022B0
 void tig_art_set_palette_adjust_callback(TigArtBlitPaletteAdjustCallback* callback)
 {
@@ -1305,6 +1654,11 @@ int tig_art_frame_get_raw_pixels(tig_art_id_t art_id, uint8_t* dst, int pitch)
     while (height > 0) {
         memcpy(dst, src, width);
         dst += pitch;
+
+        // FIX: Advance source row, otherwise every row is a copy of the first
+        // one.
+        src += width;
+
         height--;
     }
 
@@ -3146,6 +3500,7 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
     int src_checkerboard_cur_y;
     int dst_checkerboard_cur_x;
     int dst_checkerboard_cur_y;
+    ArtBlitSpanFunc* span_func;
 
     rc = tig_video_buffer_lock(blit_info->dst_video_buffer);
     if (rc != TIG_OK) {
@@ -5121,7 +5476,24 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
             }
         } else {
             // 0x50655B
-            if ((blit_info->flags & TIG_ART_BLT_BLEND_ADD) != 0) {
+            span_func = tig_art_bits_per_pixel == 32 && tig_art_blit_span_enabled
+                ? art_blit_span_func(blit_info->flags)
+                : NULL;
+            if (span_func != NULL) {
+                for (y = 0; y < dst_rect.height; y++) {
+                    span_func((uint32_t*)dst_pixels,
+                        src_pixels,
+                        src_step,
+                        (uint32_t*)plt,
+                        dst_rect.width,
+                        blit_info->alpha[0],
+                        (blit_info->flags & TIG_ART_BLT_BLEND_ALPHA_STIPPLE_S) != 0
+                            ? (src_rect.x ^ (src_rect.y + y)) & 1
+                            : (dst_rect.x ^ (dst_rect.y + y)) & 1);
+                    src_pixels += src_step * dst_rect.width + src_pitch;
+                    dst_pixels += 4 * dst_rect.width + dst_skip;
+                }
+            } else if ((blit_info->flags & TIG_ART_BLT_BLEND_ADD) != 0) {
                 // 0x506566
                 switch (tig_art_bits_per_pixel) {
                 case 32:
@@ -5364,31 +5736,39 @@ int art_blit(int cache_entry_index, TigArtBlitInfo* blit_info)
 int tig_art_cache_get_or_load_entry(tig_art_id_t art_id)
 {
     char path[TIG_MAX_PATH];
+    tig_art_id_t key;
     int cache_entry_index;
 
-    if (tig_art_build_path(art_id, path) != TIG_OK) {
-        return -1;
-    }
-
-    if (tig_art_cache_last_index < tig_art_cache_entries_length
-        && strcmp(path, tig_art_cache_entries[tig_art_cache_last_index].path) == 0) {
-        tig_art_cache_entries[tig_art_cache_last_index].time = tig_ping_timestamp;
-        return tig_art_cache_last_index;
-    }
-
     // Called twice to check both system and video memory.
     tig_art_cache_check_fullness();
     tig_art_cache_check_fullness();
 
-    if (!tig_art_cache_find(path, &cache_entry_index)) {
-        if (!tig_art_cache_entry_load(art_id, path, cache_entry_index)) {
-            tig_debug_printf("ART LOAD FAILURE!!! Trying to load %s\n", path);
+    key = tig_art_cache_index_key(art_id);
+
+    if (tig_art_cache_index_find(key, &cache_entry_index)) {
+        tig_art_cache_stats_data.hits++;
+    } else {
+        tig_art_cache_stats_data.misses++;
+
+        if (tig_art_build_path(art_id, path) != TIG_OK) {
+            return -1;
+        }
+
+        // The entry might be resident under another key which resolves to the
+        // same path (e.g. different rotation of a tile).
+        if (!tig_art_cache_find(path, &cache_entry_index)) {
+            if (!tig_art_prefetch_complete(key, cache_entry_index)
+                && !tig_art_cache_entry_load(art_id, path, cache_entry_index)) {
+                tig_debug_printf("ART LOAD FAILURE!!! Trying to load %s\n", path);
 
-            if (!tig_art_cache_entry_load(art_id, "art\\badart.art", cache_entry_index)) {
-                tig_debug_printf("ART LOAD FAILURE!!! Trying to load badart.art\n");
-                return -1;
+                if (!tig_art_cache_entry_load(art_id, "art\\badart.art", cache_entry_index)) {
+                    tig_debug_printf("ART LOAD FAILURE!!! Trying to load badart.art\n");
+                    return -1;
+                }
             }
         }
+
+        tig_art_cache_index_insert(key, cache_entry_index);
     }
 
     tig_art_cache_entries[cache_entry_index].time = tig_ping_timestamp;
@@ -5479,6 +5859,10 @@ void tig_art_cache_check_fullness()
         return;
     }
 
+    // Cache entries are about to be moved around, slots stored in the index
+    // are no longer valid.
+    tig_art_cache_index_clear();
+
     cnt = index + 1;
 
     // Free cache entries.
@@ -5609,12 +5993,167 @@ bool tig_art_cache_find(const char* path, int* index)
     return false;
 }
 
+// Returns the key used in `tig_art_cache_index_slots`.
+//
+// The key is art id reset to its canonical form (no palette, frame, and, where
+// appropriate, rotation), which is the same normalization the path resolver
+// applies, so that two art ids with the same key always refer to the same
+// file.
+tig_art_id_t tig_art_cache_index_key(tig_art_id_t art_id)
+{
+    return tig_art_id_reset(art_id);
+}
+
+static inline unsigned int tig_art_cache_index_hash(tig_art_id_t key)
+{
+    // Integer finalizer, the mask is applied by the caller. Art ids differ
+    // mostly in high bits (type, num), so they must be mixed down.
+    key ^= key >> 16;
+    key *= 0x45D9F3Bu;
+    key ^= key >> 16;
+    return key;
+}
+
+bool tig_art_cache_index_find(tig_art_id_t key, int* cache_entry_index_ptr)
+{
+    unsigned int mask;
+    unsigned int slot;
+    unsigned int probes;
+
+    mask = (unsigned int)tig_art_cache_index_capacity - 1;
+    slot = tig_art_cache_index_hash(key) & mask;
+    probes = 1;
+
+    while (tig_art_cache_index_slots[slot].cache_entry_index != -1) {
+        if (tig_art_cache_index_slots[slot].key == key) {
+            break;
+        }
+
+        slot = (slot + 1) & mask;
+        probes++;
+    }
+
+    tig_art_cache_stats_data.probes += probes;
+    if (tig_art_cache_stats_data.max_probe_length < probes) {
+        tig_art_cache_stats_data.max_probe_length = probes;
+    }
+
+    if (tig_art_cache_index_slots[slot].cache_entry_index == -1) {
+        return false;
+    }
+
+    *cache_entry_index_ptr = tig_art_cache_index_slots[slot].cache_entry_index;
+    return true;
+}
+
+void tig_art_cache_index_insert(tig_art_id_t key, int cache_entry_index)
+{
+    unsigned int mask;
+    unsigned int slot;
+
+    // Keep load factor at or below 1/2.
+    if ((tig_art_cache_index_length + 1) * 2 > tig_art_cache_index_capacity) {
+        tig_art_cache_index_grow();
+    }
+
+    mask = (unsigned int)tig_art_cache_index_capacity - 1;
+    slot = tig_art_cache_index_hash(key) & mask;
+
+    while (tig_art_cache_index_slots[slot].cache_entry_index != -1) {
+        if (tig_art_cache_index_slots[slot].key == key) {
+            tig_art_cache_index_slots[slot].cache_entry_index = cache_entry_index;
+            return;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    tig_art_cache_index_slots[slot].key = key;
+    tig_art_cache_index_slots[slot].cache_entry_index = cache_entry_index;
+    tig_art_cache_index_length++;
+}
+
+// Accounts for the new cache entry inserted at `cache_entry_index`, which
+// shifts subsequent cache entries by one.
+void tig_art_cache_index_shift(int cache_entry_index)
+{
+    int index;
+
+    for (index = 0; index < tig_art_cache_index_capacity; index++) {
+        if (tig_art_cache_index_slots[index].cache_entry_index >= cache_entry_index) {
+            tig_art_cache_index_slots[index].cache_entry_index++;
+        }
+    }
+}
+
+void tig_art_cache_index_grow()
+{
+    TigArtCacheIndexSlot* old_slots;
+    int old_capacity;
+    int index;
+
+    old_slots = tig_art_cache_index_slots;
+    old_capacity = tig_art_cache_index_capacity;
+
+    tig_art_cache_index_capacity *= 2;
+    tig_art_cache_index_slots = (TigArtCacheIndexSlot*)MALLOC(sizeof(TigArtCacheIndexSlot) * tig_art_cache_index_capacity);
+    tig_art_cache_index_clear();
+
+    for (index = 0; index < old_capacity; index++) {
+        if (old_slots[index].cache_entry_index != -1) {
+            tig_art_cache_index_insert(old_slots[index].key, old_slots[index].cache_entry_index);
+        }
+    }
+
+    FREE(old_slots);
+}
+
+void tig_art_cache_index_clear()
+{
+    int index;
+
+    for (index = 0; index < tig_art_cache_index_capacity; index++) {
+        tig_art_cache_index_slots[index].cache_entry_index = -1;
+    }
+
+    tig_art_cache_index_length = 0;
+}
+
+void tig_art_cache_stats(TigArtCacheStats* stats)
+{
+    *stats = tig_art_cache_stats_data;
+    stats->entries = tig_art_cache_entries_length;
+    stats->index_length = tig_art_cache_index_length;
+    stats->index_capacity = tig_art_cache_index_capacity;
+}
+
+void tig_art_cache_reset_stats()
+{
+    memset(&tig_art_cache_stats_data, 0, sizeof(tig_art_cache_stats_data));
+}
+
 // 0x51B170
 bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_entry_index)
 {
-    TigArtCacheEntry* art;
-    int rc;
+    TigArtHeader hdr;
+    TigPalette palette_tbl[MAX_PALETTES];
     art_size_t size;
+
+    if (tig_art_file_load(art_id, path, &hdr, palette_tbl, &size) != TIG_OK) {
+        return false;
+    }
+
+    tig_art_cache_entry_insert(art_id, path, cache_entry_index, &hdr, palette_tbl, size);
+
+    return true;
+}
+
+// Inserts fully loaded art at `cache_entry_index` (which should be obtained
+// from `tig_art_cache_find`). The cache takes ownership of header data and
+// palettes.
+void tig_art_cache_entry_insert(tig_art_id_t art_id, const char* path, int cache_entry_index, TigArtHeader* hdr, TigPalette* palette_tbl, art_size_t size)
+{
+    TigArtCacheEntry* art;
     int type;
     int start;
     int num_rotations;
@@ -5622,6 +6161,7 @@ bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_e
     int index;
     int frame;
     int offset;
+    int palette;
 
     if (tig_art_cache_entries_length == tig_art_cache_entries_capacity - 1) {
         tig_art_cache_entries_capacity += 32;
@@ -5637,18 +6177,11 @@ bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_e
 
     memset(art, 0, sizeof(TigArtCacheEntry));
     strcpy(art->path, path);
+    art->art_id = art_id;
+    art->hdr = *hdr;
 
-    rc = tig_art_file_load(art_id,
-        path,
-        &(art->hdr),
-        art->palette_tbl,
-        0,
-        &size);
-    if (rc != TIG_OK) {
-        memmove(&(tig_art_cache_entries[cache_entry_index]),
-            &(tig_art_cache_entries[cache_entry_index + 1]),
-            sizeof(TigArtCacheEntry) * (tig_art_cache_entries_length - cache_entry_index));
-        return false;
+    for (palette = 0; palette < MAX_PALETTES; palette++) {
+        art->palette_tbl[palette] = palette_tbl[palette];
     }
 
     art->system_memory_usage += size;
@@ -5691,7 +6224,7 @@ bool tig_art_cache_entry_load(tig_art_id_t art_id, const char* path, int cache_e
     tig_art_cache_entries_length++;
     tig_art_available_system_memory -= art->system_memory_usage;
 
-    return true;
+    tig_art_cache_index_shift(cache_entry_index);
 }
 
 // 0x51B490
@@ -5793,108 +6326,147 @@ void tig_art_cache_entry_free_video_buffers(int cache_entry_index)
 }
 
 // 0x51B710
-int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, void** palette_tbl, int a5, art_size_t* size_ptr)
+int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* hdr, TigPalette* palette_tbl, art_size_t* size_ptr)
 {
     TigFile* stream;
-    int rotation;
-    int palette;
-    uint32_t* saved_palette_tbl[MAX_PALETTES];
-    uint32_t temp_palette_entries[256];
-    art_size_t size_tbl[MAX_ROTATIONS];
-    int index;
-    int frame;
-    int current_palette_index;
-    void* current_palette;
-    int num_rotations;
-
-    // NOTE: Keep compiler happy.
-    current_palette_index = 0;
-    current_palette = NULL;
-
-    *size_ptr = 0;
-
-    for (rotation = 0; rotation < MAX_ROTATIONS; rotation++) {
-        hdr->frames_tbl[rotation] = NULL;
-        hdr->pixels_tbl[rotation] = NULL;
-    }
+    const void* view;
+    uint8_t* data;
+    size_t data_size;
+    uint32_t* raw_palette_tbl[MAX_PALETTES];
+    int rc;
 
     stream = tig_file_fopen(filename, "rb");
     if (stream == NULL) {
         return TIG_ERR_GENERIC;
     }
 
-    if (!art_read_header(hdr, stream)) {
+    // Decode straight from the archive mapping when possible.
+    if (tig_file_view(stream, &view, &data_size)) {
+        rc = tig_art_file_decode(art_id, (const uint8_t*)view, data_size, hdr, raw_palette_tbl, size_ptr);
         tig_file_fclose(stream);
-        return TIG_ERR_GENERIC;
-    }
-
-    // Only 8-bpp palette-indexed ART files are supported.
-    if (hdr->bpp != 8) {
+    } else {
+        rc = tig_art_file_read_stream(stream, &data, &data_size);
         tig_file_fclose(stream);
-        return TIG_ERR_GENERIC;
-    }
 
-    if (a5) {
-        current_palette_index = tig_art_id_palette_get(art_id);
-        if (hdr->palette_tbl[current_palette_index] != NULL) {
-            tig_file_fclose(stream);
-            return TIG_ERR_GENERIC;
+        if (rc != TIG_OK) {
+            return rc;
         }
-        current_palette = palette_tbl[0];
+
+        rc = tig_art_file_decode(art_id, data, data_size, hdr, raw_palette_tbl, size_ptr);
+        FREE(data);
     }
 
-    for (palette = 0; palette < MAX_PALETTES; palette++) {
-        saved_palette_tbl[palette] = hdr->palette_tbl[palette];
-        hdr->palette_tbl[palette] = NULL;
-        palette_tbl[palette] = NULL;
+    if (rc != TIG_OK) {
+        return rc;
     }
 
-    for (palette = 0; palette < MAX_PALETTES; palette++) {
-        if (saved_palette_tbl[palette] != NULL) {
-            if (tig_file_fread(temp_palette_entries, sizeof(uint32_t), 256, stream) != 256) {
-                tig_art_file_load_cleanup(stream, hdr, palette_tbl);
-                return TIG_ERR_GENERIC;
-            }
+    tig_art_file_load_palettes(art_id, hdr, raw_palette_tbl, palette_tbl, size_ptr);
 
-            if (a5) {
-                if (palette == current_palette_index) {
-                    for (index = 0; index < 256; index++) {
-                        ((uint32_t*)current_palette)[index] = temp_palette_entries[index];
-                    }
+    return TIG_OK;
+}
 
-                    tig_file_fclose(stream);
-                    return TIG_OK;
-                }
-            } else {
-                hdr->palette_tbl[palette] = tig_palette_create();
-                palette_tbl[palette] = tig_palette_create();
-                *size_ptr += (art_size_t)tig_palette_system_memory_size() * 2;
+// Reads entire art file into memory.
+//
+// File access is not thread-safe, so this part of loading always happens on
+// the main thread. Reading the file in one go is also much cheaper than
+// pulling it byte by byte thru the (possibly compressed) stream.
+int tig_art_file_read(const char* filename, uint8_t** data_ptr, size_t* size_ptr)
+{
+    TigFile* stream;
+    int rc;
 
-                switch (tig_art_bits_per_pixel) {
-                case 8:
-                    for (index = 0; index < 256; index++) {
-                        ((uint8_t*)hdr->palette_tbl[palette])[index] = (uint8_t)tig_color_index_of(temp_palette_entries[index]);
-                    }
-                    break;
-                case 16:
-                    for (index = 0; index < 256; index++) {
-                        ((uint16_t*)hdr->palette_tbl[palette])[index] = (uint16_t)tig_color_index_of(temp_palette_entries[index]);
-                    }
-                    break;
-                case 24:
-                    for (index = 0; index < 256; index++) {
-                        ((uint32_t*)hdr->palette_tbl[palette])[index] = (uint32_t)tig_color_index_of(temp_palette_entries[index]);
-                    }
-                    break;
-                case 32:
-                    for (index = 0; index < 256; index++) {
-                        ((uint32_t*)hdr->palette_tbl[palette])[index] = (uint32_t)tig_color_index_of(temp_palette_entries[index]);
-                    }
-                    break;
-                }
-            }
+    stream = tig_file_fopen(filename, "rb");
+    if (stream == NULL) {
+        return TIG_ERR_GENERIC;
+    }
+
+    rc = tig_art_file_read_stream(stream, data_ptr, size_ptr);
+    tig_file_fclose(stream);
+
+    return rc;
+}
+
+int tig_art_file_read_stream(TigFile* stream, uint8_t** data_ptr, size_t* size_ptr)
+{
+    int size;
+    uint8_t* data;
+
+    size = tig_file_filelength(stream);
+    if (size <= 0) {
+        return TIG_ERR_GENERIC;
+    }
+
+    data = (uint8_t*)MALLOC(size);
+    if (tig_file_fread(data, size, 1, stream) != 1) {
+        FREE(data);
+        return TIG_ERR_IO;
+    }
+
+    *data_ptr = data;
+    *size_ptr = (size_t)size;
+
+    return TIG_OK;
+}
+
+static inline bool art_reader_read(TigArtFileReader* reader, void* buffer, size_t size)
+{
+    if (reader->size - reader->pos < size) {
+        return false;
+    }
+
+    memcpy(buffer, reader->data + reader->pos, size);
+    reader->pos += size;
+
+    return true;
+}
+
+// Decodes art file previously read with `tig_art_file_read`.
+//
+// This function is thread-safe (it only touches `hdr` and `raw_palette_tbl`),
+// so it's used by both synchronous loading and prefetch workers. Palettes are
+// returned in their raw 24 bpp form, see `tig_art_file_load_palettes`.
+int tig_art_file_decode(tig_art_id_t art_id, const uint8_t* data, size_t data_size, TigArtHeader* hdr, uint32_t** raw_palette_tbl, art_size_t* size_ptr)
+{
+    TigArtFileReader reader;
+    int rotation;
+    int palette;
+    art_size_t size_tbl[MAX_ROTATIONS];
+    int index;
+    int frame;
+    int num_rotations;
+
+    reader.data = data;
+    reader.size = data_size;
+    reader.pos = 0;
+
+    *size_ptr = 0;
+
+    for (rotation = 0; rotation < MAX_ROTATIONS; rotation++) {
+        hdr->frames_tbl[rotation] = NULL;
+        hdr->pixels_tbl[rotation] = NULL;
+    }
+
+    for (palette = 0; palette < MAX_PALETTES; palette++) {
+        raw_palette_tbl[palette] = NULL;
+    }
+
+    if (!art_read_header(hdr, &reader)) {
+        return TIG_ERR_GENERIC;
+    }
+
+    // Only 8-bpp palette-indexed ART files are supported.
+    if (hdr->bpp != 8) {
+        return TIG_ERR_GENERIC;
+    }
 
-            tig_art_apply_palette_adjustment(art_id, hdr->palette_tbl[palette], palette_tbl[palette]);
+    for (palette = 0; palette < MAX_PALETTES; palette++) {
+        if (hdr->palette_tbl[palette] != NULL) {
+            hdr->palette_tbl[palette] = NULL;
+            raw_palette_tbl[palette] = (uint32_t*)MALLOC(sizeof(uint32_t) * 256);
+            if (!art_reader_read(&reader, raw_palette_tbl[palette], sizeof(uint32_t) * 256)) {
+                tig_art_file_load_cleanup(hdr, raw_palette_tbl);
+                return TIG_ERR_GENERIC;
+            }
         }
     }
 
@@ -5904,14 +6476,15 @@ int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* h
         hdr->frames_tbl[rotation] = (TigArtFileFrameData*)MALLOC(sizeof(TigArtFileFrameData) * hdr->num_frames);
         *size_ptr += sizeof(TigArtFileFrameData) * hdr->num_frames;
 
-        if (tig_file_fread(hdr->frames_tbl[rotation], sizeof(TigArtFileFrameData), hdr->num_frames, stream) != (size_t)hdr->num_frames) {
-            tig_art_file_load_cleanup(stream, hdr, palette_tbl);
+        if (!art_reader_read(&reader, hdr->frames_tbl[rotation], sizeof(TigArtFileFrameData) * hdr->num_frames)) {
+            tig_art_file_load_cleanup(hdr, raw_palette_tbl);
             return TIG_ERR_GENERIC;
         }
     }
 
     for (index = 0; index < num_rotations; index++) {
         uint8_t* bytes;
+        uint8_t* end;
         art_size_t total_size;
 
         // Calculate total size of pixels data.
@@ -5927,47 +6500,26 @@ int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* h
         size_tbl[index] = total_size;
         *size_ptr += total_size;
 
-        // Read raw pixel data for each frame.
+        // Decode pixel data for each frame.
         bytes = hdr->pixels_tbl[index];
+        end = bytes + total_size;
         for (frame = 0; frame < hdr->num_frames; ++frame) {
             if (hdr->frames_tbl[index][frame].data_size == hdr->frames_tbl[index][frame].width * hdr->frames_tbl[index][frame].height) {
-                // Pixels are not compressed, read everything in one go.
-                if (tig_file_fread(bytes, 1, hdr->frames_tbl[index][frame].data_size, stream) != (size_t)hdr->frames_tbl[index][frame].data_size) {
-                    tig_art_file_load_cleanup(stream, hdr, palette_tbl);
+                // Pixels are not compressed, copy everything in one go.
+                if (!art_reader_read(&reader, bytes, hdr->frames_tbl[index][frame].data_size)) {
+                    tig_art_file_load_cleanup(hdr, raw_palette_tbl);
                     return TIG_ERR_GENERIC;
                 }
                 bytes += hdr->frames_tbl[index][frame].data_size;
             } else if (hdr->frames_tbl[index][frame].data_size > 0) {
                 // Pixels are RLE-encoded.
-                uint8_t value;
-                uint8_t color;
-                int len;
-                int cnt = 0;
-
-                while (cnt < hdr->frames_tbl[index][frame].data_size) {
-                    if (tig_file_fread(&value, 1, 1, stream) != 1) {
-                        tig_art_file_load_cleanup(stream, hdr, palette_tbl);
-                        return TIG_ERR_GENERIC;
-                    }
-
-                    len = value & 0x7F;
-                    if ((value & 0x80) != 0) {
-                        if (tig_file_fread(bytes, 1, len, stream) != (size_t)len) {
-                            tig_art_file_load_cleanup(stream, hdr, palette_tbl);
-                            return TIG_ERR_GENERIC;
-                        }
-                        cnt += 1 + len;
-                    } else {
-                        if (tig_file_fread(&color, 1, 1, stream) != 1) {
-                            tig_art_file_load_cleanup(stream, hdr, palette_tbl);
-                            return TIG_ERR_GENERIC;
-                        }
-
-                        memset(bytes, color, len);
-                        cnt += 2;
-                    }
-                    bytes += len;
+                if (reader.size - reader.pos < (size_t)hdr->frames_tbl[index][frame].data_size
+                    || !tig_art_rle_decode(reader.data + reader.pos, hdr->frames_tbl[index][frame].data_size, &bytes, end)) {
+                    tig_art_file_load_cleanup(hdr, raw_palette_tbl);
+                    return TIG_ERR_GENERIC;
                 }
+
+                reader.pos += hdr->frames_tbl[index][frame].data_size;
             }
         }
     }
@@ -5997,10 +6549,381 @@ int tig_art_file_load(tig_art_id_t art_id, const char* filename, TigArtHeader* h
         }
     }
 
-    tig_file_fclose(stream);
     return TIG_OK;
 }
 
+// Converts raw palettes produced by `tig_art_file_decode` into video palettes
+// and releases raw palettes.
+//
+// Must be called on the main thread (palettes are pooled, and palette
+// adjustment callback belongs to the game).
+void tig_art_file_load_palettes(tig_art_id_t art_id, TigArtHeader* hdr, uint32_t** raw_palette_tbl, TigPalette* palette_tbl, art_size_t* size_ptr)
+{
+    int palette;
+    int index;
+
+    for (palette = 0; palette < MAX_PALETTES; palette++) {
+        hdr->palette_tbl[palette] = NULL;
+        palette_tbl[palette] = NULL;
+
+        if (raw_palette_tbl[palette] == NULL) {
+            continue;
+        }
+
+        hdr->palette_tbl[palette] = tig_palette_create();
+        palette_tbl[palette] = tig_palette_create();
+        *size_ptr += (art_size_t)tig_palette_system_memory_size() * 2;
+
+        switch (tig_art_bits_per_pixel) {
+        case 8:
+            for (index = 0; index < 256; index++) {
+                ((uint8_t*)hdr->palette_tbl[palette])[index] = (uint8_t)tig_color_index_of(raw_palette_tbl[palette][index]);
+            }
+            break;
+        case 16:
+            for (index = 0; index < 256; index++) {
+                ((uint16_t*)hdr->palette_tbl[palette])[index] = (uint16_t)tig_color_index_of(raw_palette_tbl[palette][index]);
+            }
+            break;
+        case 24:
+            for (index = 0; index < 256; index++) {
+                ((uint32_t*)hdr->palette_tbl[palette])[index] = (uint32_t)tig_color_index_of(raw_palette_tbl[palette][index]);
+            }
+            break;
+        case 32:
+            for (index = 0; index < 256; index++) {
+                ((uint32_t*)hdr->palette_tbl[palette])[index] = (uint32_t)tig_color_index_of(raw_palette_tbl[palette][index]);
+            }
+            break;
+        }
+
+        tig_art_apply_palette_adjustment(art_id, hdr->palette_tbl[palette], palette_tbl[palette]);
+
+        FREE(raw_palette_tbl[palette]);
+        raw_palette_tbl[palette] = NULL;
+    }
+}
+
+bool tig_art_prefetch_init()
+{
+    int count;
+    int index;
+    char name[16];
+
+    tig_art_prefetch_workers_count = 0;
+    tig_art_prefetch_quit = false;
+
+    // Leave one core for the main thread.
+    count = SDL_GetNumLogicalCPUCores() - 1;
+    if (count < 1) {
+        count = 1;
+    } else if (count > TIG_ART_PREFETCH_MAX_WORKERS) {
+        count = TIG_ART_PREFETCH_MAX_WORKERS;
+    }
+
+    tig_art_prefetch_mutex = SDL_CreateMutex();
+    tig_art_prefetch_queued_cond = SDL_CreateCondition();
+    tig_art_prefetch_done_cond = SDL_CreateCondition();
+    if (tig_art_prefetch_mutex == NULL
+        || tig_art_prefetch_queued_cond == NULL
+        || tig_art_prefetch_done_cond == NULL) {
+        tig_art_prefetch_exit();
+        return false;
+    }
+
+    for (index = 0; index < count; index++) {
+        snprintf(name, sizeof(name), "tig_art_%d", index);
+        tig_art_prefetch_workers[index] = SDL_CreateThread(tig_art_prefetch_worker, name, NULL);
+        if (tig_art_prefetch_workers[index] == NULL) {
+            break;
+        }
+        tig_art_prefetch_workers_count++;
+    }
+
+    if (tig_art_prefetch_workers_count == 0) {
+        tig_art_prefetch_exit();
+        return false;
+    }
+
+    return true;
+}
+
+void tig_art_prefetch_exit()
+{
+    int index;
+
+    if (tig_art_prefetch_workers_count != 0) {
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        tig_art_prefetch_quit = true;
+        SDL_BroadcastCondition(tig_art_prefetch_queued_cond);
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+        for (index = 0; index < tig_art_prefetch_workers_count; index++) {
+            SDL_WaitThread(tig_art_prefetch_workers[index], NULL);
+            tig_art_prefetch_workers[index] = NULL;
+        }
+        tig_art_prefetch_workers_count = 0;
+    }
+
+    // Workers are gone, remaining jobs can be released without locking.
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        if (tig_art_prefetch_jobs[index].state != TIG_ART_PREFETCH_JOB_FREE) {
+            tig_art_prefetch_discard(&(tig_art_prefetch_jobs[index]));
+        }
+    }
+
+    if (tig_art_prefetch_done_cond != NULL) {
+        SDL_DestroyCondition(tig_art_prefetch_done_cond);
+        tig_art_prefetch_done_cond = NULL;
+    }
+
+    if (tig_art_prefetch_queued_cond != NULL) {
+        SDL_DestroyCondition(tig_art_prefetch_queued_cond);
+        tig_art_prefetch_queued_cond = NULL;
+    }
+
+    if (tig_art_prefetch_mutex != NULL) {
+        SDL_DestroyMutex(tig_art_prefetch_mutex);
+        tig_art_prefetch_mutex = NULL;
+    }
+}
+
+int SDLCALL tig_art_prefetch_worker(void* userdata)
+{
+    TigArtPrefetchJob* job;
+    int index;
+
+    (void)userdata;
+
+    SDL_LockMutex(tig_art_prefetch_mutex);
+
+    while (!tig_art_prefetch_quit) {
+        // Pick the oldest request.
+        job = NULL;
+        for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+            if (tig_art_prefetch_jobs[index].state == TIG_ART_PREFETCH_JOB_QUEUED
+                && (job == NULL || (int)(tig_art_prefetch_jobs[index].seq - job->seq) < 0)) {
+                job = &(tig_art_prefetch_jobs[index]);
+            }
+        }
+
+        if (job == NULL) {
+            SDL_WaitCondition(tig_art_prefetch_queued_cond, tig_art_prefetch_mutex);
+            continue;
+        }
+
+        job->state = TIG_ART_PREFETCH_JOB_DECODING;
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+        job->rc = tig_art_file_decode(job->art_id,
+            job->data,
+            job->data_size,
+            &(job->hdr),
+            job->raw_palette_tbl,
+            &(job->size));
+
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        job->state = TIG_ART_PREFETCH_JOB_DONE;
+        SDL_BroadcastCondition(tig_art_prefetch_done_cond);
+    }
+
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    return 0;
+}
+
+// NOTE: Must be called with `tig_art_prefetch_mutex` held.
+TigArtPrefetchJob* tig_art_prefetch_find_job(tig_art_id_t key)
+{
+    int index;
+
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        if (tig_art_prefetch_jobs[index].state != TIG_ART_PREFETCH_JOB_FREE
+            && tig_art_prefetch_jobs[index].key == key) {
+            return &(tig_art_prefetch_jobs[index]);
+        }
+    }
+
+    return NULL;
+}
+
+TigArtPrefetchJob* tig_art_prefetch_alloc_job()
+{
+    TigArtPrefetchJob* job;
+    int index;
+
+    job = NULL;
+
+    SDL_LockMutex(tig_art_prefetch_mutex);
+
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        if (tig_art_prefetch_jobs[index].state == TIG_ART_PREFETCH_JOB_FREE) {
+            job = &(tig_art_prefetch_jobs[index]);
+            break;
+        }
+    }
+
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    return job;
+}
+
+// Moves prefetched art into the cache at `cache_entry_index` (which should be
+// obtained from `tig_art_cache_find`). If the art is still in the queue it is
+// decoded right away, if it's being decoded by the worker - waits for it.
+//
+// Returns `false` if there is no such job, or it has failed. In this case the
+// caller is expected to load art synchronously.
+bool tig_art_prefetch_complete(tig_art_id_t key, int cache_entry_index)
+{
+    TigArtPrefetchJob* job;
+    bool decode;
+    TigPalette palette_tbl[MAX_PALETTES];
+    bool ok;
+
+    if (tig_art_prefetch_workers_count == 0) {
+        return false;
+    }
+
+    SDL_LockMutex(tig_art_prefetch_mutex);
+
+    job = tig_art_prefetch_find_job(key);
+    if (job == NULL) {
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+        return false;
+    }
+
+    decode = false;
+    if (job->state == TIG_ART_PREFETCH_JOB_QUEUED) {
+        // Don't wait for the worker to pick it up, it's faster to decode it
+        // ourselves.
+        job->state = TIG_ART_PREFETCH_JOB_DECODING;
+        decode = true;
+    } else {
+        while (job->state != TIG_ART_PREFETCH_JOB_DONE) {
+            SDL_WaitCondition(tig_art_prefetch_done_cond, tig_art_prefetch_mutex);
+        }
+    }
+
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    if (decode) {
+        job->rc = tig_art_file_decode(job->art_id,
+            job->data,
+            job->data_size,
+            &(job->hdr),
+            job->raw_palette_tbl,
+            &(job->size));
+
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        job->state = TIG_ART_PREFETCH_JOB_DONE;
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+    }
+
+    ok = job->rc == TIG_OK;
+    if (ok) {
+        tig_art_file_load_palettes(job->art_id, &(job->hdr), job->raw_palette_tbl, palette_tbl, &(job->size));
+        tig_art_cache_entry_insert(job->art_id, job->path, cache_entry_index, &(job->hdr), palette_tbl, job->size);
+
+        // Cache owns decoded data now.
+        job->rc = TIG_ERR_GENERIC;
+    }
+
+    tig_art_prefetch_discard(job);
+
+    return ok;
+}
+
+// Moves decoded art into the cache (main thread only).
+void tig_art_prefetch_publish(TigArtPrefetchJob* job)
+{
+    int cache_entry_index;
+    TigPalette palette_tbl[MAX_PALETTES];
+
+    // The same file might have been loaded in the meantime under another key.
+    if (job->rc == TIG_OK
+        && !tig_art_cache_find(job->path, &cache_entry_index)) {
+        tig_art_cache_check_fullness();
+        tig_art_cache_check_fullness();
+
+        // A full flush cancels all prefetch jobs, including this one, in
+        // which case its data is already released and the job is back in the
+        // pool.
+        if (job->state == TIG_ART_PREFETCH_JOB_FREE) {
+            return;
+        }
+
+        // Eviction reorders cache entries.
+        if (!tig_art_cache_find(job->path, &cache_entry_index)) {
+            tig_art_file_load_palettes(job->art_id, &(job->hdr), job->raw_palette_tbl, palette_tbl, &(job->size));
+            tig_art_cache_entry_insert(job->art_id, job->path, cache_entry_index, &(job->hdr), palette_tbl, job->size);
+            tig_art_cache_entries[cache_entry_index].time = tig_ping_timestamp;
+            tig_art_cache_index_insert(job->key, cache_entry_index);
+
+            // Cache owns decoded data now.
+            job->rc = TIG_ERR_GENERIC;
+        }
+    }
+
+    tig_art_prefetch_discard(job);
+}
+
+// Releases job resources and returns it to the pool (main thread only). The job
+// must not be in `QUEUED` or `DECODING` state.
+void tig_art_prefetch_discard(TigArtPrefetchJob* job)
+{
+    if (job->state == TIG_ART_PREFETCH_JOB_DONE && job->rc == TIG_OK) {
+        tig_art_file_load_cleanup(&(job->hdr), job->raw_palette_tbl);
+    }
+
+    if (job->data != NULL) {
+        FREE(job->data);
+        job->data = NULL;
+    }
+
+    if (tig_art_prefetch_mutex != NULL) {
+        SDL_LockMutex(tig_art_prefetch_mutex);
+        job->state = TIG_ART_PREFETCH_JOB_FREE;
+        SDL_UnlockMutex(tig_art_prefetch_mutex);
+    } else {
+        job->state = TIG_ART_PREFETCH_JOB_FREE;
+    }
+}
+
+// Drops all pending prefetch requests (main thread only).
+void tig_art_prefetch_cancel_all()
+{
+    int index;
+
+    if (tig_art_prefetch_workers_count == 0) {
+        return;
+    }
+
+    SDL_LockMutex(tig_art_prefetch_mutex);
+
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        // Claim queued jobs so that workers do not pick them up.
+        if (tig_art_prefetch_jobs[index].state == TIG_ART_PREFETCH_JOB_QUEUED) {
+            tig_art_prefetch_jobs[index].state = TIG_ART_PREFETCH_JOB_DONE;
+            tig_art_prefetch_jobs[index].rc = TIG_ERR_GENERIC;
+        }
+    }
+
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        while (tig_art_prefetch_jobs[index].state == TIG_ART_PREFETCH_JOB_DECODING) {
+            SDL_WaitCondition(tig_art_prefetch_done_cond, tig_art_prefetch_mutex);
+        }
+    }
+
+    SDL_UnlockMutex(tig_art_prefetch_mutex);
+
+    for (index = 0; index < TIG_ART_PREFETCH_MAX_JOBS; index++) {
+        if (tig_art_prefetch_jobs[index].state != TIG_ART_PREFETCH_JOB_FREE) {
+            tig_art_prefetch_discard(&(tig_art_prefetch_jobs[index]));
+        }
+    }
+}
+
 // 0x51BE30
 int art_header_get_num_rotations(TigArtHeader* hdr)
 {
@@ -6008,23 +6931,16 @@ int art_header_get_num_rotations(TigArtHeader* hdr)
 }
 
 // 0x51BE50
-void tig_art_file_load_cleanup(TigFile* stream, TigArtHeader* hdr, TigPalette* palette_tbl)
+void tig_art_file_load_cleanup(TigArtHeader* hdr, uint32_t** raw_palette_tbl)
 {
     int palette;
 
-    if (stream != NULL) {
-        tig_file_fclose(stream);
-    }
-
     art_header_free_frame_data(hdr);
 
     for (palette = 0; palette < MAX_PALETTES; ++palette) {
-        if (hdr->palette_tbl[palette] != NULL) {
-            tig_palette_destroy(hdr->palette_tbl[palette]);
-        }
-
-        if (palette_tbl[palette] != NULL) {
-            tig_palette_destroy(palette_tbl[palette]);
+        if (raw_palette_tbl[palette] != NULL) {
+            FREE(raw_palette_tbl[palette]);
+            raw_palette_tbl[palette] = NULL;
         }
     }
 }
@@ -6032,45 +6948,488 @@ void tig_art_file_load_cleanup(TigFile* stream, TigArtHeader* hdr, TigPalette* p
 // 0x51BF20
 void art_header_free_frame_data(TigArtHeader* hdr)
 {
-    int num_rotations;
     int rotation;
 
-    num_rotations = art_header_get_num_rotations(hdr);
-    for (rotation = 0; rotation < num_rotations; rotation++) {
-        if (hdr->pixels_tbl[rotation] != NULL) {
+    // Rotations absent in the file (as well as mirrored rotations) share data
+    // with rotation 0.
+    for (rotation = 0; rotation < MAX_ROTATIONS; rotation++) {
+        if (hdr->pixels_tbl[rotation] != NULL
+            && (rotation == 0 || hdr->pixels_tbl[rotation] != hdr->pixels_tbl[0])) {
             FREE(hdr->pixels_tbl[rotation]);
         }
-        if (hdr->frames_tbl[rotation] != NULL) {
+        if (hdr->frames_tbl[rotation] != NULL
+            && (rotation == 0 || hdr->frames_tbl[rotation] != hdr->frames_tbl[0])) {
             FREE(hdr->frames_tbl[rotation]);
         }
     }
+
+    for (rotation = 0; rotation < MAX_ROTATIONS; rotation++) {
+        hdr->pixels_tbl[rotation] = NULL;
+        hdr->frames_tbl[rotation] = NULL;
+    }
 }
 
-bool art_read_header(TigArtHeader* hdr, TigFile* stream)
+bool art_read_header(TigArtHeader* hdr, TigArtFileReader* reader)
 {
     int idx;
     int value;
 
-    if (tig_file_fread(&(hdr->flags), sizeof(hdr->flags), 1, stream) != 1) return false;
-    if (tig_file_fread(&(hdr->fps), sizeof(hdr->fps), 1, stream) != 1) return false;
-    if (tig_file_fread(&(hdr->bpp), sizeof(hdr->bpp), 1, stream) != 1) return false;
+    if (!art_reader_read(reader, &(hdr->flags), sizeof(hdr->flags))) return false;
+    if (!art_reader_read(reader, &(hdr->fps), sizeof(hdr->fps))) return false;
+    if (!art_reader_read(reader, &(hdr->bpp), sizeof(hdr->bpp))) return false;
 
     // Read palette table, non-zero value indicates presence of palette entries.
     for (idx = 0; idx < MAX_PALETTES; idx++) {
-        if (tig_file_fread(&(value), sizeof(value), 1, stream) != 1) return false;
+        if (!art_reader_read(reader, &(value), sizeof(value))) return false;
         hdr->palette_tbl[idx] = (uint32_t*)(intptr_t)value;
     }
 
-    if (tig_file_fread(&(hdr->action_frame), sizeof(hdr->action_frame), 1, stream) != 1) return false;
-    if (tig_file_fread(&(hdr->num_frames), sizeof(hdr->num_frames), 1, stream) != 1) return false;
+    if (!art_reader_read(reader, &(hdr->action_frame), sizeof(hdr->action_frame))) return false;
+    if (!art_reader_read(reader, &(hdr->num_frames), sizeof(hdr->num_frames))) return false;
+
+    // FIX: Guard against garbage in frame count.
+    if (hdr->num_frames <= 0) return false;
 
     // Skip frames table, actual values are ignored.
-    if (tig_file_fseek(stream, 4 * MAX_ROTATIONS, SEEK_CUR) != 0) return false;
+    if (reader->size - reader->pos < 4 * MAX_ROTATIONS) return false;
+    reader->pos += 4 * MAX_ROTATIONS;
 
-    if (tig_file_fread(&(hdr->data_size), sizeof(hdr->data_size), 1, stream) != 1) return false;
+    if (!art_reader_read(reader, &(hdr->data_size), sizeof(hdr->data_size))) return false;
 
     // Skip pixels table, actual values are ignored.
-    if (tig_file_fseek(stream, 4 * MAX_ROTATIONS, SEEK_CUR) != 0) return false;
+    if (reader->size - reader->pos < 4 * MAX_ROTATIONS) return false;
+    reader->pos += 4 * MAX_ROTATIONS;
 
     return true;
 }
+
+// Expands RLE-encoded frame at `*dst_ptr` and advances it past the decoded
+// pixels. Returns `false` if the data is malformed.
+//
+// Each run is a control byte (bit 7 set - copy the following `len` bytes,
+// otherwise - repeat the following byte `len` times) with `len` in the lower
+// 7 bits. Runs are short, so calling `memcpy`/`memset` for every one of them
+// costs more than the copying itself. When there is enough room, SIMD paths
+// copy whole 16-byte blocks instead and let the next run overwrite the excess
+// (pixels are decoded strictly sequentially, so nothing past the current
+// position is ever observed).
+bool tig_art_rle_decode(const uint8_t* src, size_t src_size, uint8_t** dst_ptr, uint8_t* dst_end)
+{
+    const uint8_t* src_end = src + src_size;
+    uint8_t* dst = *dst_ptr;
+    uint8_t value;
+    int len;
+
+    while (src < src_end) {
+        value = *src++;
+        len = value & 0x7F;
+
+        // FIX: Protect against malformed frames overflowing pixel buffer.
+        if (dst_end - dst < len) {
+            return false;
+        }
+
+        if ((value & 0x80) != 0) {
+            if (src_end - src < len) {
+                return false;
+            }
+
+#if defined(ART_SSE2) || defined(ART_NEON)
+            if (src_end - src >= 128 && dst_end - dst >= 128) {
+                int pos;
+
+                for (pos = 0; pos < len; pos += 16) {
+#if defined(ART_SSE2)
+                    _mm_storeu_si128((__m128i*)(dst + pos), _mm_loadu_si128((const __m128i*)(src + pos)));
+#else
+                    vst1q_u8(dst + pos, vld1q_u8(src + pos));
+#endif
+                }
+            } else {
+                memcpy(dst, src, len);
+            }
+#else
+            memcpy(dst, src, len);
+#endif
+            src += len;
+        } else {
+            if (src == src_end) {
+                return false;
+            }
+
+#if defined(ART_SSE2) || defined(ART_NEON)
+            if (dst_end - dst >= 128) {
+                int pos;
+#if defined(ART_SSE2)
+                __m128i fill = _mm_set1_epi8((char)*src);
+#else
+                uint8x16_t fill = vdupq_n_u8(*src);
+#endif
+
+                for (pos = 0; pos < len; pos += 16) {
+#if defined(ART_SSE2)
+                    _mm_storeu_si128((__m128i*)(dst + pos), fill);
+#else
+                    vst1q_u8(dst + pos, fill);
+#endif
+                }
+            } else {
+                memset(dst, *src, len);
+            }
+#else
+            memset(dst, *src, len);
+#endif
+            src++;
+        }
+        dst += len;
+    }
+
+    *dst_ptr = dst;
+
+    return true;
+}
+
+void tig_art_blit_set_span_enabled(bool enabled)
+{
+    tig_art_blit_span_enabled = enabled;
+}
+
+bool tig_art_blit_has_span(unsigned int flags)
+{
+    return art_blit_span_func(flags) != NULL;
+}
+
+// Picks SIMD span kernel for unstretched 32 bpp blit without color blending,
+// or returns `NULL` when there is none (the caller falls back to per-pixel
+// loops). Flags are tested in the same order as in `art_blit`.
+ArtBlitSpanFunc* art_blit_span_func(unsigned int flags)
+{
+#if defined(ART_SSE2) || defined(ART_NEON)
+    // Kernels work on bytes and rely on color components occupying whole
+    // bytes (the top byte is not a component).
+    if (((tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask) & 0xFF000000) != 0
+        || (tig_color_red_mask >> tig_color_red_shift) != 0xFF
+        || (tig_color_green_mask >> tig_color_green_shift) != 0xFF
+        || (tig_color_blue_mask >> tig_color_blue_shift) != 0xFF
+        || (tig_color_red_shift % 8) != 0
+        || (tig_color_green_shift % 8) != 0
+        || (tig_color_blue_shift % 8) != 0) {
+        return NULL;
+    }
+
+    if ((flags & TIG_ART_BLT_BLEND_ADD) != 0) {
+        return art_blit_span_add;
+    }
+
+    if ((flags & TIG_ART_BLT_BLEND_SUB) != 0) {
+        return art_blit_span_sub;
+    }
+
+    if ((flags & (TIG_ART_BLT_BLEND_MUL | TIG_ART_BLT_BLEND_ALPHA_AVG)) != 0) {
+        return NULL;
+    }
+
+    if ((flags & TIG_ART_BLT_BLEND_ALPHA_CONST) != 0) {
+        return art_blit_span_alpha_const;
+    }
+
+    if ((flags & (TIG_ART_BLT_BLEND_ALPHA_SRC | TIG_ART_BLT_BLEND_ALPHA_LERP_ANY)) != 0) {
+        return NULL;
+    }
+
+    if ((flags & (TIG_ART_BLT_BLEND_ALPHA_STIPPLE_S | TIG_ART_BLT_BLEND_ALPHA_STIPPLE_D)) != 0) {
+        return art_blit_span_stipple;
+    }
+
+    return art_blit_span_copy;
+#else
+    (void)flags;
+
+    return NULL;
+#endif
+}
+
+#if defined(ART_SSE2)
+
+// Looks up four pixels in the palette. Lanes of `transparent` are set for
+// pixels with color key (index 0).
+static inline __m128i art_blit_span_gather(const uint8_t* src, int src_step, const uint32_t* plt, __m128i* transparent)
+{
+    unsigned int i0 = src[0];
+    unsigned int i1 = src[src_step];
+    unsigned int i2 = src[src_step * 2];
+    unsigned int i3 = src[src_step * 3];
+
+    *transparent = _mm_cmpeq_epi32(_mm_set_epi32(i3, i2, i1, i0), _mm_setzero_si128());
+
+    return _mm_set_epi32(plt[i3], plt[i2], plt[i1], plt[i0]);
+}
+
+// Picks `dst` in lanes set in `keep`, `color` otherwise.
+static inline __m128i art_blit_span_select(__m128i keep, __m128i dst, __m128i color)
+{
+    return _mm_or_si128(_mm_and_si128(keep, dst), _mm_andnot_si128(keep, color));
+}
+
+#elif defined(ART_NEON)
+
+static inline uint32x4_t art_blit_span_gather(const uint8_t* src, int src_step, const uint32_t* plt, uint32x4_t* transparent)
+{
+    uint32_t indexes[4];
+    uint32_t colors[4];
+    int lane;
+
+    for (lane = 0; lane < 4; lane++) {
+        indexes[lane] = src[src_step * lane];
+        colors[lane] = plt[indexes[lane]];
+    }
+
+    *transparent = vceqq_u32(vld1q_u32(indexes), vdupq_n_u32(0));
+
+    return vld1q_u32(colors);
+}
+
+#endif
+
+void art_blit_span_copy(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase)
+{
+    (void)alpha;
+    (void)phase;
+
+#if defined(ART_SSE2)
+    __m128i transparent;
+    __m128i color;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        color = art_blit_span_select(transparent, _mm_loadu_si128((__m128i*)dst), color);
+        _mm_storeu_si128((__m128i*)dst, color);
+        src += src_step * 4;
+        dst += 4;
+    }
+#elif defined(ART_NEON)
+    uint32x4_t transparent;
+    uint32x4_t color;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        vst1q_u32(dst, vbslq_u32(transparent, vld1q_u32(dst), color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#endif
+
+    for (; count > 0; count--) {
+        if (*src != 0) {
+            *dst = plt[*src];
+        }
+        src += src_step;
+        dst++;
+    }
+}
+
+void art_blit_span_add(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase)
+{
+    (void)alpha;
+    (void)phase;
+
+#if defined(ART_SSE2)
+    __m128i rgb_mask = _mm_set1_epi32(tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask);
+    __m128i transparent;
+    __m128i color;
+    __m128i pixels;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        pixels = _mm_loadu_si128((__m128i*)dst);
+        color = _mm_and_si128(_mm_adds_epu8(color, pixels), rgb_mask);
+        _mm_storeu_si128((__m128i*)dst, art_blit_span_select(transparent, pixels, color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#elif defined(ART_NEON)
+    uint32x4_t rgb_mask = vdupq_n_u32(tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask);
+    uint32x4_t transparent;
+    uint32x4_t color;
+    uint32x4_t pixels;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        pixels = vld1q_u32(dst);
+        color = vandq_u32(vreinterpretq_u32_u8(vqaddq_u8(vreinterpretq_u8_u32(color), vreinterpretq_u8_u32(pixels))), rgb_mask);
+        vst1q_u32(dst, vbslq_u32(transparent, pixels, color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#endif
+
+    for (; count > 0; count--) {
+        if (*src != 0) {
+            *dst = tig_color_add(plt[*src], *dst);
+        }
+        src += src_step;
+        dst++;
+    }
+}
+
+void art_blit_span_sub(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase)
+{
+    (void)alpha;
+    (void)phase;
+
+#if defined(ART_SSE2)
+    __m128i rgb_mask = _mm_set1_epi32(tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask);
+    __m128i transparent;
+    __m128i color;
+    __m128i pixels;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        pixels = _mm_loadu_si128((__m128i*)dst);
+        color = _mm_and_si128(_mm_subs_epu8(pixels, color), rgb_mask);
+        _mm_storeu_si128((__m128i*)dst, art_blit_span_select(transparent, pixels, color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#elif defined(ART_NEON)
+    uint32x4_t rgb_mask = vdupq_n_u32(tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask);
+    uint32x4_t transparent;
+    uint32x4_t color;
+    uint32x4_t pixels;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        pixels = vld1q_u32(dst);
+        color = vandq_u32(vreinterpretq_u32_u8(vqsubq_u8(vreinterpretq_u8_u32(pixels), vreinterpretq_u8_u32(color))), rgb_mask);
+        vst1q_u32(dst, vbslq_u32(transparent, pixels, color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#endif
+
+    for (; count > 0; count--) {
+        if (*src != 0) {
+            *dst = tig_color_sub(plt[*src], *dst);
+        }
+        src += src_step;
+        dst++;
+    }
+}
+
+// NOTE: `tig_color_blend_alpha` works on components in place with unsigned
+// arithmetic, which for whole-byte components boils down to
+// `(dst * (256 - alpha) + src * alpha) >> 8`. The kernel uses this form since
+// it fits in 16-bit lanes.
+void art_blit_span_alpha_const(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase)
+{
+    (void)phase;
+
+#if defined(ART_SSE2)
+    __m128i rgb_mask = _mm_set1_epi32(tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask);
+    __m128i src_alpha = _mm_set1_epi16((short)alpha);
+    __m128i dst_alpha = _mm_set1_epi16((short)(256 - alpha));
+    __m128i zero = _mm_setzero_si128();
+    __m128i transparent;
+    __m128i color;
+    __m128i pixels;
+    __m128i lo;
+    __m128i hi;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        pixels = _mm_loadu_si128((__m128i*)dst);
+
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(color, zero), src_alpha),
+            _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), dst_alpha));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(color, zero), src_alpha),
+            _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), dst_alpha));
+        color = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+        color = _mm_and_si128(color, rgb_mask);
+
+        _mm_storeu_si128((__m128i*)dst, art_blit_span_select(transparent, pixels, color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#elif defined(ART_NEON)
+    uint32x4_t rgb_mask = vdupq_n_u32(tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask);
+    uint16x8_t src_alpha = vdupq_n_u16((uint16_t)alpha);
+    uint16x8_t dst_alpha = vdupq_n_u16((uint16_t)(256 - alpha));
+    uint32x4_t transparent;
+    uint32x4_t color;
+    uint32x4_t pixels;
+    uint16x8_t lo;
+    uint16x8_t hi;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        pixels = vld1q_u32(dst);
+
+        lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(color))), src_alpha),
+            vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(pixels))),
+            dst_alpha);
+        hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(color))), src_alpha),
+            vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(pixels))),
+            dst_alpha);
+        color = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+        color = vandq_u32(color, rgb_mask);
+
+        vst1q_u32(dst, vbslq_u32(transparent, pixels, color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#endif
+
+    for (; count > 0; count--) {
+        if (*src != 0) {
+            *dst = tig_color_blend_alpha(plt[*src], *dst, alpha);
+        }
+        src += src_step;
+        dst++;
+    }
+}
+
+void art_blit_span_stipple(uint32_t* dst, const uint8_t* src, int src_step, const uint32_t* plt, int count, int alpha, int phase)
+{
+    (void)alpha;
+
+#if defined(ART_SSE2)
+    // Every other pixel is skipped, groups of four pixels share the pattern.
+    __m128i skipped = phase != 0
+        ? _mm_set_epi32(-1, 0, -1, 0)
+        : _mm_set_epi32(0, -1, 0, -1);
+    __m128i transparent;
+    __m128i color;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        transparent = _mm_or_si128(transparent, skipped);
+        color = art_blit_span_select(transparent, _mm_loadu_si128((__m128i*)dst), color);
+        _mm_storeu_si128((__m128i*)dst, color);
+        src += src_step * 4;
+        dst += 4;
+    }
+#elif defined(ART_NEON)
+    static const uint32_t odd_lanes[4] = { 0, 0xFFFFFFFF, 0, 0xFFFFFFFF };
+    static const uint32_t even_lanes[4] = { 0xFFFFFFFF, 0, 0xFFFFFFFF, 0 };
+    uint32x4_t skipped = vld1q_u32(phase != 0 ? odd_lanes : even_lanes);
+    uint32x4_t transparent;
+    uint32x4_t color;
+
+    for (; count >= 4; count -= 4) {
+        color = art_blit_span_gather(src, src_step, plt, &transparent);
+        transparent = vorrq_u32(transparent, skipped);
+        vst1q_u32(dst, vbslq_u32(transparent, vld1q_u32(dst), color));
+        src += src_step * 4;
+        dst += 4;
+    }
+#endif
+
+    for (; count > 0; count--) {
+        if (phase != 0 && *src != 0) {
+            *dst = plt[*src];
+        }
+        src += src_step;
+        dst++;
+        phase ^= 1;
+    }
+}
@@ -1,5 +1,13 @@
 #include "tig/color.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLOR_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define COLOR_NEON
+#endif
+
 #include "tig/memory.h"
 
 typedef enum ColorComponent {
@@ -84,6 +92,10 @@ static int tig_color_bpp;
 // 0x62B2A0
 static bool tig_color_initialized;
 
+// Whether colors are in 8-8-8 format, so that summing them is a plain
+// saturating byte addition, see `tig_color_add_span`.
+static bool tig_color_add_bytes;
+
 // 0x739E88
 uint8_t* tig_color_green_mult_table;
 
@@ -293,6 +305,10 @@ int tig_color_set_rgb_settings(unsigned int red_mask, unsigned int green_mask, u
     tig_color_grayscale_table_init();
     tig_color_rgb_conversion_tables_init();
 
+    tig_color_add_bytes = tig_color_red_mask == 0xFF0000
+        && tig_color_green_mask == 0xFF00
+        && tig_color_blue_mask == 0xFF;
+
     return 0;
 }
 
@@ -564,6 +580,35 @@ unsigned int tig_color_to_24_bpp(int red, int green, int blue)
     return normalized_red + normalized_green + normalized_blue;
 }
 
+void tig_color_add_span(uint32_t* dst, const uint32_t* src, int cnt)
+{
+    int index = 0;
+
+    if (tig_color_add_bytes) {
+#if defined(COLOR_SSE2)
+        __m128i rgb_mask = _mm_set1_epi32(0xFFFFFF);
+
+        for (; index + 4 <= cnt; index += 4) {
+            __m128i a = _mm_loadu_si128((const __m128i*)&(src[index]));
+            __m128i b = _mm_loadu_si128((const __m128i*)&(dst[index]));
+            _mm_storeu_si128((__m128i*)&(dst[index]), _mm_and_si128(_mm_adds_epu8(a, b), rgb_mask));
+        }
+#elif defined(COLOR_NEON)
+        uint32x4_t rgb_mask = vdupq_n_u32(0xFFFFFF);
+
+        for (; index + 4 <= cnt; index += 4) {
+            uint8x16_t a = vreinterpretq_u8_u32(vld1q_u32(&(src[index])));
+            uint8x16_t b = vreinterpretq_u8_u32(vld1q_u32(&(dst[index])));
+            vst1q_u32(&(dst[index]), vandq_u32(vreinterpretq_u32_u8(vqaddq_u8(a, b)), rgb_mask));
+        }
+#endif
+    }
+
+    for (; index < cnt; index++) {
+        dst[index] = tig_color_add(src[index], dst[index]);
+    }
+}
+
 // 0x52C6E0
 void tig_color_set_mask(int color_component, unsigned int mask)
 {
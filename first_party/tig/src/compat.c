@@ -1,9 +1,76 @@
 #include "tig/compat.h"
 
+#include "tig/memory.h"
+
 #ifdef _WIN32
 #include <stdlib.h>
+#include <windows.h>
 #else
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+#define COMPAT_DIR_CACHE_BUCKETS 256
+#define COMPAT_DIR_CACHE_MAX_SIZE 1024
+
+#ifdef __APPLE__
+#define COMPAT_STAT_MTIME(st) ((st).st_mtimespec)
+#else
+#define COMPAT_STAT_MTIME(st) ((st).st_mtim)
+#endif
+
+// Single name in `CompatDirListing`.
+typedef struct CompatDirName {
+    const char* name;
+    size_t length;
+    unsigned int hash;
+} CompatDirName;
+
+// Cached contents of a directory, see `compat_resolve_path`.
+typedef struct CompatDirListing {
+    char* path;
+    unsigned int hash;
+    time_t mtime_sec;
+    long mtime_nsec;
+    time_t scan_time;
+    char* pool;
+    CompatDirName* names;
+    size_t capacity;
+    struct CompatDirListing* next;
+} CompatDirListing;
+
+static unsigned int compat_hash_casefold(const char* str, size_t length);
+static CompatDirListing* compat_dir_cache_get(const char* path);
+static bool compat_dir_listing_scan(CompatDirListing* listing);
+static bool compat_dir_listing_refresh(CompatDirListing* listing);
+static const char* compat_dir_listing_find(CompatDirListing* listing, const char* name, size_t length);
+static void compat_dir_listing_free(CompatDirListing* listing);
+
+/**
+ * Cache of directory listings used to resolve paths case-insensitively.
+ *
+ * Listings are keyed by the casefolded directory path. Each listing maps
+ * casefolded names to the names on disk, so that resolving a path which was
+ * resolved before does not touch the file system at all.
+ *
+ * Names which cannot be found trigger a check of the directory modification
+ * time and a rescan when it has changed, which picks up files created behind
+ * our back. Listings scanned within the same second the directory was last
+ * modified are rescanned on every miss, since the modification time is not
+ * precise enough to tell whether they are complete. Removals and renames
+ * cannot be detected this way and must be reported via
+ * `compat_invalidate_path`.
+ */
+static CompatDirListing* compat_dir_cache_buckets[COMPAT_DIR_CACHE_BUCKETS];
+
+static int compat_dir_cache_size;
+
 #endif
 
 void compat_windows_path_to_native(char* path)
@@ -27,51 +94,58 @@ void compat_resolve_path(char* path)
     (void)path;
 #else
     char* pch = path;
+    char* sep;
+    size_t length;
+    CompatDirListing* listing;
+    const char* name;
 
-    DIR* dir;
     if (pch[0] == '/') {
-        dir = opendir("/");
         pch++;
-    } else {
-        dir = opendir(".");
     }
 
-    while (dir != NULL) {
-        char* sep = strchr(pch, '/');
-        size_t length;
+    while (true) {
+        sep = strchr(pch, '/');
         if (sep != NULL) {
             length = sep - pch;
         } else {
             length = strlen(pch);
         }
 
-        bool found = false;
+        if (length == 0) {
+            break;
+        }
 
-        struct dirent* entry = readdir(dir);
-        while (entry != NULL) {
-            if (strlen(entry->d_name) == length && SDL_strncasecmp(pch, entry->d_name, length) == 0) {
-                strncpy(pch, entry->d_name, length);
-                found = true;
-                break;
-            }
-            entry = readdir(dir);
+        // Temporarily cut path at the current component to obtain the
+        // directory it lives in.
+        if (pch == path) {
+            listing = compat_dir_cache_get(".");
+        } else if (pch == path + 1) {
+            listing = compat_dir_cache_get("/");
+        } else {
+            pch[-1] = '\0';
+            listing = compat_dir_cache_get(path);
+            pch[-1] = '/';
         }
 
-        closedir(dir);
-        dir = NULL;
+        if (listing == NULL) {
+            break;
+        }
 
-        if (!found) {
+        name = compat_dir_listing_find(listing, pch, length);
+        if (name == NULL && compat_dir_listing_refresh(listing)) {
+            name = compat_dir_listing_find(listing, pch, length);
+        }
+
+        if (name == NULL) {
             break;
         }
 
+        memcpy(pch, name, length);
+
         if (sep == NULL) {
             break;
         }
 
-        *sep = '\0';
-        dir = opendir(path);
-        *sep = '/';
-
         pch = sep + 1;
     }
 #endif
@@ -256,3 +330,363 @@ void compat_makepath(char* path, const char* drive, const char* dir, const char*
     *path = '\0';
 #endif
 }
+
+bool compat_map_file(const char* path, const void** data_ptr, size_t* size_ptr, void** handle_ptr)
+{
+#ifdef _WIN32
+    HANDLE file;
+    LARGE_INTEGER file_size;
+    HANDLE mapping;
+    void* data;
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    if (!GetFileSizeEx(file, &file_size)
+        || file_size.QuadPart == 0
+        || (unsigned long long)file_size.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    // Mapping keeps its own reference to the file.
+    CloseHandle(file);
+
+    if (mapping == NULL) {
+        return false;
+    }
+
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    *data_ptr = data;
+    *size_ptr = (size_t)file_size.QuadPart;
+    *handle_ptr = mapping;
+
+    return true;
+#else
+    int fd;
+    struct stat st;
+    void* data;
+
+    fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0
+        || st.st_size <= 0
+        || (unsigned long long)st.st_size > SIZE_MAX) {
+        close(fd);
+        return false;
+    }
+
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // Mapping stays valid after descriptor is closed.
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    *data_ptr = data;
+    *size_ptr = (size_t)st.st_size;
+    *handle_ptr = NULL;
+
+    return true;
+#endif
+}
+
+void compat_unmap_file(const void* data, size_t size, void* handle)
+{
+#ifdef _WIN32
+    (void)size;
+
+    UnmapViewOfFile(data);
+    CloseHandle((HANDLE)handle);
+#else
+    (void)handle;
+
+    munmap((void*)data, size);
+#endif
+}
+
+void compat_invalidate_path(const char* path)
+{
+#ifdef _WIN32
+    (void)path;
+#else
+    const char* sep;
+    size_t length;
+    size_t parent_length;
+    int index;
+    CompatDirListing** link;
+    CompatDirListing* listing;
+
+    length = strlen(path);
+    while (length > 1 && path[length - 1] == '/') {
+        length--;
+    }
+
+    sep = NULL;
+    for (index = 0; (size_t)index < length; index++) {
+        if (path[index] == '/') {
+            sep = path + index;
+        }
+    }
+
+    // Parent directory of a relative path without separators is the current
+    // directory.
+    if (sep == NULL) {
+        parent_length = 0;
+    } else if (sep == path) {
+        parent_length = 1;
+    } else {
+        parent_length = sep - path;
+    }
+
+    for (index = 0; index < COMPAT_DIR_CACHE_BUCKETS; index++) {
+        link = &(compat_dir_cache_buckets[index]);
+        while (*link != NULL) {
+            listing = *link;
+
+            // Drop parent directory, the path itself and everything below it.
+            if ((parent_length == 0
+                    ? strcmp(listing->path, ".") == 0
+                    : strlen(listing->path) == parent_length && SDL_strncasecmp(listing->path, path, parent_length) == 0)
+                || (SDL_strncasecmp(listing->path, path, length) == 0
+                    && (listing->path[length] == '\0' || listing->path[length] == '/'))) {
+                *link = listing->next;
+                compat_dir_listing_free(listing);
+                compat_dir_cache_size--;
+            } else {
+                link = &(listing->next);
+            }
+        }
+    }
+#endif
+}
+
+void compat_clear_path_cache()
+{
+#ifndef _WIN32
+    int index;
+    CompatDirListing* next;
+
+    for (index = 0; index < COMPAT_DIR_CACHE_BUCKETS; index++) {
+        while (compat_dir_cache_buckets[index] != NULL) {
+            next = compat_dir_cache_buckets[index]->next;
+            compat_dir_listing_free(compat_dir_cache_buckets[index]);
+            compat_dir_cache_buckets[index] = next;
+        }
+    }
+
+    compat_dir_cache_size = 0;
+#endif
+}
+
+#ifndef _WIN32
+
+unsigned int compat_hash_casefold(const char* str, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    size_t index;
+
+    // FNV-1a
+    for (index = 0; index < length; index++) {
+        hash ^= (unsigned char)SDL_tolower((unsigned char)str[index]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+CompatDirListing* compat_dir_cache_get(const char* path)
+{
+    size_t length;
+    unsigned int hash;
+    CompatDirListing* listing;
+
+    length = strlen(path);
+    hash = compat_hash_casefold(path, length);
+
+    listing = compat_dir_cache_buckets[hash % COMPAT_DIR_CACHE_BUCKETS];
+    while (listing != NULL) {
+        if (listing->hash == hash && SDL_strcasecmp(listing->path, path) == 0) {
+            return listing;
+        }
+        listing = listing->next;
+    }
+
+    if (compat_dir_cache_size >= COMPAT_DIR_CACHE_MAX_SIZE) {
+        compat_clear_path_cache();
+    }
+
+    listing = (CompatDirListing*)CALLOC(1, sizeof(*listing));
+    listing->path = STRDUP(path);
+    listing->hash = hash;
+
+    if (!compat_dir_listing_scan(listing)) {
+        compat_dir_listing_free(listing);
+        return NULL;
+    }
+
+    listing->next = compat_dir_cache_buckets[hash % COMPAT_DIR_CACHE_BUCKETS];
+    compat_dir_cache_buckets[hash % COMPAT_DIR_CACHE_BUCKETS] = listing;
+    compat_dir_cache_size++;
+
+    return listing;
+}
+
+bool compat_dir_listing_scan(CompatDirListing* listing)
+{
+    DIR* dir;
+    struct dirent* entry;
+    struct stat st;
+    size_t pool_size;
+    size_t pool_capacity;
+    size_t count;
+    size_t length;
+    size_t offset;
+    size_t index;
+    char* name;
+
+    // Stat before reading, so that changes made during the scan are not
+    // masked by the recorded modification time.
+    if (stat(listing->path, &st) != 0) {
+        return false;
+    }
+
+    dir = opendir(listing->path);
+    if (dir == NULL) {
+        return false;
+    }
+
+    if (listing->pool != NULL) {
+        FREE(listing->pool);
+        listing->pool = NULL;
+    }
+
+    if (listing->names != NULL) {
+        FREE(listing->names);
+        listing->names = NULL;
+    }
+
+    // Collect names into a single pool separated by NULs.
+    pool_size = 0;
+    pool_capacity = 0;
+    count = 0;
+
+    entry = readdir(dir);
+    while (entry != NULL) {
+        length = strlen(entry->d_name) + 1;
+        if (pool_size + length > pool_capacity) {
+            pool_capacity = pool_capacity != 0 ? pool_capacity * 2 : 1024;
+            while (pool_size + length > pool_capacity) {
+                pool_capacity *= 2;
+            }
+            listing->pool = (char*)REALLOC(listing->pool, pool_capacity);
+        }
+
+        memcpy(listing->pool + pool_size, entry->d_name, length);
+        pool_size += length;
+        count++;
+
+        entry = readdir(dir);
+    }
+
+    closedir(dir);
+
+    // Hash names with open addressing, keeping table at most half full.
+    listing->capacity = 16;
+    while (listing->capacity < count * 2) {
+        listing->capacity *= 2;
+    }
+
+    listing->names = (CompatDirName*)CALLOC(listing->capacity, sizeof(*listing->names));
+
+    offset = 0;
+    while (offset < pool_size) {
+        name = listing->pool + offset;
+        length = strlen(name);
+
+        index = compat_hash_casefold(name, length) & (listing->capacity - 1);
+        while (listing->names[index].name != NULL) {
+            index = (index + 1) & (listing->capacity - 1);
+        }
+
+        listing->names[index].name = name;
+        listing->names[index].length = length;
+        listing->names[index].hash = compat_hash_casefold(name, length);
+
+        offset += length + 1;
+    }
+
+    listing->mtime_sec = COMPAT_STAT_MTIME(st).tv_sec;
+    listing->mtime_nsec = COMPAT_STAT_MTIME(st).tv_nsec;
+    listing->scan_time = time(NULL);
+
+    return true;
+}
+
+bool compat_dir_listing_refresh(CompatDirListing* listing)
+{
+    struct stat st;
+
+    if (stat(listing->path, &st) != 0) {
+        return false;
+    }
+
+    if (COMPAT_STAT_MTIME(st).tv_sec == listing->mtime_sec
+        && COMPAT_STAT_MTIME(st).tv_nsec == listing->mtime_nsec
+        && listing->mtime_sec < listing->scan_time) {
+        return false;
+    }
+
+    return compat_dir_listing_scan(listing);
+}
+
+const char* compat_dir_listing_find(CompatDirListing* listing, const char* name, size_t length)
+{
+    unsigned int hash;
+    size_t index;
+    CompatDirName* entry;
+
+    hash = compat_hash_casefold(name, length);
+    index = hash & (listing->capacity - 1);
+    while (listing->names[index].name != NULL) {
+        entry = &(listing->names[index]);
+        if (entry->hash == hash
+            && entry->length == length
+            && SDL_strncasecmp(entry->name, name, length) == 0) {
+            return entry->name;
+        }
+        index = (index + 1) & (listing->capacity - 1);
+    }
+
+    return NULL;
+}
+
+void compat_dir_listing_free(CompatDirListing* listing)
+{
+    if (listing->pool != NULL) {
+        FREE(listing->pool);
+    }
+
+    if (listing->names != NULL) {
+        FREE(listing->names);
+    }
+
+    FREE(listing->path);
+    FREE(listing);
+}
+
+#endif
@@ -147,6 +147,7 @@ void tig_ping()
     tig_message_ping();
     tig_sound_ping();
     tig_art_ping();
+    tig_file_archive_ping();
 }
 
 // NOTE: Purpose is unclear, both this function and `tig_ping` are public.
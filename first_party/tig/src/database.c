@@ -13,6 +13,7 @@
 #define FOURCC_DAT SDL_FOURCC(' ', 'T', 'A', 'D')
 #define FOURCC_DAT1 SDL_FOURCC('1', 'T', 'A', 'D')
 #define DECOMPRESSION_BUFFER_SIZE 0x4000
+#define TIG_DATABASE_BATCH_MAX_WORKERS 8
 
 typedef struct DecompressionContext {
     /* 0000 */ z_stream zstrm;
@@ -29,13 +30,37 @@ typedef struct TigDatabaseFileHandle {
     TigDatabase* database;
     TigDatabaseEntry* entry;
     FILE* underlying_stream;
+
+    // Entry contents in the archive mapping, `NULL` when the archive is not
+    // mapped (`underlying_stream` is used instead).
+    const unsigned char* data;
     int pos;
     int compressed_pos;
     int ungotten;
     DecompressionContext* decompression_context;
+
+    // Entire inflated contents of compressed entry, allocated on the first
+    // backward seek so that subsequent seeks do not restart inflation.
+    unsigned char* inflated;
     TigDatabaseFileHandle* next;
 } TigDatabaseFileHandle;
 
+// Batch of entries being read by `tig_database_read_batch`.
+typedef struct TigDatabaseBatchJob {
+    TigDatabaseFileHandle** streams;
+    void** buffers;
+    int count;
+
+    // Index of the next stream to be picked up by a worker.
+    int next;
+
+    // Number of streams which were not read yet.
+    int pending;
+    bool success;
+} TigDatabaseBatchJob;
+
+static bool tig_database_read_tail(const char* path, unsigned char** tail_ptr, size_t* tail_size_ptr, size_t* size_ptr);
+static TigDatabase* tig_database_parse(const char* path, const unsigned char* tail, size_t tail_size, size_t size);
 static void tig_database_find_prepare(TigDatabaseFindFileData* ffd);
 static void tig_database_load_ignored(TigDatabase* database);
 static int num_path_segments(const char* path);
@@ -44,6 +69,10 @@ static bool tig_database_fclose_internal(TigDatabaseFileHandle* stream);
 static bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry, const char* mode, TigDatabaseFileHandle* stream);
 static int tig_database_fgetc_internal(TigDatabaseFileHandle* stream);
 static bool tig_database_fread_internal(void* buffer, size_t size, TigDatabaseFileHandle* stream);
+static bool tig_database_read_entry(TigDatabaseFileHandle* stream, unsigned char* buffer);
+static bool tig_database_batch_start_workers();
+static int SDLCALL tig_database_batch_worker(void* userdata);
+static bool tig_database_batch_read(TigDatabaseBatchJob* job, int index);
 
 // 0x638BBC
 static unsigned char tig_database_decompression_buffer[DECOMPRESSION_BUFFER_SIZE];
@@ -51,103 +80,221 @@ static unsigned char tig_database_decompression_buffer[DECOMPRESSION_BUFFER_SIZE
 // 0x63CBC0
 static TigDatabase* tig_database_open_databases_head;
 
+// Batch read worker pool.
+//
+// Workers are started on the first batch and inflate entries of the current
+// job alongside the calling thread. Streams are opened and closed by the
+// caller, each stream is touched by one thread at a time, so reading does not
+// need any locking (mapped archive is read-only, unmapped archives are read
+// via the stream's own `FILE`).
+//
+// The mutex guards `tig_database_batch_job` and its progress counters.
+static SDL_Mutex* tig_database_batch_mutex;
+static SDL_Condition* tig_database_batch_queued_cond;
+static SDL_Condition* tig_database_batch_done_cond;
+static SDL_Thread* tig_database_batch_workers[TIG_DATABASE_BATCH_MAX_WORKERS];
+static int tig_database_batch_workers_count;
+static int tig_database_batch_workers_requested = -1;
+static bool tig_database_batch_quit;
+static TigDatabaseBatchJob* tig_database_batch_job;
+
 // 0x53BC50
 TigDatabase* tig_database_open(const char* path)
 {
-    FILE* stream;
-    int id;
-    int name_table_size;
-    TigGuid guid;
-    int entry_table_size;
-    int entry_table_offset;
+    const void* data;
+    size_t data_size;
+    void* data_handle;
+    unsigned char* tail;
+    size_t tail_size;
+    size_t size;
     TigDatabase* database;
-    TigDatabaseEntry* entry;
-    int offset;
-    unsigned int index;
-    int name_size;
-    char* name;
-    long pos;
+
+    if (compat_map_file(path, &data, &data_size, &data_handle)) {
+        // Entry table is parsed directly from the mapping.
+        database = tig_database_parse(path, (const unsigned char*)data, data_size, data_size);
+        if (database == NULL) {
+            compat_unmap_file(data, data_size, data_handle);
+            return NULL;
+        }
+
+        database->data = (const unsigned char*)data;
+        database->data_size = data_size;
+        database->data_handle = data_handle;
+    } else {
+        // Mapping is not available (e.g. not enough address space), read
+        // entry table into memory in one go and use regular file I/O to access
+        // entries.
+        if (!tig_database_read_tail(path, &tail, &tail_size, &size)) {
+            return NULL;
+        }
+
+        database = tig_database_parse(path, tail, tail_size, size);
+        FREE(tail);
+
+        if (database == NULL) {
+            return NULL;
+        }
+
+        database->data = NULL;
+        database->data_size = 0;
+        database->data_handle = NULL;
+    }
+
+    database->next = tig_database_open_databases_head;
+    tig_database_open_databases_head = database;
+
+    tig_database_load_ignored(database);
+
+    return database;
+}
+
+// Reads the end of the archive starting with the entry table.
+bool tig_database_read_tail(const char* path, unsigned char** tail_ptr, size_t* tail_size_ptr, size_t* size_ptr)
+{
+    FILE* stream;
     long size;
+    int entry_table_offset;
+    size_t tail_size;
+    unsigned char* tail;
 
     stream = fopen(path, "rb");
     if (stream == NULL) {
-        return NULL;
+        return false;
     }
 
-    if (fseek(stream, -12, SEEK_END) != 0) {
+    if (fseek(stream, 0, SEEK_END) != 0) {
         fclose(stream);
         return false;
     }
 
-    if (fread(&id, sizeof(id), 1, stream) != 1) {
+    size = ftell(stream);
+    if (size < 12) {
         fclose(stream);
         return false;
     }
 
-    if (fread(&name_table_size, sizeof(name_table_size), 1, stream) != 1) {
+    if (fseek(stream, -4, SEEK_END) != 0
+        || fread(&entry_table_offset, sizeof(entry_table_offset), 1, stream) != 1
+        || entry_table_offset < 0) {
         fclose(stream);
         return false;
     }
 
-    if (id == FOURCC_DAT) {
-        memset(&guid, 0, sizeof(guid));
-    } else if (id == FOURCC_DAT1) {
-        if (fseek(stream, -24, SEEK_END) != 0) {
-            fclose(stream);
-            return false;
-        }
+    // Entry table is followed by the footer (which is 24 bytes at most).
+    tail_size = (size_t)entry_table_offset + 4;
+    if (tail_size < 24) {
+        tail_size = 24;
+    }
+    if (tail_size > (size_t)size) {
+        tail_size = (size_t)size;
+    }
 
-        if (fread(&guid, sizeof(guid), 1, stream) != 1) {
-            fclose(stream);
-            return false;
-        }
+    tail = (unsigned char*)MALLOC(tail_size);
 
-        if (fread(&id, sizeof(id), 1, stream) != 1) {
-            fclose(stream);
-            return false;
-        }
-    } else {
+    if (fseek(stream, size - (long)tail_size, SEEK_SET) != 0
+        || fread(tail, tail_size, 1, stream) != 1) {
+        FREE(tail);
         fclose(stream);
         return false;
     }
 
-    if (fread(&entry_table_offset, sizeof(entry_table_offset), 1, stream) != 1) {
-        fclose(stream);
+    fclose(stream);
+
+    *tail_ptr = tail;
+    *tail_size_ptr = tail_size;
+    *size_ptr = (size_t)size;
+
+    return true;
+}
+
+// Copies `size` bytes at `*pos_ptr` of the archive tail and advances position.
+static inline bool tig_database_read_tail_bytes(const unsigned char* tail, size_t tail_size, size_t* pos_ptr, void* buffer, size_t size)
+{
+    if (*pos_ptr > tail_size || tail_size - *pos_ptr < size) {
         return false;
     }
 
-    if (fseek(stream, -4 - entry_table_offset, SEEK_END) != 0) {
-        fclose(stream);
-        return false;
+    memcpy(buffer, tail + *pos_ptr, size);
+    *pos_ptr += size;
+
+    return true;
+}
+
+// Parses archive footer and entry table in one pass.
+//
+// The `tail` contains last `tail_size` bytes of the archive which is `size`
+// bytes long (these are equal when the archive is mapped).
+TigDatabase* tig_database_parse(const char* path, const unsigned char* tail, size_t tail_size, size_t size)
+{
+    size_t pos;
+    int id;
+    int name_table_size;
+    TigGuid guid;
+    int entry_table_size;
+    int entry_table_offset;
+    TigDatabase* database;
+    TigDatabaseEntry* entry;
+    int offset;
+    unsigned int index;
+    int name_size;
+    char* name;
+    char* name_table_end;
+
+    if (tail_size < 12) {
+        return NULL;
     }
 
-    if (fread(&entry_table_size, sizeof(entry_table_size), 1, stream) != 1) {
-        fclose(stream);
-        return false;
+    pos = tail_size - 12;
+    if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &id, sizeof(id))
+        || !tig_database_read_tail_bytes(tail, tail_size, &pos, &name_table_size, sizeof(name_table_size))) {
+        return NULL;
     }
 
-    pos = ftell(stream);
-    if (pos == -1
-        || fseek(stream, 0, SEEK_END) != 0) {
-        fclose(stream);
-        return false;
+    if (id == FOURCC_DAT) {
+        memset(&guid, 0, sizeof(guid));
+    } else if (id == FOURCC_DAT1) {
+        if (tail_size < 24) {
+            return NULL;
+        }
+
+        pos = tail_size - 24;
+        if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &guid, sizeof(guid))) {
+            return NULL;
+        }
+    } else {
+        return NULL;
     }
 
-    size = ftell(stream);
-    if (size == -1
-        || fseek(stream, pos, SEEK_SET) != 0) {
-        fclose(stream);
-        return false;
+    pos = tail_size - 4;
+    if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &entry_table_offset, sizeof(entry_table_offset))) {
+        return NULL;
+    }
+
+    if (entry_table_offset < 0
+        || (size_t)entry_table_offset + 4 > tail_size
+        || name_table_size < 0) {
+        return NULL;
+    }
+
+    pos = tail_size - 4 - (size_t)entry_table_offset;
+    if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &entry_table_size, sizeof(entry_table_size))) {
+        return NULL;
     }
 
     offset = (int)size - entry_table_size - entry_table_offset;
 
     database = (TigDatabase*)MALLOC(sizeof(TigDatabase));
 
-    if (fread(&(database->entries_count), sizeof(database->entries_count), 1, stream) != 1) {
+    if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &(database->entries_count), sizeof(database->entries_count))) {
         // FIX: Memory leak.
         FREE(database);
-        fclose(stream);
+        return NULL;
+    }
+
+    // FIX: Protect against entry count which cannot possibly fit into entry
+    // table (each entry takes at least 24 bytes).
+    if (database->entries_count > (tail_size - pos) / 24) {
+        FREE(database);
         return NULL;
     }
 
@@ -158,22 +305,28 @@ TigDatabase* tig_database_open(const char* path)
     database->name_table = (char*)MALLOC(name_table_size);
 
     name = database->name_table;
+    name_table_end = database->name_table + name_table_size;
     for (index = 0; index < database->entries_count; index++) {
-        if (fread(&name_size, sizeof(name_size), 1, stream) != 1) {
+        if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &name_size, sizeof(name_size))) {
             break;
         }
 
-        if (fread(name, name_size, 1, stream) != 1) {
+        // FIX: Protect against name table overflow.
+        if (name_size <= 0 || name_size > name_table_end - name) {
+            break;
+        }
+
+        if (!tig_database_read_tail_bytes(tail, tail_size, &pos, name, name_size)) {
             break;
         }
 
         entry = &(database->entries[index]);
 
-        if (fseek(stream, 4, SEEK_CUR) != 0
-            || fread(&(entry->flags), sizeof(entry->flags), 1, stream) != 1
-            || fread(&(entry->size), sizeof(entry->size), 1, stream) != 1
-            || fread(&(entry->compressed_size), sizeof(entry->compressed_size), 1, stream) != 1
-            || fread(&(entry->offset), sizeof(entry->offset), 1, stream) != 1) {
+        pos += 4;
+        if (!tig_database_read_tail_bytes(tail, tail_size, &pos, &(entry->flags), sizeof(entry->flags))
+            || !tig_database_read_tail_bytes(tail, tail_size, &pos, &(entry->size), sizeof(entry->size))
+            || !tig_database_read_tail_bytes(tail, tail_size, &pos, &(entry->compressed_size), sizeof(entry->compressed_size))
+            || !tig_database_read_tail_bytes(tail, tail_size, &pos, &(entry->offset), sizeof(entry->offset))) {
             break;
         }
 
@@ -188,20 +341,14 @@ TigDatabase* tig_database_open(const char* path)
         name += name_size;
     }
 
-    fclose(stream);
-
     if (index < database->entries_count) {
         FREE(database->name_table);
         FREE(database->entries);
+        FREE(database->path);
         FREE(database);
-        return false;
+        return NULL;
     }
 
-    database->next = tig_database_open_databases_head;
-    tig_database_open_databases_head = database;
-
-    tig_database_load_ignored(database);
-
     return database;
 }
 
@@ -237,6 +384,10 @@ bool tig_database_close(TigDatabase* database)
         curr_file_handle = next_file_handle;
     }
 
+    if (database->data != NULL) {
+        compat_unmap_file(database->data, database->data_size, database->data_handle);
+    }
+
     FREE(database->name_table);
     FREE(database->entries);
     FREE(database->path);
@@ -644,46 +795,40 @@ int tig_database_fseek(TigDatabaseFileHandle* stream, int offset, int origin)
     }
 
     if ((stream->entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0) {
-        if (fseek(stream->underlying_stream, stream->entry->offset + pos, SEEK_SET) != 0) {
+        if (stream->underlying_stream != NULL
+            && fseek(stream->underlying_stream, stream->entry->offset + pos, SEEK_SET) != 0) {
             stream->flags |= TIG_DATABASE_FILE_ERROR;
             return 1;
         }
-    } else if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
+    } else if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0
+        && stream->inflated == NULL) {
         unsigned int bytes_to_skip;
 
         if (pos < stream->pos) {
-            if (fseek(stream->underlying_stream, stream->entry->offset, SEEK_SET) != 0) {
-                stream->flags |= TIG_DATABASE_FILE_ERROR;
-                return 1;
-            }
-
-            stream->compressed_pos = 0;
-            stream->pos = 0;
-            inflateEnd(&(stream->decompression_context->zstrm));
-
-            stream->decompression_context->zstrm.next_in = NULL;
-            stream->decompression_context->zstrm.avail_in = 0;
-            stream->decompression_context->zstrm.next_out = NULL;
-            stream->decompression_context->zstrm.avail_out = 0;
-
-            if (inflateInit(&(stream->decompression_context->zstrm)) != Z_OK) {
+            // Seeking backwards means restarting inflation from the very
+            // beginning. Instead inflate the whole entry once and serve all
+            // subsequent reads and seeks from memory.
+            stream->inflated = (unsigned char*)MALLOC(stream->entry->size != 0 ? stream->entry->size : 1);
+            if (!tig_database_read_entry(stream, stream->inflated)) {
+                FREE(stream->inflated);
+                stream->inflated = NULL;
                 stream->flags |= TIG_DATABASE_FILE_ERROR;
                 return 1;
             }
-        }
+        } else {
+            bytes_to_skip = pos - stream->pos;
+            while (bytes_to_skip >= DECOMPRESSION_BUFFER_SIZE) {
+                if (!tig_database_fread_internal(tig_database_decompression_buffer, DECOMPRESSION_BUFFER_SIZE, stream)) {
+                    return 1;
+                }
 
-        bytes_to_skip = pos - stream->pos;
-        while (bytes_to_skip >= DECOMPRESSION_BUFFER_SIZE) {
-            if (!tig_database_fread_internal(tig_database_decompression_buffer, DECOMPRESSION_BUFFER_SIZE, stream)) {
-                return 1;
+                bytes_to_skip -= DECOMPRESSION_BUFFER_SIZE;
             }
 
-            bytes_to_skip -= DECOMPRESSION_BUFFER_SIZE;
-        }
-
-        if (bytes_to_skip > 0) {
-            if (!tig_database_fread_internal(tig_database_decompression_buffer, bytes_to_skip, stream)) {
-                return 1;
+            if (bytes_to_skip > 0) {
+                if (!tig_database_fread_internal(tig_database_decompression_buffer, bytes_to_skip, stream)) {
+                    return 1;
+                }
             }
         }
     }
@@ -730,6 +875,26 @@ int tig_database_ferror(TigDatabaseFileHandle* stream)
     return stream->flags & TIG_DATABASE_FILE_ERROR;
 }
 
+bool tig_database_view(TigDatabaseFileHandle* stream, const void** data_ptr, size_t* size_ptr)
+{
+    if (stream->inflated != NULL) {
+        *data_ptr = stream->inflated;
+        *size_ptr = stream->entry->size;
+        return true;
+    }
+
+    // Only stored entries of mapped archives can be accessed directly.
+    if (stream->data == NULL
+        || (stream->entry->flags & TIG_DATABASE_ENTRY_PLAIN) == 0) {
+        return false;
+    }
+
+    *data_ptr = stream->data;
+    *size_ptr = stream->entry->size;
+
+    return true;
+}
+
 // 0x53CCE0
 void tig_database_load_ignored(TigDatabase* database)
 {
@@ -826,13 +991,19 @@ bool tig_database_fclose_internal(TigDatabaseFileHandle* stream)
         stream->database->open_file_handles_head = curr->next;
     }
 
-    fclose(stream->underlying_stream);
+    if (stream->underlying_stream != NULL) {
+        fclose(stream->underlying_stream);
+    }
 
     if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
         inflateEnd(&(stream->decompression_context->zstrm));
         FREE(stream->decompression_context);
     }
 
+    if (stream->inflated != NULL) {
+        FREE(stream->inflated);
+    }
+
     memset(stream, 0, sizeof(*stream));
 
     return true;
@@ -847,13 +1018,31 @@ bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry,
 
     memset(stream, 0, sizeof(*stream));
 
-    stream->underlying_stream = fopen(database->path, "rb");
-    if (stream->underlying_stream == NULL) {
-        return false;
-    }
+    if (database->data != NULL) {
+        size_t stored_size;
 
-    if (fseek(stream->underlying_stream, entry->offset, SEEK_SET) != 0) {
-        return false;
+        stored_size = (entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0
+            ? entry->compressed_size
+            : entry->size;
+
+        if (entry->offset < 0
+            || (size_t)entry->offset > database->data_size
+            || database->data_size - (size_t)entry->offset < stored_size) {
+            return false;
+        }
+
+        stream->data = database->data + entry->offset;
+    } else {
+        stream->underlying_stream = fopen(database->path, "rb");
+        if (stream->underlying_stream == NULL) {
+            return false;
+        }
+
+        if (fseek(stream->underlying_stream, entry->offset, SEEK_SET) != 0) {
+            // FIX: Leaking file handle.
+            fclose(stream->underlying_stream);
+            return false;
+        }
     }
 
     stream->entry = entry;
@@ -863,8 +1052,12 @@ bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry,
     }
 
     if ((entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
-        stream->decompression_context = (DecompressionContext*)MALLOC(sizeof(DecompressionContext));
-        stream->decompression_context->zstrm.next_in = stream->decompression_context->buffer;
+        // Compressed data of mapped archives is inflated directly from the
+        // mapping, so the input buffer is not needed.
+        stream->decompression_context = (DecompressionContext*)MALLOC(stream->data != NULL
+                ? sizeof(z_stream)
+                : sizeof(DecompressionContext));
+        stream->decompression_context->zstrm.next_in = Z_NULL;
         stream->decompression_context->zstrm.avail_in = 0;
         stream->decompression_context->zstrm.zalloc = Z_NULL;
         stream->decompression_context->zstrm.zfree = Z_NULL;
@@ -872,7 +1065,9 @@ bool tig_database_fopen_internal(TigDatabase* database, TigDatabaseEntry* entry,
 
         if (inflateInit(&(stream->decompression_context->zstrm)) != Z_OK) {
             FREE(stream->decompression_context);
-            fclose(stream->underlying_stream);
+            if (stream->underlying_stream != NULL) {
+                fclose(stream->underlying_stream);
+            }
             return false;
         }
     }
@@ -917,10 +1112,14 @@ bool tig_database_fread_internal(void* buffer, size_t size, TigDatabaseFileHandl
     int rc;
 
     if ((stream->entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0) {
-        if (fread(buffer, size, 1, stream->underlying_stream) != 1) {
+        if (stream->data != NULL) {
+            memcpy(buffer, stream->data + stream->pos, size);
+        } else if (fread(buffer, size, 1, stream->underlying_stream) != 1) {
             stream->flags |= TIG_DATABASE_FILE_ERROR;
             return false;
         }
+    } else if (stream->inflated != NULL) {
+        memcpy(buffer, stream->inflated + stream->pos, size);
     } else if ((stream->entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0) {
         stream->decompression_context->zstrm.next_out = (Bytef*)buffer;
         stream->decompression_context->zstrm.avail_out = size;
@@ -929,18 +1128,30 @@ bool tig_database_fread_internal(void* buffer, size_t size, TigDatabaseFileHandl
             if (stream->decompression_context->zstrm.avail_in == 0) {
                 // No more unprocessed data, request next chunk.
                 bytes_to_read = stream->entry->compressed_size - stream->compressed_pos;
-                if (bytes_to_read > DECOMPRESSION_BUFFER_SIZE) {
-                    bytes_to_read = DECOMPRESSION_BUFFER_SIZE;
-                }
 
-                if (fread(stream->decompression_context->buffer, bytes_to_read, 1, stream->underlying_stream) != 1) {
-                    stream->flags |= TIG_DATABASE_FILE_ERROR;
-                    return false;
+                if (stream->data != NULL) {
+                    // Feed the rest of mapped data at once.
+                    if (bytes_to_read == 0) {
+                        stream->flags |= TIG_DATABASE_FILE_ERROR;
+                        return false;
+                    }
+
+                    stream->decompression_context->zstrm.next_in = (Bytef*)(stream->data + stream->compressed_pos);
+                } else {
+                    if (bytes_to_read > DECOMPRESSION_BUFFER_SIZE) {
+                        bytes_to_read = DECOMPRESSION_BUFFER_SIZE;
+                    }
+
+                    if (fread(stream->decompression_context->buffer, bytes_to_read, 1, stream->underlying_stream) != 1) {
+                        stream->flags |= TIG_DATABASE_FILE_ERROR;
+                        return false;
+                    }
+
+                    stream->decompression_context->zstrm.next_in = (Bytef*)stream->decompression_context->buffer;
                 }
 
                 stream->compressed_pos += bytes_to_read;
                 stream->decompression_context->zstrm.avail_in = bytes_to_read;
-                stream->decompression_context->zstrm.next_in = (Bytef*)stream->decompression_context->buffer;
             }
 
             rc = inflate(&(stream->decompression_context->zstrm), Z_NO_FLUSH);
@@ -955,3 +1166,334 @@ bool tig_database_fread_internal(void* buffer, size_t size, TigDatabaseFileHandl
 
     return true;
 }
+
+bool tig_database_read_batch(TigDatabaseFileHandle** streams, void** buffers, int count)
+{
+    TigDatabaseBatchJob job;
+    int index;
+    bool success;
+
+    for (index = 0; index < count; index++) {
+        buffers[index] = NULL;
+    }
+
+    job.streams = streams;
+    job.buffers = buffers;
+    job.count = count;
+    job.next = 0;
+    job.pending = count;
+    job.success = true;
+
+    // Not worth waking up workers for a single entry.
+    if (count < 2 || !tig_database_batch_start_workers()) {
+        for (index = 0; index < count; index++) {
+            if (!tig_database_batch_read(&job, index)) {
+                job.success = false;
+            }
+        }
+        return job.success;
+    }
+
+    SDL_LockMutex(tig_database_batch_mutex);
+    tig_database_batch_job = &job;
+    SDL_BroadcastCondition(tig_database_batch_queued_cond);
+
+    // Calling thread takes part in the job instead of just waiting.
+    while (job.next < job.count) {
+        index = job.next++;
+        SDL_UnlockMutex(tig_database_batch_mutex);
+
+        success = tig_database_batch_read(&job, index);
+
+        SDL_LockMutex(tig_database_batch_mutex);
+        if (!success) {
+            job.success = false;
+        }
+        job.pending--;
+    }
+
+    while (job.pending != 0) {
+        SDL_WaitCondition(tig_database_batch_done_cond, tig_database_batch_mutex);
+    }
+
+    tig_database_batch_job = NULL;
+    SDL_UnlockMutex(tig_database_batch_mutex);
+
+    return job.success;
+}
+
+void tig_database_batch_set_workers(int count)
+{
+    if (count > TIG_DATABASE_BATCH_MAX_WORKERS) {
+        count = TIG_DATABASE_BATCH_MAX_WORKERS;
+    }
+
+    // Workers are restarted on the next batch with new count.
+    tig_database_batch_exit();
+    tig_database_batch_workers_requested = count;
+}
+
+void tig_database_batch_exit()
+{
+    int index;
+
+    if (tig_database_batch_workers_count != 0) {
+        SDL_LockMutex(tig_database_batch_mutex);
+        tig_database_batch_quit = true;
+        SDL_BroadcastCondition(tig_database_batch_queued_cond);
+        SDL_UnlockMutex(tig_database_batch_mutex);
+
+        for (index = 0; index < tig_database_batch_workers_count; index++) {
+            SDL_WaitThread(tig_database_batch_workers[index], NULL);
+            tig_database_batch_workers[index] = NULL;
+        }
+        tig_database_batch_workers_count = 0;
+    }
+
+    if (tig_database_batch_done_cond != NULL) {
+        SDL_DestroyCondition(tig_database_batch_done_cond);
+        tig_database_batch_done_cond = NULL;
+    }
+
+    if (tig_database_batch_queued_cond != NULL) {
+        SDL_DestroyCondition(tig_database_batch_queued_cond);
+        tig_database_batch_queued_cond = NULL;
+    }
+
+    if (tig_database_batch_mutex != NULL) {
+        SDL_DestroyMutex(tig_database_batch_mutex);
+        tig_database_batch_mutex = NULL;
+    }
+
+    tig_database_batch_quit = false;
+}
+
+// Reads entire contents of the stream's entry into `buffer` (which should be
+// at least `entry->size` bytes) regardless of the stream position. Touches
+// nothing but the stream, so it is safe to call from worker threads.
+bool tig_database_read_entry(TigDatabaseFileHandle* stream, unsigned char* buffer)
+{
+    TigDatabaseEntry* entry;
+    const unsigned char* compressed_data;
+    unsigned char* compressed_buffer;
+    uLongf size;
+    int rc;
+
+    entry = stream->entry;
+
+    if (stream->inflated != NULL) {
+        memcpy(buffer, stream->inflated, entry->size);
+        return true;
+    }
+
+    if ((entry->flags & TIG_DATABASE_ENTRY_PLAIN) != 0) {
+        if (stream->data != NULL) {
+            memcpy(buffer, stream->data, entry->size);
+            return true;
+        }
+
+        if (fseek(stream->underlying_stream, entry->offset, SEEK_SET) != 0
+            || (entry->size != 0 && fread(buffer, entry->size, 1, stream->underlying_stream) != 1)) {
+            return false;
+        }
+
+        return true;
+    }
+
+    if ((entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) == 0) {
+        return false;
+    }
+
+    compressed_buffer = NULL;
+    if (stream->data != NULL) {
+        compressed_data = stream->data;
+    } else {
+        compressed_buffer = (unsigned char*)MALLOC(entry->compressed_size != 0 ? entry->compressed_size : 1);
+        if (fseek(stream->underlying_stream, entry->offset, SEEK_SET) != 0
+            || fread(compressed_buffer, entry->compressed_size, 1, stream->underlying_stream) != 1) {
+            FREE(compressed_buffer);
+            return false;
+        }
+        compressed_data = compressed_buffer;
+    }
+
+    size = entry->size;
+    rc = uncompress((Bytef*)buffer, &size, (const Bytef*)compressed_data, entry->compressed_size);
+
+    if (compressed_buffer != NULL) {
+        FREE(compressed_buffer);
+    }
+
+    return rc == Z_OK && size == entry->size;
+}
+
+bool tig_database_batch_start_workers()
+{
+    int count;
+    int index;
+    char name[16];
+
+    if (tig_database_batch_workers_count != 0) {
+        return true;
+    }
+
+    count = tig_database_batch_workers_requested;
+    if (count < 0) {
+        // Leave one core for the main thread (which takes part in batches
+        // anyway).
+        count = SDL_GetNumLogicalCPUCores() - 1;
+        if (count > TIG_DATABASE_BATCH_MAX_WORKERS) {
+            count = TIG_DATABASE_BATCH_MAX_WORKERS;
+        }
+    }
+
+    if (count <= 0) {
+        return false;
+    }
+
+    tig_database_batch_mutex = SDL_CreateMutex();
+    tig_database_batch_queued_cond = SDL_CreateCondition();
+    tig_database_batch_done_cond = SDL_CreateCondition();
+    if (tig_database_batch_mutex == NULL
+        || tig_database_batch_queued_cond == NULL
+        || tig_database_batch_done_cond == NULL) {
+        tig_database_batch_exit();
+
+        // Do not retry on every batch.
+        tig_database_batch_workers_requested = 0;
+        return false;
+    }
+
+    for (index = 0; index < count; index++) {
+        snprintf(name, sizeof(name), "tig_database_%d", index);
+        tig_database_batch_workers[index] = SDL_CreateThread(tig_database_batch_worker, name, NULL);
+        if (tig_database_batch_workers[index] == NULL) {
+            break;
+        }
+        tig_database_batch_workers_count++;
+    }
+
+    if (tig_database_batch_workers_count == 0) {
+        tig_database_batch_exit();
+        tig_database_batch_workers_requested = 0;
+        return false;
+    }
+
+    return true;
+}
+
+int SDLCALL tig_database_batch_worker(void* userdata)
+{
+    TigDatabaseBatchJob* job;
+    int index;
+    bool success;
+
+    (void)userdata;
+
+    SDL_LockMutex(tig_database_batch_mutex);
+
+    while (!tig_database_batch_quit) {
+        job = tig_database_batch_job;
+        if (job == NULL || job->next >= job->count) {
+            SDL_WaitCondition(tig_database_batch_queued_cond, tig_database_batch_mutex);
+            continue;
+        }
+
+        // The job stays alive until every picked stream is reported back.
+        index = job->next++;
+        SDL_UnlockMutex(tig_database_batch_mutex);
+
+        success = tig_database_batch_read(job, index);
+
+        SDL_LockMutex(tig_database_batch_mutex);
+        if (!success) {
+            job->success = false;
+        }
+        job->pending--;
+        if (job->pending == 0) {
+            SDL_BroadcastCondition(tig_database_batch_done_cond);
+        }
+    }
+
+    SDL_UnlockMutex(tig_database_batch_mutex);
+
+    return 0;
+}
+
+// Reads stream at `index` into newly allocated buffer. Empty slots are
+// skipped.
+bool tig_database_batch_read(TigDatabaseBatchJob* job, int index)
+{
+    TigDatabaseFileHandle* stream;
+    unsigned char* buffer;
+
+    stream = job->streams[index];
+    if (stream == NULL) {
+        return true;
+    }
+
+    buffer = (unsigned char*)MALLOC(stream->entry->size != 0 ? stream->entry->size : 1);
+    if (!tig_database_read_entry(stream, buffer)) {
+        FREE(buffer);
+        return false;
+    }
+
+    job->buffers[index] = buffer;
+
+    return true;
+}
+
+void tig_database_file_entry(TigDatabaseFileHandle* stream, TigDatabase** database_ptr, TigDatabaseEntry** entry_ptr)
+{
+    *database_ptr = stream->database;
+    *entry_ptr = stream->entry;
+}
+
+bool tig_database_read_detached(TigDatabase* database, TigDatabaseEntry* entry, void** data_ptr)
+{
+    TigDatabaseFileHandle stream;
+    size_t stored_size;
+    unsigned char* buffer;
+    bool success;
+
+    // Only the fields used by `tig_database_read_entry` are set up, the handle
+    // is not linked into `open_file_handles_head`.
+    memset(&stream, 0, sizeof(stream));
+    stream.database = database;
+    stream.entry = entry;
+
+    if (database->data != NULL) {
+        stored_size = (entry->flags & TIG_DATABASE_ENTRY_COMPRESSED) != 0
+            ? entry->compressed_size
+            : entry->size;
+
+        if (entry->offset < 0
+            || (size_t)entry->offset > database->data_size
+            || database->data_size - (size_t)entry->offset < stored_size) {
+            return false;
+        }
+
+        stream.data = database->data + entry->offset;
+    } else {
+        stream.underlying_stream = fopen(database->path, "rb");
+        if (stream.underlying_stream == NULL) {
+            return false;
+        }
+    }
+
+    buffer = (unsigned char*)MALLOC(entry->size != 0 ? entry->size : 1);
+    success = tig_database_read_entry(&stream, buffer);
+
+    if (stream.underlying_stream != NULL) {
+        fclose(stream.underlying_stream);
+    }
+
+    if (!success) {
+        FREE(buffer);
+        return false;
+    }
+
+    *data_ptr = buffer;
+
+    return true;
+}
@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include <fpattern/fpattern.h>
+#include <zlib.h>
 
 #include "tig/compat.h"
 #include "tig/core.h"
@@ -21,6 +22,15 @@
 #define TIG_FILE_DATABASE 0x01
 #define TIG_FILE_PLAIN 0x02
 #define TIG_FILE_DELETE_ON_CLOSE 0x04
+#define TIG_FILE_MEMORY 0x08
+
+// Read-only stream over the memory buffer, see `tig_file_fopen_memory`.
+typedef struct TigFileMemoryStream {
+    uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool eof;
+} TigFileMemoryStream;
 
 typedef struct TigFile {
     /* 0000 */ char* path;
@@ -28,6 +38,7 @@ typedef struct TigFile {
     /* 0008 */ union {
         TigDatabaseFileHandle* database_file_stream;
         FILE* plain_file_stream;
+        TigFileMemoryStream* memory_file_stream;
     } impl;
 } TigFile;
 
@@ -50,6 +61,49 @@ typedef struct TigFileIgnore {
     /* 0008 */ struct TigFileIgnore* next;
 } TigFileIgnore;
 
+#define TIG_FILE_INDEX_MIN_CAPACITY 1024
+#define TIG_FILE_INDEX_MAX_SIZE 65536
+
+// Known location of a file in directory repositories, see
+// `tig_file_index_find`.
+//
+// Lookups for opening and existence checks are tracked separately since they
+// probe the file system differently (`fopen` vs. `tig_find_first_file`).
+typedef struct TigFileIndexEntry {
+    char* path;
+    unsigned int hash;
+    bool open_known;
+    TigFileRepository* open_repo;
+    bool exists_known;
+    TigFileRepository* exists_repo;
+} TigFileIndexEntry;
+
+// Single record of the archive index, see `tig_file_archive_ex`.
+typedef struct TigFileArchiveEntry {
+    int type;
+    char* name;
+    void* data;
+    int size;
+} TigFileArchiveEntry;
+
+typedef struct TigFileArchiveJob {
+    char index_path[TIG_MAX_PATH];
+    char data_path[TIG_MAX_PATH];
+    TigFile* index_stream;
+    TigFile* data_stream;
+    unsigned int flags;
+    TigFileArchiveProgressFunc* progress_func;
+    TigFileArchiveDoneFunc* done_func;
+    TigFileArchiveEntry* entries;
+    int entries_count;
+    int entries_capacity;
+    int files_count;
+    bool success;
+
+    // Set by the worker once `success` is final.
+    SDL_AtomicInt done;
+} TigFileArchiveJob;
+
 static bool tig_file_mkdir_native(const char* path);
 static bool tig_file_rmdir_native(const char* path);
 static bool tig_file_empty_directory_native(const char* path);
@@ -84,6 +138,20 @@ static unsigned int tig_file_ignored(const char* path);
 static bool tig_file_copy_native(const char* src, const char* dst);
 static bool tig_file_copy_internal(TigFile* dst, TigFile* src);
 static int tig_file_rmdir_recursively_native(const char* path);
+static bool tig_file_archive_ex_native(const char* dst, const char* src, unsigned int flags, TigFileArchiveProgressFunc* progress_func, TigFileArchiveDoneFunc* done_func);
+static bool tig_file_archive_snapshot_native(const char* path, TigFileArchiveJob* job);
+static void tig_file_archive_job_add(TigFileArchiveJob* job, int type, const char* name, void* data, int size);
+static void tig_file_archive_job_destroy(TigFileArchiveJob* job);
+static bool tig_file_archive_write(TigFileArchiveJob* job);
+static bool tig_file_archive_write_entry(TigFileArchiveJob* job, TigFileArchiveEntry* entry);
+static bool tig_file_archive_write_record(TigFileArchiveJob* job, int type, TigFileArchiveEntry* entry, void* data, int size);
+static int SDLCALL tig_file_archive_thread_func(void* userdata);
+static bool tig_file_unarchive_compressed(TigFile* dst_stream, TigFile* src_stream, int size, int compressed_size);
+static bool tig_file_index_key(const char* path, char* key, unsigned int* hash_ptr);
+static TigFileIndexEntry* tig_file_index_find(const char* path);
+static void tig_file_index_invalidate(const char* path);
+static void tig_file_index_flush();
+static void tig_file_index_grow();
 
 // 0x62B2A8
 static TigFileIgnore* off_62B2A8;
@@ -94,6 +162,35 @@ static TigFileRepository* tig_file_repositories_head;
 // 0x62B2B0
 static TigFileIgnore* tig_file_ignore_head;
 
+// Archive being written in the background, see `tig_file_archive_ex`.
+static TigFileArchiveJob* tig_file_archive_job;
+
+static SDL_Thread* tig_file_archive_thread;
+
+/**
+ * Index of file lookups in directory repositories.
+ *
+ * Looking up a file which is not in the first directory repository costs a
+ * file system probe for every repository in the chain. The index remembers
+ * where the file was found (or that it was not found at all), so that
+ * subsequent lookups cost a single probe at most.
+ *
+ * Positive entries are verified by the probe itself and fixed on the fly when
+ * they turn out to be stale. Negative entries cannot be verified, so every
+ * operation that can make a file appear (writes, renames, making directories)
+ * invalidates the corresponding entry. Changing repositories or ignore rules
+ * drops the entire index.
+ *
+ * The table uses open addressing keyed by the normalized path.
+ */
+static TigFileIndexEntry* tig_file_index_entries;
+
+static int tig_file_index_capacity;
+
+static int tig_file_index_size;
+
+static TigFileIndexStats tig_file_index_stats_data;
+
 // 0x52DFE0
 bool tig_file_mkdir_native(const char* path)
 {
@@ -288,6 +385,7 @@ bool tig_file_unarchive_native(const char* src, const char* dst)
     TigFile* data_stream;
     int type;
     int size;
+    int compressed_size;
     char* pch;
     TigFile* tmp_stream;
 
@@ -358,6 +456,38 @@ bool tig_file_unarchive_native(const char* src, const char* dst)
             tig_file_fclose(data_stream);
             tig_file_fclose(index_stream);
             return true;
+        } else if (type == 4) {
+            // Compressed file (not present in original archives).
+            if (tig_file_fread(&size, sizeof(size), 1, index_stream) != 1) {
+                break;
+            }
+
+            if (tig_file_fread(path1, size, 1, index_stream) != 1) {
+                break;
+            }
+
+            path1[size] = '\0';
+
+            if (tig_file_fread(&size, sizeof(size), 1, index_stream) != 1) {
+                break;
+            }
+
+            if (tig_file_fread(&compressed_size, sizeof(compressed_size), 1, index_stream) != 1) {
+                break;
+            }
+
+            compat_join_path(path3, sizeof(path3), path2, path1);
+            tmp_stream = tig_file_fopen_native(path3, "wb");
+            if (tmp_stream == NULL) {
+                break;
+            }
+
+            if (!tig_file_unarchive_compressed(tmp_stream, data_stream, size, compressed_size)) {
+                tig_file_fclose(tmp_stream);
+                break;
+            }
+
+            tig_file_fclose(tmp_stream);
         }
     }
 
@@ -557,6 +687,9 @@ void tig_file_exit()
 {
     TigFileIgnore* next;
 
+    tig_file_archive_wait();
+    tig_database_batch_exit();
+
     while (tig_file_ignore_head != NULL) {
         next = tig_file_ignore_head->next;
         if (tig_file_ignore_head->path != NULL) {
@@ -567,6 +700,13 @@ void tig_file_exit()
     }
 
     tig_file_repository_remove_all();
+
+    compat_clear_path_cache();
+
+    tig_file_index_flush();
+    FREE(tig_file_index_entries);
+    tig_file_index_entries = NULL;
+    tig_file_index_capacity = 0;
 }
 
 // 0x52ED40
@@ -580,6 +720,9 @@ bool tig_file_repository_add_native(const char* path)
     TigDatabase* database;
     char cache_path[TIG_MAX_PATH];
 
+    // Search order is about to change.
+    tig_file_index_flush();
+
     prev = NULL;
     curr = tig_file_repositories_head;
     while (curr != NULL && SDL_strcasecmp(curr->path, path) != 0) {
@@ -667,6 +810,8 @@ bool tig_file_repository_remove_native(const char* file_name)
     bool removed = false;
     char path[TIG_MAX_PATH];
 
+    tig_file_index_flush();
+
     prev = NULL;
     repo = tig_file_repositories_head;
     while (repo != NULL) {
@@ -706,6 +851,8 @@ bool tig_file_repository_remove_all()
     TigFileRepository* next;
     char path[TIG_MAX_PATH];
 
+    tig_file_index_flush();
+
     curr = tig_file_repositories_head;
     while (curr != NULL) {
         next = curr->next;
@@ -753,6 +900,8 @@ int tig_file_mkdir_ex_native(const char* path)
 
     temp_path[0] = '\0';
 
+    tig_file_index_invalidate(path);
+
     if (path[0] != '.' && path[0] != '\\' && path[1] != ':' && path[0] != '/') {
         repo = tig_file_repositories_head;
         while (repo != NULL) {
@@ -775,6 +924,8 @@ int tig_file_mkdir_ex_native(const char* path)
         return -1;
     }
 
+    compat_invalidate_path(temp_path);
+
     return 0;
 }
 
@@ -803,6 +954,8 @@ int tig_file_rmdir_ex_native(const char* path)
         return -1;
     }
 
+    compat_invalidate_path(temp_path);
+
     return 0;
 }
 
@@ -821,6 +974,8 @@ void tig_file_ignore(const char* path, unsigned int flags)
             ignore->next = tig_file_ignore_head;
             tig_file_ignore_head = ignore;
 
+            tig_file_index_flush();
+
             // Trim *.* pattern from the end of string.
             path_length = strlen(ignore->path);
             if (path_length > 3) {
@@ -1057,6 +1212,10 @@ int tig_file_filelength(TigFile* stream)
         return (int)size;
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        return (int)stream->impl.memory_file_stream->size;
+    }
+
     return -1;
 }
 
@@ -1066,6 +1225,9 @@ bool tig_file_exists_native(const char* file_name, TigFileInfo* info)
     TigFindFileData ffd;
     TigFileRepository* repo;
     TigDatabaseEntry* database_entry;
+    TigFileIndexEntry* index_entry;
+    TigFileRepository* found_repo;
+    bool found;
     unsigned int ignored;
     char path[TIG_MAX_PATH];
     char fname[COMPAT_MAX_FNAME];
@@ -1090,14 +1252,35 @@ bool tig_file_exists_native(const char* file_name, TigFileInfo* info)
         return true;
     }
 
+    index_entry = tig_file_index_find(file_name);
+    if (index_entry != NULL) {
+        tig_file_index_stats_data.lookups++;
+        if (!index_entry->exists_known) {
+            tig_file_index_stats_data.misses++;
+        } else if (index_entry->exists_repo != NULL) {
+            tig_file_index_stats_data.hits++;
+        } else {
+            tig_file_index_stats_data.negative_hits++;
+        }
+    }
+
+    found = false;
+    found_repo = NULL;
+
     repo = tig_file_repositories_head;
     while (repo != NULL) {
         if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0) {
+            // When the location is known only that directory needs to be
+            // probed.
+            if ((ignored & TIG_FILE_IGNORE_DIRECTORY) == 0
+                && (index_entry == NULL
+                    || !index_entry->exists_known
+                    || index_entry->exists_repo == repo)) {
                 compat_join_path(path, sizeof(path), repo->path, file_name);
 
+                tig_file_index_stats_data.probes++;
                 if (tig_find_first_file(path, &ffd)) {
-                    if (info != NULL) {
+                    if (!found && info != NULL) {
                         tig_file_process_attribs(ffd.path_info.type, &(info->attributes));
                         info->size = (size_t)ffd.path_info.size;
                         strcpy(info->path, ffd.name);
@@ -1105,12 +1288,22 @@ bool tig_file_exists_native(const char* file_name, TigFileInfo* info)
                     }
 
                     tig_find_close(&ffd);
-                    return true;
+                    found = true;
+                    found_repo = repo;
+                    break;
                 }
                 tig_find_close(&ffd);
+
+                if (index_entry != NULL && index_entry->exists_known) {
+                    // The file is gone from where it was seen last time,
+                    // forget the location and start over.
+                    tig_file_index_stats_data.stale++;
+                    index_entry->exists_known = false;
+                    return tig_file_exists_native(file_name, info);
+                }
             }
         } else if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0) {
-            if ((ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
+            if (!found && (ignored & TIG_FILE_IGNORE_DATABASE) == 0) {
                 if (tig_database_get_entry(repo->database, file_name, &database_entry)) {
                     if (info != NULL) {
                         info->attributes = TIG_FILE_ATTRIBUTE_0x80 | TIG_FILE_ATTRIBUTE_READONLY;
@@ -1123,14 +1316,25 @@ bool tig_file_exists_native(const char* file_name, TigFileInfo* info)
                         compat_makepath(info->path, 0, 0, fname, ext);
                     }
 
-                    return true;
+                    found = true;
+
+                    // Unless the index entry needs to be completed, there is
+                    // no point in looking any further.
+                    if (index_entry == NULL || index_entry->exists_known) {
+                        return true;
+                    }
                 }
             }
         }
         repo = repo->next;
     }
 
-    return false;
+    if (index_entry != NULL && !index_entry->exists_known) {
+        index_entry->exists_known = true;
+        index_entry->exists_repo = found_repo;
+    }
+
+    return found;
 }
 
 // 0x52FE60
@@ -1202,8 +1406,16 @@ int tig_file_remove_native(const char* file_name)
     char path[TIG_MAX_PATH];
     TigDatabaseEntry* database_entry;
 
+    tig_file_index_invalidate(file_name);
+
     if (file_name[0] == '.' || file_name[0] == '\\' || file_name[1] == ':' || file_name[0] == '/') {
-        return SDL_RemovePath(file_name) ? 0 : 1;
+        if (!SDL_RemovePath(file_name)) {
+            return 1;
+        }
+
+        compat_invalidate_path(file_name);
+
+        return 0;
     }
 
     if ((tig_file_ignored(file_name) & 0x2) != 0) {
@@ -1216,6 +1428,8 @@ int tig_file_remove_native(const char* file_name)
             compat_join_path(path, sizeof(path), repo->path, file_name);
 
             if (SDL_RemovePath(path)) {
+                compat_invalidate_path(path);
+
                 repo = repo->next;
                 while (repo != NULL) {
                     if ((repo->type & TIG_FILE_DATABASE) != 0
@@ -1243,8 +1457,19 @@ int tig_file_rename_native(const char* old_file_name, const char* new_file_name)
     char old_path[TIG_MAX_PATH];
     char new_path[TIG_MAX_PATH];
 
+    // Renaming a directory moves everything inside it, so individual entries
+    // cannot be tracked.
+    tig_file_index_flush();
+
     if (old_file_name[0] == '.' || old_file_name[0] == '\\' || old_file_name[1] == ':' || old_file_name[0] == '/') {
-        return SDL_RenamePath(old_file_name, new_file_name) ? 0 : 1;
+        if (!SDL_RenamePath(old_file_name, new_file_name)) {
+            return 1;
+        }
+
+        compat_invalidate_path(old_file_name);
+        compat_invalidate_path(new_file_name);
+
+        return 0;
     }
 
     if ((tig_file_ignored(old_file_name) & 0x2) != 0) {
@@ -1258,6 +1483,8 @@ int tig_file_rename_native(const char* old_file_name, const char* new_file_name)
             compat_join_path(new_path, sizeof(new_path), repo->path, new_file_name);
 
             if (SDL_RenamePath(old_path, new_path)) {
+                compat_invalidate_path(old_path);
+                compat_invalidate_path(new_path);
                 return 0;
             }
         }
@@ -1395,6 +1622,17 @@ int tig_file_fgetc(TigFile* stream)
         return fgetc(stream->impl.plain_file_stream);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        TigFileMemoryStream* memory_stream = stream->impl.memory_file_stream;
+
+        if (memory_stream->pos >= memory_stream->size) {
+            memory_stream->eof = true;
+            return -1;
+        }
+
+        return memory_stream->data[memory_stream->pos++];
+    }
+
     return -1;
 }
 
@@ -1409,6 +1647,28 @@ char* tig_file_fgets(char* buffer, int max_count, TigFile* stream)
         return fgets(buffer, max_count, stream->impl.plain_file_stream);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        int count = 0;
+        int ch = '\0';
+
+        while (count < max_count - 1 && ch != '\n') {
+            ch = tig_file_fgetc(stream);
+            if (ch == -1) {
+                break;
+            }
+
+            buffer[count++] = (char)ch;
+        }
+
+        if (count == 0) {
+            return NULL;
+        }
+
+        buffer[count] = '\0';
+
+        return buffer;
+    }
+
     return NULL;
 }
 
@@ -1451,6 +1711,22 @@ int tig_file_ungetc(int ch, TigFile* stream)
         return ungetc(ch, stream->impl.plain_file_stream);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        TigFileMemoryStream* memory_stream = stream->impl.memory_file_stream;
+
+        // Only characters which were actually read can be pushed back.
+        if (ch == -1
+            || memory_stream->pos == 0
+            || memory_stream->data[memory_stream->pos - 1] != (uint8_t)ch) {
+            return -1;
+        }
+
+        memory_stream->pos--;
+        memory_stream->eof = false;
+
+        return ch;
+    }
+
     return -1;
 }
 
@@ -1469,6 +1745,21 @@ size_t tig_file_fread(void* buffer, size_t size, size_t count, TigFile* stream)
         return fread(buffer, size, count, stream->impl.plain_file_stream);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        TigFileMemoryStream* memory_stream = stream->impl.memory_file_stream;
+        size_t available = (memory_stream->size - memory_stream->pos) / size;
+
+        if (count > available) {
+            count = available;
+            memory_stream->eof = true;
+        }
+
+        memcpy(buffer, memory_stream->data + memory_stream->pos, size * count);
+        memory_stream->pos += size * count;
+
+        return count;
+    }
+
     return count - 1;
 }
 
@@ -1512,6 +1803,34 @@ int tig_file_fseek(TigFile* stream, int offset, int origin)
         return fseek(stream->impl.plain_file_stream, offset, origin);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        TigFileMemoryStream* memory_stream = stream->impl.memory_file_stream;
+        int64_t pos;
+
+        switch (origin) {
+        case SEEK_SET:
+            pos = offset;
+            break;
+        case SEEK_CUR:
+            pos = (int64_t)memory_stream->pos + offset;
+            break;
+        case SEEK_END:
+            pos = (int64_t)memory_stream->size + offset;
+            break;
+        default:
+            return 1;
+        }
+
+        if (pos < 0 || (uint64_t)pos > memory_stream->size) {
+            return 1;
+        }
+
+        memory_stream->pos = (size_t)pos;
+        memory_stream->eof = false;
+
+        return 0;
+    }
+
     return 1;
 }
 
@@ -1532,6 +1851,10 @@ int tig_file_ftell(TigFile* stream)
         return ftell(stream->impl.plain_file_stream);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        return (int)stream->impl.memory_file_stream->pos;
+    }
+
     return -1;
 }
 
@@ -1542,6 +1865,9 @@ void tig_file_rewind(TigFile* stream)
         tig_database_rewind(stream->impl.database_file_stream);
     } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
         rewind(stream->impl.plain_file_stream);
+    } else if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        stream->impl.memory_file_stream->pos = 0;
+        stream->impl.memory_file_stream->eof = false;
     }
 }
 
@@ -1552,6 +1878,8 @@ void tig_file_clearerr(TigFile* stream)
         tig_database_clearerr(stream->impl.database_file_stream);
     } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
         clearerr(stream->impl.plain_file_stream);
+    } else if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        stream->impl.memory_file_stream->eof = false;
     }
 }
 
@@ -1566,6 +1894,10 @@ int tig_file_feof(TigFile* stream)
         return feof(stream->impl.plain_file_stream);
     }
 
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        return stream->impl.memory_file_stream->eof;
+    }
+
     return 0;
 }
 
@@ -1583,6 +1915,39 @@ int tig_file_ferror(TigFile* stream)
     return 0;
 }
 
+bool tig_file_view(TigFile* stream, const void** data_ptr, size_t* size_ptr)
+{
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        return tig_database_view(stream->impl.database_file_stream, data_ptr, size_ptr);
+    }
+
+    if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        *data_ptr = stream->impl.memory_file_stream->data;
+        *size_ptr = stream->impl.memory_file_stream->size;
+        return true;
+    }
+
+    return false;
+}
+
+TigFile* tig_file_fopen_memory(void* data, size_t size)
+{
+    TigFile* stream;
+    TigFileMemoryStream* memory_stream;
+
+    memory_stream = (TigFileMemoryStream*)MALLOC(sizeof(*memory_stream));
+    memory_stream->data = (uint8_t*)data;
+    memory_stream->size = size;
+    memory_stream->pos = 0;
+    memory_stream->eof = false;
+
+    stream = tig_file_create();
+    stream->flags |= TIG_FILE_MEMORY;
+    stream->impl.memory_file_stream = memory_stream;
+
+    return stream;
+}
+
 // 0x5308A0
 void sub_5308A0(int a1, int a2)
 {
@@ -1606,6 +1971,8 @@ bool tig_file_lock(const char* filename, const void* owner, size_t size)
     TigFileRepository* repo;
     FILE* stream;
 
+    tig_file_index_invalidate(filename);
+
     if (filename[0] == '.' || filename[0] == '\\' || filename[1] == ':') {
         strcpy(path, filename);
     } else {
@@ -1748,6 +2115,12 @@ bool tig_file_close_internal(TigFile* stream)
         if (fclose(stream->impl.plain_file_stream) == 0) {
             success = true;
         }
+    } else if ((stream->flags & TIG_FILE_MEMORY) != 0) {
+        if (stream->impl.memory_file_stream->data != NULL) {
+            FREE(stream->impl.memory_file_stream->data);
+        }
+        FREE(stream->impl.memory_file_stream);
+        success = true;
     }
 
     if ((stream->flags & TIG_FILE_DELETE_ON_CLOSE) != 0) {
@@ -1767,11 +2140,20 @@ int tig_file_open_internal_native(const char* path, const char* mode, TigFile* s
     TigFileRepository* repo;
     TigFileRepository* writeable_repo;
     TigDatabaseEntry* database_entry;
+    TigFileIndexEntry* index_entry;
+    bool writing;
     char mutable_path[TIG_MAX_PATH];
 
     stream->flags &= ~(TIG_FILE_DATABASE | TIG_FILE_PLAIN);
 
+    // Any mode other than reading can create the file.
+    writing = strpbrk(mode, "wa+") != NULL;
+
     if (path[0] == '.' || path[0] == '\\' || path[1] == ':' || path[0] == '/') {
+        if (writing) {
+            tig_file_index_invalidate(path);
+        }
+
         stream->impl.plain_file_stream = fopen(path, mode);
         if (stream->impl.plain_file_stream == NULL) {
             return 0;
@@ -1781,6 +2163,10 @@ int tig_file_open_internal_native(const char* path, const char* mode, TigFile* s
     } else {
         ignored = tig_file_ignored(path);
 
+        if (writing) {
+            tig_file_index_invalidate(path);
+        }
+
         repo = tig_file_repositories_head;
         while (repo != NULL) {
             if ((repo->type & TIG_FILE_REPOSITORY_DATABASE) != 0
@@ -1818,19 +2204,57 @@ int tig_file_open_internal_native(const char* path, const char* mode, TigFile* s
 
         if ((stream->flags & (TIG_FILE_DATABASE | TIG_FILE_PLAIN)) == 0
             && (ignored & TIG_FILE_PLAIN) == 0) {
-            repo = tig_file_repositories_head;
-            while (repo != NULL) {
-                if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
-                    compat_join_path(mutable_path, sizeof(mutable_path), repo->path, path);
-                    compat_resolve_path(mutable_path);
-
-                    stream->impl.plain_file_stream = fopen(mutable_path, mode);
-                    if (stream->impl.plain_file_stream != NULL) {
-                        stream->flags |= TIG_FILE_PLAIN;
-                        break;
+            index_entry = !writing ? tig_file_index_find(path) : NULL;
+            if (index_entry != NULL) {
+                tig_file_index_stats_data.lookups++;
+
+                if (index_entry->open_known) {
+                    if (index_entry->open_repo == NULL) {
+                        tig_file_index_stats_data.negative_hits++;
+                    } else {
+                        compat_join_path(mutable_path, sizeof(mutable_path), index_entry->open_repo->path, path);
+                        compat_resolve_path(mutable_path);
+
+                        tig_file_index_stats_data.probes++;
+                        stream->impl.plain_file_stream = fopen(mutable_path, mode);
+                        if (stream->impl.plain_file_stream != NULL) {
+                            tig_file_index_stats_data.hits++;
+                            stream->flags |= TIG_FILE_PLAIN;
+                        } else {
+                            // The file is gone from where it was seen last
+                            // time, fall back to the full search.
+                            tig_file_index_stats_data.stale++;
+                            index_entry->open_known = false;
+                        }
                     }
                 }
-                repo = repo->next;
+
+                if (!index_entry->open_known) {
+                    tig_file_index_stats_data.misses++;
+                }
+            }
+
+            if (index_entry == NULL || !index_entry->open_known) {
+                repo = tig_file_repositories_head;
+                while (repo != NULL) {
+                    if ((repo->type & TIG_FILE_REPOSITORY_DIRECTORY) != 0) {
+                        compat_join_path(mutable_path, sizeof(mutable_path), repo->path, path);
+                        compat_resolve_path(mutable_path);
+
+                        tig_file_index_stats_data.probes++;
+                        stream->impl.plain_file_stream = fopen(mutable_path, mode);
+                        if (stream->impl.plain_file_stream != NULL) {
+                            stream->flags |= TIG_FILE_PLAIN;
+                            break;
+                        }
+                    }
+                    repo = repo->next;
+                }
+
+                if (index_entry != NULL) {
+                    index_entry->open_known = true;
+                    index_entry->open_repo = repo;
+                }
             }
         }
     }
@@ -2019,6 +2443,9 @@ int tig_file_rmdir_recursively_native(const char* path)
     }
     tig_find_close(&ffd);
 
+    // Contents are gone even if the directory itself cannot be removed.
+    compat_invalidate_path(path);
+
     if (!SDL_RemovePath(path)) {
         return -1;
     }
@@ -2189,6 +2616,10 @@ bool tig_file_archive(const char* dst, const char* src)
     compat_windows_path_to_native(native_src);
     compat_resolve_path(native_src);
 
+    // Make sure the previous background archive is complete (it might be
+    // writing the same files).
+    tig_file_archive_wait();
+
     return tig_file_archive_native(native_dst, native_src);
 }
 
@@ -2205,6 +2636,9 @@ bool tig_file_unarchive(const char* src, const char* dst)
     compat_windows_path_to_native(native_dst);
     compat_resolve_path(native_dst);
 
+    // Make sure the archive is not being written in the background.
+    tig_file_archive_wait();
+
     return tig_file_unarchive_native(native_src, native_dst);
 }
 
@@ -2369,3 +2803,706 @@ bool tig_file_copy(const char* src, const char* dst)
 
     return tig_file_copy_native(native_src, native_dst);
 }
+
+bool tig_file_archive_ex(const char* dst, const char* src, unsigned int flags, TigFileArchiveProgressFunc* progress_func, TigFileArchiveDoneFunc* done_func)
+{
+    char native_dst[TIG_MAX_PATH];
+    char native_src[TIG_MAX_PATH];
+
+    strcpy(native_dst, dst);
+    compat_windows_path_to_native(native_dst);
+    compat_resolve_path(native_dst);
+
+    strcpy(native_src, src);
+    compat_windows_path_to_native(native_src);
+    compat_resolve_path(native_src);
+
+    // Only one archive can be written in the background at a time.
+    tig_file_archive_wait();
+
+    return tig_file_archive_ex_native(native_dst, native_src, flags, progress_func, done_func);
+}
+
+bool tig_file_archive_wait()
+{
+    TigFileArchiveJob* job;
+    bool success;
+
+    job = tig_file_archive_job;
+    if (job == NULL) {
+        return true;
+    }
+
+    SDL_WaitThread(tig_file_archive_thread, NULL);
+    tig_file_archive_thread = NULL;
+    tig_file_archive_job = NULL;
+
+    success = job->success;
+    if (!success) {
+        tig_debug_printf("tig_file_archive_wait: Failed to write archive %s\n", job->data_path);
+        tig_file_remove_native(job->data_path);
+        tig_file_remove_native(job->index_path);
+    }
+
+    if (job->done_func != NULL) {
+        job->done_func(success);
+    }
+
+    tig_file_archive_job_destroy(job);
+
+    return success;
+}
+
+void tig_file_archive_ping()
+{
+    if (tig_file_archive_job != NULL
+        && SDL_GetAtomicInt(&(tig_file_archive_job->done)) != 0) {
+        tig_file_archive_wait();
+    }
+}
+
+bool tig_file_archive_ex_native(const char* dst, const char* src, unsigned int flags, TigFileArchiveProgressFunc* progress_func, TigFileArchiveDoneFunc* done_func)
+{
+    TigFileArchiveJob* job;
+    bool success;
+
+    if (!tig_file_is_directory(src)) {
+        return false;
+    }
+
+    job = (TigFileArchiveJob*)CALLOC(1, sizeof(*job));
+    job->flags = flags;
+    job->progress_func = progress_func;
+    job->done_func = done_func;
+    sprintf(job->index_path, "%s.tfai", dst);
+    sprintf(job->data_path, "%s.tfaf", dst);
+
+    // Read the entire directory tree into memory, so that the caller is free
+    // to change it once we return.
+    if (!tig_file_archive_snapshot_native(src, job)) {
+        tig_file_archive_job_destroy(job);
+        return false;
+    }
+
+    // Streams are opened on the calling thread since opening files is not
+    // thread-safe.
+    job->index_stream = tig_file_fopen_native(job->index_path, "wb");
+    if (job->index_stream == NULL) {
+        tig_file_archive_job_destroy(job);
+        return false;
+    }
+
+    job->data_stream = tig_file_fopen_native(job->data_path, "wb");
+    if (job->data_stream == NULL) {
+        tig_file_fclose(job->index_stream);
+        job->index_stream = NULL;
+        tig_file_remove_native(job->index_path);
+        tig_file_archive_job_destroy(job);
+        return false;
+    }
+
+    if ((flags & TIG_FILE_ARCHIVE_BACKGROUND) != 0) {
+        tig_file_archive_thread = SDL_CreateThread(tig_file_archive_thread_func, "tig_file_archive", job);
+        if (tig_file_archive_thread != NULL) {
+            tig_file_archive_job = job;
+            return true;
+        }
+
+        // Fall back to writing the archive on the calling thread.
+    }
+
+    success = tig_file_archive_write(job);
+    if (!success) {
+        tig_file_remove_native(job->data_path);
+        tig_file_remove_native(job->index_path);
+    }
+
+    tig_file_archive_job_destroy(job);
+
+    return success;
+}
+
+bool tig_file_archive_snapshot_native(const char* path, TigFileArchiveJob* job)
+{
+    char pattern[TIG_MAX_PATH];
+    TigFileList list;
+    unsigned int index;
+    TigFile* stream;
+    void* data;
+    int size;
+
+    compat_join_path(pattern, sizeof(pattern), path, "*.*");
+    tig_file_list_create_native(&list, pattern);
+
+    for (index = 0; index < list.count; index++) {
+        if ((list.entries[index].attributes & TIG_FILE_ATTRIBUTE_SUBDIR) != 0) {
+            if (strcmp(list.entries[index].path, ".") != 0
+                && strcmp(list.entries[index].path, "..") != 0) {
+                tig_file_archive_job_add(job, 1, list.entries[index].path, NULL, 0);
+
+                compat_join_path(pattern, sizeof(pattern), path, list.entries[index].path);
+                if (!tig_file_archive_snapshot_native(pattern, job)) {
+                    tig_file_list_destroy(&list);
+                    return false;
+                }
+
+                tig_file_archive_job_add(job, 2, NULL, NULL, 0);
+            }
+        } else {
+            compat_join_path(pattern, sizeof(pattern), path, list.entries[index].path);
+
+            stream = tig_file_fopen(pattern, "rb");
+            if (stream == NULL) {
+                tig_file_list_destroy(&list);
+                return false;
+            }
+
+            size = tig_file_filelength(stream);
+            data = NULL;
+            if (size > 0) {
+                data = MALLOC(size);
+                if (tig_file_fread(data, size, 1, stream) != 1) {
+                    FREE(data);
+                    tig_file_fclose(stream);
+                    tig_file_list_destroy(&list);
+                    return false;
+                }
+            }
+
+            tig_file_fclose(stream);
+
+            tig_file_archive_job_add(job, 0, list.entries[index].path, data, size);
+            job->files_count++;
+        }
+    }
+
+    tig_file_list_destroy(&list);
+    return true;
+}
+
+void tig_file_archive_job_add(TigFileArchiveJob* job, int type, const char* name, void* data, int size)
+{
+    TigFileArchiveEntry* entry;
+
+    if (job->entries_count == job->entries_capacity) {
+        job->entries_capacity += 64;
+        job->entries = (TigFileArchiveEntry*)REALLOC(job->entries, sizeof(*job->entries) * job->entries_capacity);
+    }
+
+    entry = &(job->entries[job->entries_count++]);
+    entry->type = type;
+    entry->name = name != NULL ? STRDUP(name) : NULL;
+    entry->data = data;
+    entry->size = size;
+}
+
+void tig_file_archive_job_destroy(TigFileArchiveJob* job)
+{
+    int index;
+
+    for (index = 0; index < job->entries_count; index++) {
+        if (job->entries[index].name != NULL) {
+            FREE(job->entries[index].name);
+        }
+        if (job->entries[index].data != NULL) {
+            FREE(job->entries[index].data);
+        }
+    }
+
+    if (job->entries != NULL) {
+        FREE(job->entries);
+    }
+
+    FREE(job);
+}
+
+/**
+ * Writes snapshotted directory tree into the archive.
+ *
+ * NOTE: This function might be called on the worker thread, so it should not
+ * open files or access anything other than the job itself.
+ */
+bool tig_file_archive_write(TigFileArchiveJob* job)
+{
+    int index;
+    int done;
+    int type;
+    bool success = true;
+
+    done = 0;
+    for (index = 0; index < job->entries_count; index++) {
+        if (!tig_file_archive_write_entry(job, &(job->entries[index]))) {
+            success = false;
+            break;
+        }
+
+        if (job->entries[index].type == 0) {
+            // Release file data early, it is no longer needed.
+            if (job->entries[index].data != NULL) {
+                FREE(job->entries[index].data);
+                job->entries[index].data = NULL;
+            }
+
+            done++;
+            if (job->progress_func != NULL) {
+                job->progress_func(done, job->files_count);
+            }
+        }
+    }
+
+    if (success) {
+        type = 3;
+        if (tig_file_fwrite(&type, sizeof(type), 1, job->index_stream) != 1) {
+            success = false;
+        }
+    }
+
+    if (tig_file_fclose(job->data_stream) != 0) {
+        success = false;
+    }
+    job->data_stream = NULL;
+
+    if (tig_file_fclose(job->index_stream) != 0) {
+        success = false;
+    }
+    job->index_stream = NULL;
+
+    return success;
+}
+
+bool tig_file_archive_write_entry(TigFileArchiveJob* job, TigFileArchiveEntry* entry)
+{
+    void* compressed_data;
+    uLongf compressed_size;
+    bool success;
+
+    if (entry->type == 0
+        && (job->flags & TIG_FILE_ARCHIVE_COMPRESS) != 0
+        && entry->size > 0) {
+        compressed_size = compressBound(entry->size);
+        compressed_data = MALLOC(compressed_size);
+
+        // Files that don't benefit from compression are stored as is.
+        if (compress2((Bytef*)compressed_data, &compressed_size, (const Bytef*)entry->data, entry->size, Z_BEST_SPEED) == Z_OK
+            && compressed_size < (uLongf)entry->size) {
+            success = tig_file_archive_write_record(job, 4, entry, compressed_data, (int)compressed_size);
+            FREE(compressed_data);
+            return success;
+        }
+
+        FREE(compressed_data);
+    }
+
+    return tig_file_archive_write_record(job, entry->type, entry, entry->data, entry->size);
+}
+
+/**
+ * Writes index record and associated data.
+ *
+ * Index records are:
+ *  - 0: file - name length, name, size (`size` bytes of data in the data file)
+ *  - 1: enter directory - name length, name
+ *  - 2: leave directory
+ *  - 3: end of archive
+ *  - 4: compressed file - name length, name, size, compressed size
+ *    (`compressed size` bytes of zlib stream in the data file)
+ */
+bool tig_file_archive_write_record(TigFileArchiveJob* job, int type, TigFileArchiveEntry* entry, void* data, int size)
+{
+    int length;
+
+    if (tig_file_fwrite(&type, sizeof(type), 1, job->index_stream) != 1) {
+        return false;
+    }
+
+    if (type == 2) {
+        return true;
+    }
+
+    length = (int)strlen(entry->name);
+    if (tig_file_fwrite(&length, sizeof(length), 1, job->index_stream) != 1) {
+        return false;
+    }
+
+    if (tig_file_fputs(entry->name, job->index_stream) < 0) {
+        return false;
+    }
+
+    if (type == 1) {
+        return true;
+    }
+
+    if (tig_file_fwrite(&(entry->size), sizeof(entry->size), 1, job->index_stream) != 1) {
+        return false;
+    }
+
+    if (type == 4) {
+        if (tig_file_fwrite(&size, sizeof(size), 1, job->index_stream) != 1) {
+            return false;
+        }
+    }
+
+    if (size > 0) {
+        if (tig_file_fwrite(data, size, 1, job->data_stream) != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int SDLCALL tig_file_archive_thread_func(void* userdata)
+{
+    TigFileArchiveJob* job = (TigFileArchiveJob*)userdata;
+
+    job->success = tig_file_archive_write(job);
+    SDL_SetAtomicInt(&(job->done), 1);
+
+    return 0;
+}
+
+bool tig_file_unarchive_compressed(TigFile* dst_stream, TigFile* src_stream, int size, int compressed_size)
+{
+    void* compressed_data;
+    void* data;
+    uLongf data_size;
+    bool success;
+
+    if (size <= 0 || compressed_size <= 0) {
+        return false;
+    }
+
+    compressed_data = MALLOC(compressed_size);
+    data = MALLOC(size);
+    data_size = size;
+
+    success = tig_file_fread(compressed_data, compressed_size, 1, src_stream) == 1
+        && uncompress((Bytef*)data, &data_size, (const Bytef*)compressed_data, compressed_size) == Z_OK
+        && data_size == (uLongf)size
+        && tig_file_fwrite(data, size, 1, dst_stream) == 1;
+
+    FREE(data);
+    FREE(compressed_data);
+
+    return success;
+}
+
+bool tig_file_index_key(const char* path, char* key, unsigned int* hash_ptr)
+{
+    unsigned int hash;
+    size_t length;
+    size_t index;
+
+    // Absolute paths bypass repositories, patterns can match anything.
+    if (path[0] == '\0'
+        || path[0] == '.' || path[0] == '\\' || path[0] == '/' || path[1] == ':'
+        || strpbrk(path, "*?") != NULL) {
+        return false;
+    }
+
+    length = strlen(path);
+    if (length >= TIG_MAX_PATH) {
+        return false;
+    }
+
+    // Lowercase with unified separators, trailing separator names the same
+    // directory.
+    for (index = 0; index < length; index++) {
+        key[index] = path[index] == '\\' ? '/' : (char)SDL_tolower((unsigned char)path[index]);
+    }
+    while (length > 1 && key[length - 1] == '/') {
+        length--;
+    }
+    key[length] = '\0';
+
+    // FNV-1a
+    hash = 2166136261u;
+    for (index = 0; index < length; index++) {
+        hash ^= (unsigned char)key[index];
+        hash *= 16777619u;
+    }
+
+    *hash_ptr = hash;
+
+    return true;
+}
+
+TigFileIndexEntry* tig_file_index_find(const char* path)
+{
+    char key[TIG_MAX_PATH];
+    unsigned int hash;
+    int mask;
+    int index;
+    TigFileIndexEntry* entry;
+
+    if (!tig_file_index_key(path, key, &hash)) {
+        return NULL;
+    }
+
+    if (tig_file_index_size >= TIG_FILE_INDEX_MAX_SIZE) {
+        tig_file_index_flush();
+    }
+
+    if ((tig_file_index_size + 1) * 4 > tig_file_index_capacity * 3) {
+        tig_file_index_grow();
+    }
+
+    mask = tig_file_index_capacity - 1;
+    index = hash & mask;
+    while (tig_file_index_entries[index].path != NULL) {
+        entry = &(tig_file_index_entries[index]);
+        if (entry->hash == hash && strcmp(entry->path, key) == 0) {
+            return entry;
+        }
+        index = (index + 1) & mask;
+    }
+
+    entry = &(tig_file_index_entries[index]);
+    entry->path = STRDUP(key);
+    entry->hash = hash;
+    entry->open_known = false;
+    entry->open_repo = NULL;
+    entry->exists_known = false;
+    entry->exists_repo = NULL;
+    tig_file_index_size++;
+
+    return entry;
+}
+
+void tig_file_index_invalidate(const char* path)
+{
+    char key[TIG_MAX_PATH];
+    unsigned int hash;
+    int mask;
+    int index;
+    TigFileIndexEntry* entry;
+
+    if (tig_file_index_size == 0) {
+        return;
+    }
+
+    if (!tig_file_index_key(path, key, &hash)) {
+        // Absolute path can point into any of the directory repositories.
+        tig_file_index_flush();
+        return;
+    }
+
+    mask = tig_file_index_capacity - 1;
+    index = hash & mask;
+    while (tig_file_index_entries[index].path != NULL) {
+        entry = &(tig_file_index_entries[index]);
+        if (entry->hash == hash && strcmp(entry->path, key) == 0) {
+            entry->open_known = false;
+            entry->exists_known = false;
+            tig_file_index_stats_data.invalidations++;
+            break;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void tig_file_index_flush()
+{
+    int index;
+
+    if (tig_file_index_size == 0) {
+        return;
+    }
+
+    for (index = 0; index < tig_file_index_capacity; index++) {
+        if (tig_file_index_entries[index].path != NULL) {
+            FREE(tig_file_index_entries[index].path);
+        }
+    }
+
+    memset(tig_file_index_entries, 0, sizeof(*tig_file_index_entries) * tig_file_index_capacity);
+    tig_file_index_size = 0;
+    tig_file_index_stats_data.flushes++;
+}
+
+void tig_file_index_grow()
+{
+    TigFileIndexEntry* entries;
+    int capacity;
+    int mask;
+    int index;
+    int new_index;
+
+    entries = tig_file_index_entries;
+    capacity = tig_file_index_capacity;
+
+    tig_file_index_capacity = capacity != 0 ? capacity * 2 : TIG_FILE_INDEX_MIN_CAPACITY;
+    tig_file_index_entries = (TigFileIndexEntry*)CALLOC(tig_file_index_capacity, sizeof(*tig_file_index_entries));
+
+    mask = tig_file_index_capacity - 1;
+    for (index = 0; index < capacity; index++) {
+        if (entries[index].path != NULL) {
+            new_index = entries[index].hash & mask;
+            while (tig_file_index_entries[new_index].path != NULL) {
+                new_index = (new_index + 1) & mask;
+            }
+            tig_file_index_entries[new_index] = entries[index];
+        }
+    }
+
+    if (entries != NULL) {
+        FREE(entries);
+    }
+}
+
+void tig_file_index_stats(TigFileIndexStats* stats)
+{
+    *stats = tig_file_index_stats_data;
+}
+
+void tig_file_index_reset_stats()
+{
+    memset(&tig_file_index_stats_data, 0, sizeof(tig_file_index_stats_data));
+}
+
+bool tig_file_read_batch(TigFileBatchEntry* entries, int count)
+{
+    TigFile** streams;
+    TigDatabaseFileHandle** database_streams;
+    void** buffers;
+    bool success = true;
+    int index;
+
+    streams = (TigFile**)MALLOC(sizeof(*streams) * count);
+    database_streams = (TigDatabaseFileHandle**)MALLOC(sizeof(*database_streams) * count);
+    buffers = (void**)MALLOC(sizeof(*buffers) * count);
+
+    // Files are opened on the calling thread since repositories are not
+    // thread-safe. Loose files are read right away, archived ones are left
+    // for the batch.
+    for (index = 0; index < count; index++) {
+        entries[index].data = NULL;
+        entries[index].size = 0;
+        database_streams[index] = NULL;
+
+        streams[index] = tig_file_fopen(entries[index].path, "rb");
+        if (streams[index] == NULL) {
+            success = false;
+            continue;
+        }
+
+        entries[index].size = tig_file_filelength(streams[index]);
+
+        if ((streams[index]->flags & TIG_FILE_DATABASE) != 0) {
+            database_streams[index] = streams[index]->impl.database_file_stream;
+        } else {
+            entries[index].data = MALLOC(entries[index].size != 0 ? entries[index].size : 1);
+            if (entries[index].size != 0
+                && tig_file_fread(entries[index].data, entries[index].size, 1, streams[index]) != 1) {
+                FREE(entries[index].data);
+                entries[index].data = NULL;
+                success = false;
+            }
+        }
+    }
+
+    if (!tig_database_read_batch(database_streams, buffers, count)) {
+        success = false;
+    }
+
+    for (index = 0; index < count; index++) {
+        if (database_streams[index] != NULL) {
+            entries[index].data = buffers[index];
+        }
+
+        if (streams[index] != NULL) {
+            tig_file_fclose(streams[index]);
+        }
+    }
+
+    FREE(buffers);
+    FREE(database_streams);
+    FREE(streams);
+
+    return success;
+}
+
+bool tig_file_detach(const char* path, TigFileSource* source)
+{
+    TigFile* stream;
+
+    source->plain_stream = NULL;
+    source->database = NULL;
+    source->entry = NULL;
+
+    stream = tig_file_fopen(path, "rb");
+    if (stream == NULL) {
+        return false;
+    }
+
+    if ((stream->flags & TIG_FILE_DATABASE) != 0) {
+        tig_database_file_entry(stream->impl.database_file_stream, &(source->database), &(source->entry));
+    } else if ((stream->flags & TIG_FILE_PLAIN) != 0) {
+        // Take over the underlying `FILE`, stdio streams are safe to use from
+        // any thread.
+        source->plain_stream = stream->impl.plain_file_stream;
+        stream->impl.plain_file_stream = NULL;
+        stream->flags &= ~TIG_FILE_PLAIN;
+    }
+
+    tig_file_fclose(stream);
+
+    return source->plain_stream != NULL || source->entry != NULL;
+}
+
+bool tig_file_read_detached(TigFileSource* source, void** data_ptr, size_t* size_ptr)
+{
+    long size = 0;
+    void* data;
+
+    if (source->entry != NULL) {
+        if (!tig_database_read_detached(source->database, source->entry, data_ptr)) {
+            return false;
+        }
+
+        *size_ptr = source->entry->size;
+        source->database = NULL;
+        source->entry = NULL;
+
+        return true;
+    }
+
+    if (source->plain_stream == NULL) {
+        return false;
+    }
+
+    data = NULL;
+    if (fseek(source->plain_stream, 0, SEEK_END) == 0
+        && (size = ftell(source->plain_stream)) >= 0
+        && fseek(source->plain_stream, 0, SEEK_SET) == 0) {
+        // Allocate at least one byte so that empty files are still
+        // distinguished from missing ones.
+        data = MALLOC(size != 0 ? size : 1);
+        if (size != 0 && fread(data, size, 1, source->plain_stream) != 1) {
+            FREE(data);
+            data = NULL;
+        }
+    }
+
+    tig_file_source_release(source);
+
+    if (data == NULL) {
+        return false;
+    }
+
+    *data_ptr = data;
+    *size_ptr = (size_t)size;
+
+    return true;
+}
+
+void tig_file_source_release(TigFileSource* source)
+{
+    if (source->plain_stream != NULL) {
+        fclose(source->plain_stream);
+        source->plain_stream = NULL;
+    }
+
+    source->database = NULL;
+    source->entry = NULL;
+}
@@ -39,11 +39,27 @@ typedef struct TigFadeState {
     SDL_Color color;
 } TigFadeState;
 
+// Max number of separate areas of the main surface tracked between flips.
+// When exceeded, the closest areas are merged.
+#define TIG_VIDEO_MAX_DIRTY_RECTS 16
+
+// Areas of the main surface changed since the last flip which should be
+// uploaded to the texture.
+typedef struct TigVideoDirtyState {
+    bool full;
+    int count;
+    TigRect rects[TIG_VIDEO_MAX_DIRTY_RECTS];
+} TigVideoDirtyState;
+
 static bool tig_video_window_create(TigInitInfo* init_info);
 static void tig_video_window_destroy();
 static bool sub_524830();
 static int tig_video_screenshot_make_internal(int key);
 static int tig_video_buffer_data_to_bmp(SDL_Surface* surface, TigRect* rect, const char* file_name);
+static void tig_video_invalidate_all();
+static void tig_video_invalidate_rect(const TigRect* rect);
+static int tig_video_rect_area(const TigRect* rect);
+static void tig_video_upload_rect(const TigRect* rect);
 
 // 0x5BF3D8
 static int tig_video_screenshot_key = -1;
@@ -80,6 +96,10 @@ static int dword_6103A4;
 
 static TigFadeState tig_fade_state;
 
+static TigVideoDirtyState tig_video_dirty_state;
+
+static TigVideoUploadStats tig_video_upload_stats_data;
+
 // 0x51F330
 int tig_video_init(TigInitInfo* init_info)
 {
@@ -202,6 +222,8 @@ int tig_video_blit(TigVideoBuffer* src_video_buffer, TigRect* src_rect, TigRect*
         tig_video_state.surface,
         &native_dst_rect);
 
+    tig_video_invalidate_rect(&clamped_dst_rect);
+
     return TIG_OK;
 }
 
@@ -232,13 +254,33 @@ int tig_video_fill(const TigRect* rect, tig_color_t color)
         return TIG_ERR_GENERIC;
     }
 
+    tig_video_invalidate_rect(&clamped_rect);
+
     return TIG_OK;
 }
 
 // 0x51F8F0
 int tig_video_flip()
 {
-    SDL_UpdateTexture(tig_video_state.texture, NULL, tig_video_state.surface->pixels, tig_video_state.surface->pitch);
+    int index;
+
+    // Only upload areas of the main surface which were changed by
+    // `tig_video_blit` or `tig_video_fill` since the last flip. Fades do not
+    // touch the surface (see `tig_video_fade`), so they cost nothing here.
+    tig_video_upload_stats_data.frames++;
+    tig_video_upload_stats_data.last_frame_bytes = 0;
+
+    if (tig_video_dirty_state.full) {
+        tig_video_upload_rect(&stru_610388);
+        tig_video_upload_stats_data.full_uploads++;
+    } else {
+        for (index = 0; index < tig_video_dirty_state.count; index++) {
+            tig_video_upload_rect(&(tig_video_dirty_state.rects[index]));
+        }
+    }
+
+    tig_video_dirty_state.full = false;
+    tig_video_dirty_state.count = 0;
 
     SDL_RenderClear(tig_video_state.renderer);
     SDL_RenderTexture(tig_video_state.renderer, tig_video_state.texture, NULL, NULL);
@@ -442,6 +484,7 @@ int tig_video_set_gamma(float gamma)
     }
 
     tig_video_gamma = gamma;
+    tig_video_invalidate_all();
     tig_video_fade(0, 0, 0.0, 1);
 
     return TIG_OK;
@@ -1196,6 +1239,9 @@ bool tig_video_window_create(TigInitInfo* init_info)
     stru_610388.width = init_info->width;
     stru_610388.height = init_info->height;
 
+    // Texture contents are undefined until the first upload.
+    tig_video_invalidate_all();
+
     return true;
 }
 
@@ -1329,3 +1375,100 @@ int tig_video_buffer_data_to_bmp(SDL_Surface* surface, TigRect* rect, const char
 
     return rc;
 }
+
+void tig_video_upload_stats(TigVideoUploadStats* stats)
+{
+    *stats = tig_video_upload_stats_data;
+}
+
+void tig_video_upload_reset_stats()
+{
+    memset(&tig_video_upload_stats_data, 0, sizeof(tig_video_upload_stats_data));
+}
+
+// Marks entire main surface for upload on the next flip.
+void tig_video_invalidate_all()
+{
+    tig_video_dirty_state.full = true;
+    tig_video_dirty_state.count = 0;
+}
+
+// Marks area of the main surface (already clamped to the screen) for upload on
+// the next flip. Overlapping areas are coalesced when it does not increase the
+// amount of uploaded pixels.
+void tig_video_invalidate_rect(const TigRect* rect)
+{
+    TigRect dirty_rect;
+    TigRect union_rect;
+    int index;
+    int best_index;
+    int best_growth;
+    int growth;
+
+    if (tig_video_dirty_state.full || rect->width <= 0 || rect->height <= 0) {
+        return;
+    }
+
+    dirty_rect = *rect;
+
+    index = 0;
+    while (index < tig_video_dirty_state.count) {
+        tig_rect_union(&(tig_video_dirty_state.rects[index]), &dirty_rect, &union_rect);
+        if (tig_video_rect_area(&union_rect) <= tig_video_rect_area(&(tig_video_dirty_state.rects[index])) + tig_video_rect_area(&dirty_rect)) {
+            // Absorb existing rect and start over since the grown rect might
+            // now be mergeable with rects which were already checked.
+            dirty_rect = union_rect;
+            tig_video_dirty_state.rects[index] = tig_video_dirty_state.rects[--tig_video_dirty_state.count];
+            index = 0;
+        } else {
+            index++;
+        }
+    }
+
+    if (tig_video_dirty_state.count == TIG_VIDEO_MAX_DIRTY_RECTS) {
+        // Out of slots, merge with the rect which grows the least.
+        best_index = 0;
+        best_growth = INT_MAX;
+        for (index = 0; index < tig_video_dirty_state.count; index++) {
+            tig_rect_union(&(tig_video_dirty_state.rects[index]), &dirty_rect, &union_rect);
+            growth = tig_video_rect_area(&union_rect) - tig_video_rect_area(&(tig_video_dirty_state.rects[index]));
+            if (growth < best_growth) {
+                best_growth = growth;
+                best_index = index;
+            }
+        }
+
+        tig_rect_union(&(tig_video_dirty_state.rects[best_index]), &dirty_rect, &(tig_video_dirty_state.rects[best_index]));
+        return;
+    }
+
+    tig_video_dirty_state.rects[tig_video_dirty_state.count++] = dirty_rect;
+}
+
+int tig_video_rect_area(const TigRect* rect)
+{
+    return rect->width * rect->height;
+}
+
+void tig_video_upload_rect(const TigRect* rect)
+{
+    SDL_Rect native_rect;
+    int bytes_per_pixel;
+    const uint8_t* pixels;
+
+    native_rect.x = rect->x;
+    native_rect.y = rect->y;
+    native_rect.w = rect->width;
+    native_rect.h = rect->height;
+
+    bytes_per_pixel = SDL_BYTESPERPIXEL(tig_video_state.surface->format);
+    pixels = (const uint8_t*)tig_video_state.surface->pixels
+        + rect->y * tig_video_state.surface->pitch
+        + rect->x * bytes_per_pixel;
+
+    SDL_UpdateTexture(tig_video_state.texture, &native_rect, pixels, tig_video_state.surface->pitch);
+
+    tig_video_upload_stats_data.last_frame_bytes += (uint64_t)rect->width * rect->height * bytes_per_pixel;
+    tig_video_upload_stats_data.total_bytes += (uint64_t)rect->width * rect->height * bytes_per_pixel;
+    tig_video_upload_stats_data.rects++;
+}
@@ -1,5 +1,7 @@
 #include "game/ai.h"
 
+#include <inttypes.h>
+
 #include "game/anim.h"
 #include "game/anim_private.h"
 #include "game/combat.h"
@@ -37,6 +39,20 @@
 
 #define AI_PARAMS_MAX 17
 
+#define AI_LOS_CACHE_SIZE 2048
+
+// Distances (in tiles) to the nearest player which separate AI level of
+// detail tiers. The mid tier ends where heartbeats stop (see
+// `ai_is_near_player`).
+#define AI_LOD_NEAR_DISTANCE 15
+#define AI_LOD_MID_DISTANCE 30
+#define AI_LOD_FAR_DISTANCE 60
+
+#define AI_LOD_DORMANT_MAX_DELAY 20000
+
+#define AI_BENCHMARK_CRITTERS 1000
+#define AI_BENCHMARK_PASSES 4
+
 typedef union AiParams {
     struct {
         /* 0000 */ int field_0; // Percentage of NPC hit points below which NPC will flee.
@@ -79,6 +95,27 @@ typedef struct AiActionRequest {
     /* 0010 */ int64_t obj;
 } AiActionRequest;
 
+// Cached outcome of a line of sight trace. The trace only depends on the
+// observer's location and offsets and on the target location, the result is
+// valid while `epoch` matches `ai_los_cache_epoch`.
+typedef struct AiLosCacheEntry {
+    int64_t source_loc;
+    int64_t target_loc;
+    int offset_x;
+    int offset_y;
+    unsigned int epoch;
+    bool blocked;
+} AiLosCacheEntry;
+
+// A potential target considered by `ai_find_target`. Candidates are ordered by
+// `range`, ties are resolved by `order` (the position in the gathered list),
+// which matches the original stable sort.
+typedef struct AiTargetCandidate {
+    int64_t obj;
+    int64_t range;
+    int order;
+} AiTargetCandidate;
+
 static bool AICheckActionPreconditions(Ai* ai);
 static void ai_context_init(Ai* ai, int64_t obj);
 static bool ai_heal(Ai* ai);
@@ -147,6 +184,17 @@ static void ai_shitlist_add_party(int64_t a1, int64_t a2);
 static void ai_shitlist_add(int64_t npc_obj, int64_t shit_obj);
 static void ai_shitlist_remove(int64_t npc_obj, int64_t shit_obj);
 static int64_t ai_shitlist_get(int64_t obj);
+static int64_t ai_nearest_player_distance(int64_t obj);
+static int ai_timeevent_delay_at_distance(int64_t dist);
+static int ai_lod_delay(int tier, int64_t dist);
+static void ai_lod_schedule(int64_t obj, int millis, int beat);
+static bool ai_los_is_blocked(int64_t source_obj, int64_t target_loc);
+static bool ai_los_obj_can_block(int64_t obj, int type);
+static void ai_target_candidates_reserve(int capacity);
+static bool ai_target_candidate_less(AiTargetCandidate* a, AiTargetCandidate* b);
+static void ai_target_heap_sift_down(AiTargetCandidate* heap, int size, int idx);
+static void ai_target_heap_build(AiTargetCandidate* heap, int size);
+static int64_t ai_target_heap_pop(AiTargetCandidate* heap, int* size_ptr);
 
 #define concealed_to_loudness(concealed) ((concealed) ? LOUDNESS_SILENT : LOUDNESS_NORMAL)
 
@@ -190,6 +238,28 @@ static int64_t ai_npc_wait_here_test_obj;
 // 0x5F84A0
 static int64_t ai_test_obj;
 
+// Set while a mid tier NPC processes a heartbeat in which it should not scan
+// for targets.
+static bool ai_lod_skip_target_scan;
+
+static AiLodStats ai_lod_stats_data;
+
+static AiLosCacheEntry ai_los_cache[AI_LOS_CACHE_SIZE];
+
+// Bumped whenever blocking geometry may have changed. Starts at 1 so that
+// zeroed entries are never valid.
+static unsigned int ai_los_cache_epoch = 1;
+
+static bool ai_los_cache_verify;
+
+static AiLosCacheStats ai_los_cache_stats_data;
+
+// Scratch buffer for `ai_find_target`, which is not reentrant (see
+// `in_find_target`).
+static AiTargetCandidate* ai_target_candidates;
+
+static int ai_target_candidates_capacity;
+
 // 0x4A8320
 bool ai_init(GameInitInfo* init_info)
 {
@@ -236,6 +306,11 @@ bool ai_init(GameInitInfo* init_info)
 // 0x4A83F0
 void ai_exit()
 {
+    if (ai_target_candidates != NULL) {
+        FREE(ai_target_candidates);
+        ai_target_candidates = NULL;
+    }
+    ai_target_candidates_capacity = 0;
 }
 
 // 0x4A8400
@@ -788,6 +863,11 @@ void ai_update_state(Ai* ai)
 
     switch (ai->danger_type) {
     case 0:
+        if (ai_lod_skip_target_scan) {
+            ai_lod_stats_data.skipped_scans++;
+            break;
+        }
+
         danger_source_obj = ai_find_target(ai->obj);
         if (danger_source_obj != OBJ_HANDLE_NULL) {
             ai->danger_source = danger_source_obj;
@@ -1937,8 +2017,7 @@ int64_t ai_find_target(int64_t critter_obj)
     ObjectNode* node;
     int cnt;
     int idx;
-    int64_t handles[50];
-    int64_t ranges[50];
+    int64_t obj;
     int64_t leader_obj;
     int candidate_danger_type;
     int64_t candidate_obj;
@@ -1971,67 +2050,63 @@ int64_t ai_find_target(int64_t critter_obj)
     ai_objects_in_radius(critter_obj, radius, &objects, OBJ_TM_CRITTER);
     node = objects.head;
     while (node != NULL) {
-        if (cnt >= 50) {
-            break;
+        if (cnt == ai_target_candidates_capacity) {
+            ai_target_candidates_reserve(cnt + 1);
         }
 
-        handles[cnt++] = node->obj;
+        ai_target_candidates[cnt].obj = node->obj;
+        ai_target_candidates[cnt].range = 0;
+        ai_target_candidates[cnt].order = cnt;
+        cnt++;
         node = node->next;
     }
     if (cnt != 0) {
         leader_obj = critter_leader_get(critter_obj);
         if (cnt > 1) {
             for (idx = 0; idx < cnt; idx++) {
-                if (ai_check_decoy(critter_obj, handles[idx])) {
-                    ranges[idx] = 0;
+                obj = ai_target_candidates[idx].obj;
+                if (ai_check_decoy(critter_obj, obj)) {
+                    ai_target_candidates[idx].range = 0;
                 } else {
-                    ranges[idx] = object_dist(critter_obj, handles[idx]);
+                    ai_target_candidates[idx].range = object_dist(critter_obj, obj);
                 }
 
-                if (critter_is_unconscious(handles[idx])) {
-                    ranges[idx] += 1000;
+                if (critter_is_unconscious(obj)) {
+                    ai_target_candidates[idx].range += 1000;
                 }
             }
 
-            // NOTE: Original code is different, but looks like it sorts both
-            // range and handle arrays by range using bubble sort algorithm.
-            for (int i = 0; i < cnt - 1; i++) {
-                for (int j = 0; j < cnt - i - 1; j++) {
-                    if (ranges[j] > ranges[j + 1]) {
-                        int64_t tmp_range = ranges[j];
-                        ranges[j] = ranges[j + 1];
-                        ranges[j + 1] = tmp_range;
-
-                        int64_t tmp_handle = handles[j];
-                        handles[j] = handles[j + 1];
-                        handles[j + 1] = tmp_handle;
-                    }
-                }
-            }
+            // NOTE: Original code sorts candidates by range (and was limited
+            // to 50 of them). The scan below usually stops at one of the
+            // nearest candidates, so heapify them and pop in the same order
+            // as needed.
+            ai_target_heap_build(ai_target_candidates, cnt);
         }
 
-        for (idx = 0; idx < cnt; idx++) {
-            concealed = critter_is_concealed(handles[idx]);
-            if (ai_can_hear(critter_obj, handles[idx], concealed_to_loudness(concealed)) == 0
-                || ai_can_see(critter_obj, handles[idx]) == 0) {
-                obj_type = obj_field_int32_get(handles[idx], OBJ_F_TYPE);
+        while (cnt > 0) {
+            obj = ai_target_heap_pop(ai_target_candidates, &cnt);
+
+            concealed = critter_is_concealed(obj);
+            if (ai_can_hear(critter_obj, obj, concealed_to_loudness(concealed)) == 0
+                || ai_can_see(critter_obj, obj) == 0) {
+                obj_type = obj_field_int32_get(obj, OBJ_F_TYPE);
                 if (obj_type == OBJ_TYPE_PC
-                    && critter_is_concealed(handles[idx])) {
-                    v1 = handles[idx];
+                    && critter_is_concealed(obj)) {
+                    v1 = obj;
                 }
 
-                if (ai_check_kos(critter_obj, handles[idx]) != AI_KOS_NO) {
-                    danger_source_obj = handles[idx];
+                if (ai_check_kos(critter_obj, obj) != AI_KOS_NO) {
+                    danger_source_obj = obj;
                     break;
                 }
 
                 if (obj_type == OBJ_TYPE_NPC) {
-                    ai_danger_source(handles[idx], &candidate_danger_type, &candidate_obj);
+                    ai_danger_source(obj, &candidate_danger_type, &candidate_obj);
                     if (AIIsValidShitlistTarget(critter_obj, candidate_obj)
                         && (candidate_danger_type == AI_DANGER_SOURCE_TYPE_COMBAT_FOCUS
                             || candidate_danger_type == AI_DANGER_SOURCE_TYPE_FLEE
                             || candidate_danger_type == AI_DANGER_SOURCE_TYPE_SURRENDER)) {
-                        if (ai_check_protect(critter_obj, handles[idx]) != AI_PROTECT_NO
+                        if (ai_check_protect(critter_obj, obj) != AI_PROTECT_NO
                             || (critter_social_class_get(critter_obj) == SOCIAL_CLASS_GUARD
                                 && critter_is_monstrous(candidate_obj)
                                 && critter_leader_get(candidate_obj) == OBJ_HANDLE_NULL)) {
@@ -2048,7 +2123,7 @@ int64_t ai_find_target(int64_t critter_obj)
                 }
             }
 
-            candidate_obj = ai_check_avenge_dead_ally(critter_obj, handles[idx]);
+            candidate_obj = ai_check_avenge_dead_ally(critter_obj, obj);
             if (candidate_obj != OBJ_HANDLE_NULL) {
                 concealed = critter_is_concealed(candidate_obj);
                 if (ai_can_hear(critter_obj, candidate_obj, concealed_to_loudness(concealed)) == 0
@@ -2892,6 +2967,9 @@ bool ai_timeevent_process(TimeEvent* timeevent)
     bool skip;
     bool v1;
     unsigned int millis;
+    int64_t dist;
+    int tier;
+    int beat;
 
     if (tig_net_is_active()
         && !tig_net_is_host()) {
@@ -2903,6 +2981,11 @@ bool ai_timeevent_process(TimeEvent* timeevent)
         return true;
     }
 
+    dist = ai_nearest_player_distance(obj);
+    tier = ai_lod_tier_get(obj, dist);
+    beat = timeevent->params[2].integer_value + 1;
+    ai_lod_stats_data.heartbeats[tier]++;
+
     skip = false;
     v1 = false;
     if (!critter_is_dead(obj) && timeevent->params[1].integer_value != 0) {
@@ -2936,7 +3019,10 @@ bool ai_timeevent_process(TimeEvent* timeevent)
 
                 return true;
             }
+
+            ai_lod_skip_target_scan = tier == AI_LOD_TIER_MID && (beat & 1) == 0;
             ai_process(obj);
+            ai_lod_skip_target_scan = false;
         }
     } else {
         if (!combat_turn_based_is_active() && !critter_is_dead(obj)) {
@@ -2959,11 +3045,11 @@ bool ai_timeevent_process(TimeEvent* timeevent)
         }
     }
 
-    millis = ai_timeevent_delay(obj);
+    millis = ai_lod_delay(tier, dist);
     if (timeevent->params[1].integer_value != 0) {
         millis += random_between(0, 5000);
     }
-    ai_schedule_process_delay_ms(obj, millis);
+    ai_lod_schedule(obj, millis, beat);
     return true;
 }
 
@@ -3049,31 +3135,17 @@ bool ai_process_follower_catchup(int64_t obj)
 // 0x4AD5D0
 int ai_timeevent_delay(int64_t obj)
 {
-    return 4750 * ai_distance_to_nearest_player(obj) / 30 + 250;
+    return ai_timeevent_delay_at_distance(ai_nearest_player_distance(obj));
 }
 
 // 0x4AD610
 int ai_distance_to_nearest_player(int64_t obj)
 {
-    int64_t pc_obj;
     int64_t dist;
-    int64_t nearest_dist;
 
-    if (tig_net_is_active()) {
-        nearest_dist = -1;
-        pc_obj = multiplayer_player_find_first();
-        while (pc_obj != OBJ_HANDLE_NULL) {
-            dist = object_dist(pc_obj, obj);
-            if (nearest_dist == -1 || dist < nearest_dist) {
-                nearest_dist = dist;
-            }
-            pc_obj = multiplayer_player_find_next();
-        }
-    } else {
-        nearest_dist = object_dist(player_get_local_pc_obj(), obj);
-    }
+    dist = ai_nearest_player_distance(obj);
 
-    return nearest_dist >= 0 && nearest_dist <= 30 ? (int)nearest_dist : 30;
+    return dist <= 30 ? (int)dist : 30;
 }
 
 // 0x4AD6B0
@@ -3111,6 +3183,7 @@ void ai_schedule_process_at_datetime(int64_t obj, DateTime* datetime)
     timeevent.type = TIMEEVENT_TYPE_AI;
     timeevent.params[0].object_value = obj;
     timeevent.params[1].integer_value = 0;
+    timeevent.params[2].integer_value = 0;
     timeevent_add_delay(&timeevent, datetime);
 }
 
@@ -3124,6 +3197,7 @@ void ai_schedule_process_immediate(int64_t obj, int a2)
     timeevent.type = TIMEEVENT_TYPE_AI;
     timeevent.params[0].object_value = obj;
     timeevent.params[1].integer_value = a2;
+    timeevent.params[2].integer_value = 0;
     timeevent_add_immediate(&timeevent);
 }
 
@@ -4083,7 +4157,6 @@ int ai_can_see(int64_t source_obj, int64_t target_obj)
     int64_t dist;
     int extra_dist;
     int64_t target_loc;
-    int64_t block_obj;
 
     if ((obj_field_int32_get(source_obj, OBJ_F_CRITTER_FLAGS) & (OCF_SLEEPING | OCF_BLINDED | OCF_STUNNED)) != 0) {
         return 1000;
@@ -4141,8 +4214,7 @@ int ai_can_see(int64_t source_obj, int64_t target_obj)
     }
 
     target_loc = obj_field_int64_get(target_obj, OBJ_F_LOCATION);
-    FindLineOfSightBlocker(source_obj, target_loc, &block_obj);
-    if (block_obj != OBJ_HANDLE_NULL) {
+    if (ai_los_is_blocked(source_obj, target_loc)) {
         extra_dist++;
     }
 
@@ -4443,3 +4515,423 @@ void ai_target_unlock(int64_t obj)
         }
     }
 }
+
+int ai_lod_tier_get(int64_t obj, int64_t dist)
+{
+    int danger_type;
+    int64_t danger_source_obj;
+
+    if (dist > AI_LOD_FAR_DISTANCE) {
+        // Followers need timely catch-up checks.
+        return critter_pc_leader_get(obj) != OBJ_HANDLE_NULL
+            ? AI_LOD_TIER_FAR
+            : AI_LOD_TIER_DORMANT;
+    }
+
+    if (dist > AI_LOD_MID_DISTANCE) {
+        return AI_LOD_TIER_FAR;
+    }
+
+    if (combat_critter_is_combat_mode_active(obj)) {
+        return AI_LOD_TIER_ACTIVE;
+    }
+
+    ai_danger_source(obj, &danger_type, &danger_source_obj);
+    if (danger_type != AI_DANGER_SOURCE_TYPE_NONE) {
+        return AI_LOD_TIER_ACTIVE;
+    }
+
+    if (dist > AI_LOD_NEAR_DISTANCE) {
+        return AI_LOD_TIER_MID;
+    }
+
+    return AI_LOD_TIER_NEAR;
+}
+
+// Returns distance in tiles to the nearest player, or `INT64_MAX` if there is
+// none on the map.
+int64_t ai_nearest_player_distance(int64_t obj)
+{
+    int64_t pc_obj;
+    int64_t dist;
+    int64_t nearest_dist;
+
+    if (tig_net_is_active()) {
+        nearest_dist = INT64_MAX;
+        pc_obj = multiplayer_player_find_first();
+        while (pc_obj != OBJ_HANDLE_NULL) {
+            dist = object_dist(pc_obj, obj);
+            if (dist >= 0 && dist < nearest_dist) {
+                nearest_dist = dist;
+            }
+            pc_obj = multiplayer_player_find_next();
+        }
+        return nearest_dist;
+    }
+
+    dist = object_dist(player_get_local_pc_obj(), obj);
+    return dist >= 0 ? dist : INT64_MAX;
+}
+
+int ai_timeevent_delay_at_distance(int64_t dist)
+{
+    return 4750 * (int)(dist <= 30 ? dist : 30) / 30 + 250;
+}
+
+int ai_lod_delay(int tier, int64_t dist)
+{
+    int64_t delay;
+
+    if (tier != AI_LOD_TIER_DORMANT) {
+        return ai_timeevent_delay_at_distance(dist);
+    }
+
+    // Far tier NPCs are checked every 5 seconds. Past the far distance add
+    // 100 ms per tile, which keeps the next check ahead of a player running
+    // towards the NPC.
+    //
+    // Clamp before scaling, the distance is `INT64_MAX` when there is no
+    // player on the map.
+    if (dist >= AI_LOD_FAR_DISTANCE + AI_LOD_DORMANT_MAX_DELAY / 100) {
+        return AI_LOD_DORMANT_MAX_DELAY;
+    }
+
+    delay = ai_timeevent_delay_at_distance(dist) + (dist - AI_LOD_FAR_DISTANCE) * 100;
+    if (delay > AI_LOD_DORMANT_MAX_DELAY) {
+        delay = AI_LOD_DORMANT_MAX_DELAY;
+    }
+
+    return (int)delay;
+}
+
+void ai_lod_schedule(int64_t obj, int millis, int beat)
+{
+    DateTime datetime;
+    TimeEvent timeevent;
+
+    ai_timeevent_clear(obj);
+
+    DateTimeAddMilliseconds(&datetime, millis);
+
+    timeevent.type = TIMEEVENT_TYPE_AI;
+    timeevent.params[0].object_value = obj;
+    timeevent.params[1].integer_value = 0;
+    timeevent.params[2].integer_value = beat;
+    timeevent_add_delay(&timeevent, &datetime);
+}
+
+void ai_lod_stats(AiLodStats* stats)
+{
+    *stats = ai_lod_stats_data;
+}
+
+void ai_lod_reset_stats()
+{
+    memset(&ai_lod_stats_data, 0, sizeof(ai_lod_stats_data));
+}
+
+bool ai_los_is_blocked(int64_t source_obj, int64_t target_loc)
+{
+    int64_t source_loc;
+    int offset_x;
+    int offset_y;
+    uint64_t hash;
+    AiLosCacheEntry* entry;
+    int64_t block_obj;
+
+    source_loc = obj_field_int64_get(source_obj, OBJ_F_LOCATION);
+    offset_x = obj_field_int32_get(source_obj, OBJ_F_OFFSET_X);
+    offset_y = obj_field_int32_get(source_obj, OBJ_F_OFFSET_Y);
+
+    hash = (uint64_t)source_loc * 0x9E3779B97F4A7C15ULL;
+    hash ^= (uint64_t)target_loc + 0x7F4A7C15ULL + (hash << 6) + (hash >> 2);
+    hash ^= (uint64_t)(uint32_t)((offset_x << 16) ^ offset_y) * 0xC2B2AE3D27D4EB4FULL;
+    hash ^= hash >> 29;
+
+    entry = &(ai_los_cache[hash & (AI_LOS_CACHE_SIZE - 1)]);
+    if (entry->epoch == ai_los_cache_epoch
+        && entry->source_loc == source_loc
+        && entry->target_loc == target_loc
+        && entry->offset_x == offset_x
+        && entry->offset_y == offset_y) {
+        ai_los_cache_stats_data.hits++;
+
+        if (ai_los_cache_verify) {
+            FindLineOfSightBlocker(source_obj, target_loc, &block_obj);
+            if ((block_obj != OBJ_HANDLE_NULL) != entry->blocked) {
+                ai_los_cache_stats_data.mismatches++;
+                tig_debug_printf("AI: LOS cache mismatch: [%" PRIi64 " x, %" PRIi64 " y] -> [%" PRIi64 " x, %" PRIi64 " y], cached %d, traced %d\n",
+                    location_get_x(source_loc),
+                    location_get_y(source_loc),
+                    location_get_x(target_loc),
+                    location_get_y(target_loc),
+                    entry->blocked,
+                    block_obj != OBJ_HANDLE_NULL);
+                entry->blocked = block_obj != OBJ_HANDLE_NULL;
+            }
+        }
+
+        return entry->blocked;
+    }
+
+    ai_los_cache_stats_data.misses++;
+
+    FindLineOfSightBlocker(source_obj, target_loc, &block_obj);
+
+    entry->source_loc = source_loc;
+    entry->target_loc = target_loc;
+    entry->offset_x = offset_x;
+    entry->offset_y = offset_y;
+    entry->epoch = ai_los_cache_epoch;
+    entry->blocked = block_obj != OBJ_HANDLE_NULL;
+
+    return entry->blocked;
+}
+
+bool ai_los_obj_can_block(int64_t obj, int type)
+{
+    switch (type) {
+    case OBJ_TYPE_WALL:
+    case OBJ_TYPE_PORTAL:
+    case OBJ_TYPE_CONTAINER:
+    case OBJ_TYPE_SCENERY:
+    case OBJ_TYPE_TRAP:
+        return true;
+    }
+
+    // `FindLineOfSightBlocker` traces with 0x04, so critters are only picked
+    // up by the shoot-through check. Critters are normally shoot-through and
+    // never block, their moves do not need to invalidate the cache.
+    if (obj_type_is_critter(type)) {
+        return (obj_field_int32_get(obj, OBJ_F_FLAGS) & OF_SHOOT_THROUGH) == 0;
+    }
+
+    return false;
+}
+
+void ai_los_cache_invalidate()
+{
+    ai_los_cache_stats_data.invalidations++;
+
+    ai_los_cache_epoch++;
+    if (ai_los_cache_epoch == 0) {
+        memset(ai_los_cache, 0, sizeof(ai_los_cache));
+        ai_los_cache_epoch = 1;
+    }
+}
+
+void ai_los_cache_object_changed(int64_t obj, int type)
+{
+    if (ai_los_obj_can_block(obj, type)) {
+        ai_los_cache_invalidate();
+    }
+}
+
+void ai_los_cache_field_changed(int64_t obj, int fld, int old_value, int new_value)
+{
+    int type;
+
+    switch (fld) {
+    case OBJ_F_FLAGS:
+    case OBJ_F_SPELL_FLAGS:
+    case OBJ_F_CURRENT_AID:
+    case OBJ_F_HP_DAMAGE:
+        break;
+    default:
+        return;
+    }
+
+    if (obj_is_proto(obj)) {
+        return;
+    }
+
+    type = obj_field_int32_get(obj, OBJ_F_TYPE);
+    switch (fld) {
+    case OBJ_F_FLAGS:
+        // Items are never looked at by the trace, other objects are checked
+        // for these flags regardless of their type.
+        if (((old_value ^ new_value) & (OF_OFF | OF_DESTROYED | OF_NO_BLOCK | OF_SEE_THROUGH | OF_SHOOT_THROUGH)) == 0
+            || obj_type_is_item(type)) {
+            return;
+        }
+        break;
+    case OBJ_F_SPELL_FLAGS:
+        // Passwalled walls do not block.
+        if (((old_value ^ new_value) & OSF_PASSWALLED) == 0
+            || type != OBJ_TYPE_WALL) {
+            return;
+        }
+        break;
+    case OBJ_F_CURRENT_AID:
+        // Wall art decides which side blocks, portal art tells if it is open
+        // or busted. Critters change art every frame, ignore them.
+        if (type != OBJ_TYPE_WALL && type != OBJ_TYPE_PORTAL) {
+            return;
+        }
+        break;
+    case OBJ_F_HP_DAMAGE:
+        // Dying stops a critter from blocking, which only matters for
+        // critters that are not shoot-through (see `ai_los_obj_can_block`).
+        if (!obj_type_is_critter(type)
+            || !ai_los_obj_can_block(obj, type)) {
+            return;
+        }
+        break;
+    }
+
+    ai_los_cache_invalidate();
+}
+
+void ai_los_cache_verify_enable()
+{
+    ai_los_cache_verify = true;
+}
+
+void ai_los_cache_stats(AiLosCacheStats* stats)
+{
+    *stats = ai_los_cache_stats_data;
+}
+
+void ai_los_cache_reset_stats()
+{
+    ai_los_cache_stats_data.hits = 0;
+    ai_los_cache_stats_data.misses = 0;
+    ai_los_cache_stats_data.invalidations = 0;
+    ai_los_cache_stats_data.mismatches = 0;
+}
+
+void ai_benchmark()
+{
+    int64_t pc_obj;
+    int64_t proto_obj;
+    int64_t origin;
+    int64_t origin_x;
+    int64_t origin_y;
+    int64_t* critters;
+    int num_critters;
+    tig_timestamp_t timestamp;
+    tig_duration_t elapsed;
+    int pass;
+    int idx;
+    int found;
+
+    pc_obj = player_get_local_pc_obj();
+    if (pc_obj == OBJ_HANDLE_NULL) {
+        return;
+    }
+
+    proto_obj = sub_468570(OBJ_TYPE_NPC);
+    if (proto_obj == OBJ_HANDLE_NULL) {
+        return;
+    }
+
+    // Spread critters over the player's sector, every fourth row is used so
+    // that they do not completely block each other's line of sight.
+    origin = sector_loc_from_id(sector_id_from_loc(obj_field_int64_get(pc_obj, OBJ_F_LOCATION)));
+    origin_x = LOCATION_GET_X(origin);
+    origin_y = LOCATION_GET_Y(origin);
+
+    critters = (int64_t*)MALLOC(sizeof(*critters) * AI_BENCHMARK_CRITTERS);
+    num_critters = 0;
+
+    for (idx = 0; idx < AI_BENCHMARK_CRITTERS; idx++) {
+        if (object_create(proto_obj,
+                location_make(origin_x + idx % 64, origin_y + idx / 64 * 4),
+                &(critters[num_critters]))) {
+            num_critters++;
+        }
+    }
+
+    found = 0;
+
+    tig_timer_now(&timestamp);
+
+    for (pass = 0; pass < AI_BENCHMARK_PASSES; pass++) {
+        for (idx = 0; idx < num_critters; idx++) {
+            if (ai_find_target(critters[idx]) != OBJ_HANDLE_NULL) {
+                found++;
+            }
+        }
+    }
+
+    elapsed = tig_timer_elapsed(timestamp);
+
+    tig_debug_printf("AI benchmark: %d critters, %d passes, %d targets found, %d ms\n",
+        num_critters,
+        AI_BENCHMARK_PASSES,
+        found,
+        elapsed);
+
+    for (idx = 0; idx < num_critters; idx++) {
+        object_destroy(critters[idx]);
+    }
+
+    FREE(critters);
+}
+
+void ai_target_candidates_reserve(int capacity)
+{
+    int new_capacity;
+
+    if (capacity <= ai_target_candidates_capacity) {
+        return;
+    }
+
+    new_capacity = ai_target_candidates_capacity != 0 ? ai_target_candidates_capacity : 64;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
+
+    ai_target_candidates = (AiTargetCandidate*)REALLOC(ai_target_candidates, sizeof(*ai_target_candidates) * new_capacity);
+    ai_target_candidates_capacity = new_capacity;
+}
+
+bool ai_target_candidate_less(AiTargetCandidate* a, AiTargetCandidate* b)
+{
+    if (a->range != b->range) {
+        return a->range < b->range;
+    }
+
+    return a->order < b->order;
+}
+
+void ai_target_heap_sift_down(AiTargetCandidate* heap, int size, int idx)
+{
+    AiTargetCandidate tmp;
+    int child;
+
+    while ((child = idx * 2 + 1) < size) {
+        if (child + 1 < size && ai_target_candidate_less(&(heap[child + 1]), &(heap[child]))) {
+            child++;
+        }
+
+        if (!ai_target_candidate_less(&(heap[child]), &(heap[idx]))) {
+            break;
+        }
+
+        tmp = heap[idx];
+        heap[idx] = heap[child];
+        heap[child] = tmp;
+        idx = child;
+    }
+}
+
+void ai_target_heap_build(AiTargetCandidate* heap, int size)
+{
+    int idx;
+
+    for (idx = size / 2 - 1; idx >= 0; idx--) {
+        ai_target_heap_sift_down(heap, size, idx);
+    }
+}
+
+int64_t ai_target_heap_pop(AiTargetCandidate* heap, int* size_ptr)
+{
+    int64_t obj;
+
+    obj = heap[0].obj;
+    heap[0] = heap[--(*size_ptr)];
+    ai_target_heap_sift_down(heap, *size_ptr, 0);
+
+    return obj;
+}
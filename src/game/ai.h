@@ -120,6 +120,54 @@ typedef enum AiActionType {
     AI_ACTION_TYPE_USE_SKILL,
 } AiActionType;
 
+// AI level of detail tiers, see `ai_lod_tier_get`.
+typedef enum AiLodTier {
+    // The NPC is in combat or has a danger source, full heartbeat.
+    AI_LOD_TIER_ACTIVE,
+
+    // The NPC is close to a player, full heartbeat.
+    AI_LOD_TIER_NEAR,
+
+    // The NPC is within heartbeat range of a player but likely off screen.
+    // Idle NPCs scan for targets every other heartbeat.
+    AI_LOD_TIER_MID,
+
+    // The NPC is out of heartbeat range, only follower catch-up and sector
+    // checks are performed.
+    AI_LOD_TIER_FAR,
+
+    // Same as far, but the NPC is so far away that its checks are spaced out
+    // further with distance.
+    AI_LOD_TIER_DORMANT,
+
+    AI_LOD_TIER_COUNT,
+} AiLodTier;
+
+// AI level of detail counters, see `ai_lod_stats`.
+typedef struct AiLodStats {
+    // Number of AI time events processed in each tier.
+    unsigned int heartbeats[AI_LOD_TIER_COUNT];
+
+    // Number of target scans skipped by idle NPCs in the mid tier.
+    unsigned int skipped_scans;
+} AiLodStats;
+
+// Line of sight cache counters, see `ai_los_cache_stats`.
+typedef struct AiLosCacheStats {
+    // Number of `ai_can_see` traces served from the cache.
+    unsigned int hits;
+
+    // Number of `ai_can_see` traces which had to be performed.
+    unsigned int misses;
+
+    // Number of times blocking geometry changed and the cache was dropped.
+    unsigned int invalidations;
+
+    // Number of cached results which did not match a fresh trace (only
+    // tracked when cache verification is enabled).
+    unsigned int mismatches;
+} AiLosCacheStats;
+
 bool ai_init(GameInitInfo* init_info);
 void ai_exit();
 bool ai_mod_load();
@@ -171,5 +219,15 @@ bool ai_shitlist_has(int64_t npc_obj, int64_t shit_obj);
 int ai_max_dialog_distance(int64_t obj);
 void ai_target_lock(int64_t obj, int64_t tgt);
 void ai_target_unlock(int64_t obj);
+int ai_lod_tier_get(int64_t obj, int64_t dist);
+void ai_lod_stats(AiLodStats* stats);
+void ai_lod_reset_stats();
+void ai_los_cache_invalidate();
+void ai_los_cache_object_changed(int64_t obj, int type);
+void ai_los_cache_field_changed(int64_t obj, int fld, int old_value, int new_value);
+void ai_los_cache_verify_enable();
+void ai_los_cache_stats(AiLosCacheStats* stats);
+void ai_los_cache_reset_stats();
+void ai_benchmark();
 
 #endif /* ARCANUM_GAME_AI_H_ */
@@ -2781,9 +2781,18 @@ bool anim_id_to_run_info(AnimID* anim_id, AnimRunInfo** run_info_ptr)
     ASSERT(run_info_ptr != NULL); // ppRunInfo != NULL
 
     if (anim_id->slot_num != -1) {
-        for (index = 0; index < 216; index++) {
-            if (IsAnimIDMatchForRunInfo(anim_id, &(anim_run_info[index]))) {
-                *run_info_ptr = &(anim_run_info[index]);
+        // Slot ids are stable, so the slot named by the id is almost always
+        // the one we are looking for.
+        if (anim_id->slot_num >= 0
+            && anim_id->slot_num < anim_run_info_capacity
+            && IsAnimIDMatchForRunInfo(anim_id, anim_run_info_get(anim_id->slot_num))) {
+            *run_info_ptr = anim_run_info_get(anim_id->slot_num);
+            return true;
+        }
+
+        for (index = 0; index < anim_run_info_capacity; index++) {
+            if (IsAnimIDMatchForRunInfo(anim_id, anim_run_info_get(index))) {
+                *run_info_ptr = anim_run_info_get(index);
                 return true;
             }
         }
@@ -2881,7 +2890,7 @@ bool anim_save(TigFile* stream)
     if (tig_file_fwrite(&dword_5DE6C4, 4, 1, stream) != 1) return false;
     if (tig_file_fwrite(&dword_5DE6C0, 4, 1, stream) != 1) return false;
 
-    cnt = 216;
+    cnt = anim_run_info_capacity;
     if (tig_file_fwrite(&cnt, 4, 1, stream) != 1) return false;
 
     idx = 0;
@@ -2889,7 +2898,7 @@ bool anim_save(TigFile* stream)
         start = idx;
 
         while (idx < cnt) {
-            if ((anim_run_info[idx].flags & 0x01) == 0) {
+            if ((anim_run_info_get(idx)->flags & 0x01) == 0) {
                 break;
             }
             idx++;
@@ -2902,7 +2911,7 @@ bool anim_save(TigFile* stream)
             }
 
             while (start < idx) {
-                if (!anim_run_info_save(&(anim_run_info[start]), stream)) {
+                if (!anim_run_info_save(anim_run_info_get(start), stream)) {
                     return false;
                 }
                 start++;
@@ -2910,7 +2919,7 @@ bool anim_save(TigFile* stream)
         }
 
         while (idx < cnt) {
-            if ((anim_run_info[idx].flags & 0x01) != 0) {
+            if ((anim_run_info_get(idx)->flags & 0x01) != 0) {
                 break;
             }
             idx++;
@@ -3079,6 +3088,12 @@ bool anim_load_internal(GameLoadInfo* load_info)
     if (tig_file_fread(&dword_5DE6C0, 4, 1, load_info->stream) != 1) return false;
     if (tig_file_fread(&cnt, 4, 1, load_info->stream) != 1) return false;
 
+    // Saves made with a grown slot pool need the same number of slots.
+    if (!anim_run_info_reserve(cnt)) {
+        tig_debug_printf("Anim: anim_load: ERROR: Could not reserve %d run slots!\n", cnt);
+        return false;
+    }
+
     idx = 0;
     while (idx < cnt) {
         if (tig_file_fread(&extent_size, sizeof(extent_size), 1, load_info->stream) != 1) {
@@ -3087,7 +3102,7 @@ bool anim_load_internal(GameLoadInfo* load_info)
 
         if (extent_size > 0) {
             while (extent_size > 0) {
-                if (!anim_run_info_load(&(anim_run_info[idx]), load_info->stream)) {
+                if (!anim_run_info_load(anim_run_info_get(idx), load_info->stream)) {
                     return false;
                 }
                 idx++;
@@ -3098,6 +3113,8 @@ bool anim_load_internal(GameLoadInfo* load_info)
         }
     }
 
+    anim_run_info_index_rebuild();
+
     return true;
 }
 
@@ -3255,8 +3272,8 @@ void anim_break_nodes_to_map(const char* map)
         }
     }
 
-    for (idx = 0; idx < 216; idx++) {
-        run_info = &(anim_run_info[idx]);
+    for (idx = 0; idx < anim_run_info_capacity; idx++) {
+        run_info = anim_run_info_get(idx);
         if ((run_info->flags & 0x1) != 0) {
             if (!teleport_is_teleporting_obj(run_info->anim_obj)
                 || !anim_goal_nodes[run_info->goals[0].type]->field_C) {
@@ -3271,7 +3288,7 @@ void anim_break_nodes_to_map(const char* map)
         }
     }
 
-    if (idx < 216) {
+    if (idx < anim_run_info_capacity) {
         tig_debug_printf("Anim: anim_break_nodes_to_map: ERROR: Failed to save out nodes!\n");
         ASSERT(0); // 1089, "0"
         tig_file_fclose(stream);
@@ -3353,8 +3370,8 @@ void anim_save_nodes_to_map(const char* map)
         }
     }
 
-    for (idx = 0; idx < 216; idx++) {
-        run_info = &(anim_run_info[idx]);
+    for (idx = 0; idx < anim_run_info_capacity; idx++) {
+        run_info = anim_run_info_get(idx);
         if ((run_info->flags & 0x1) != 0) {
             if (!anim_run_info_save(run_info, stream)) {
                 ASSERT(0); // 1199, "0"
@@ -3365,7 +3382,7 @@ void anim_save_nodes_to_map(const char* map)
         }
     }
 
-    if (idx < 216) {
+    if (idx < anim_run_info_capacity) {
         tig_debug_printf("Anim: anim_save_nodes_to_map: ERROR: Failed to save out nodes!\n");
         ASSERT(0); // 1208, "0"
         tig_file_fclose(stream);
@@ -3425,7 +3442,9 @@ void anim_load_nodes_from_map(const char* map)
             break;
         }
 
-        if ((anim_run_info[run_info.id.slot_num].flags & 0x1) != 0) {
+        if (run_info.id.slot_num < 0
+            || !anim_run_info_reserve(run_info.id.slot_num + 1)
+            || (anim_run_info_get(run_info.id.slot_num)->flags & 0x1) != 0) {
             if (!AnimAllocateSlot(&anim_id)) {
                 tig_debug_printf("Anim: anim_load_nodes_from_map: ERROR: Failed to allocate a run slot!\n");
                 ASSERT(0); // 1282, "0"
@@ -3435,9 +3454,10 @@ void anim_load_nodes_from_map(const char* map)
             anim_id = run_info.id;
         }
 
-        anim_run_info[anim_id.slot_num] = run_info;
-        anim_run_info[anim_id.slot_num].id = anim_id;
-        anim_run_info[anim_id.slot_num].cur_stack_data = &(anim_run_info[anim_id.slot_num].goals[anim_run_info[anim_id.slot_num].current_goal]);
+        *anim_run_info_get(anim_id.slot_num) = run_info;
+        anim_run_info_get(anim_id.slot_num)->id = anim_id;
+        anim_run_info_get(anim_id.slot_num)->cur_stack_data = &(anim_run_info_get(anim_id.slot_num)->goals[anim_run_info_get(anim_id.slot_num)->current_goal]);
+        anim_run_info_index_update(anim_id.slot_num);
         anim_goal_restart(&anim_id);
     }
 
@@ -3467,12 +3487,12 @@ bool anim_get_current_id(int64_t obj, AnimID* anim_id)
     while (slot != -1 && slot != prev) {
         prev = slot;
 
-        goal_node = anim_goal_nodes[anim_run_info[slot].goals[0].type];
+        goal_node = anim_goal_nodes[anim_run_info_get(slot)->goals[0].type];
         ASSERT(goal_node != NULL); // 1345, "pGoalNode != NULL"
 
         if (!goal_node->field_8) {
             if (anim_id != NULL) {
-                *anim_id = anim_run_info[slot].id;
+                *anim_id = anim_run_info_get(slot)->id;
             }
             return true;
         }
@@ -3498,7 +3518,7 @@ int anim_get_priority_level(int64_t obj)
     while (slot != -1 && slot != prev) {
         prev = slot;
 
-        goal_node = anim_goal_nodes[anim_run_info[slot].goals[0].type];
+        goal_node = anim_goal_nodes[anim_run_info_get(slot)->goals[0].type];
         ASSERT(goal_node != NULL); // 1383, "pGoalNode != NULL"
 
         if (!goal_node->field_8) {
@@ -3519,7 +3539,7 @@ bool anim_is_running(int64_t obj)
     tig_art_id_t art_id;
 
     index = anim_find_first(obj);
-    run_info = &(anim_run_info[index]);
+    run_info = anim_run_info_get(index);
     if (run_info->current_goal != 0) {
         return false;
     }
@@ -3586,9 +3606,15 @@ bool anim_timeevent_process(TimeEvent* timeevent)
 
     run_index = timeevent->params[0].integer_value;
 
-    ASSERT(run_index < 216); // 1965, "animRunIndex < ANIM_MAX_CURRENT_ANIMS"
+    ASSERT(run_index < anim_run_info_capacity); // 1965, "animRunIndex < ANIM_MAX_CURRENT_ANIMS"
 
-    run_info = &(anim_run_info[run_index]);
+    // Pages beyond the first are released on exit, an event may outlive
+    // them.
+    if (run_index < 0 || run_index >= anim_run_info_capacity) {
+        return true;
+    }
+
+    run_info = anim_run_info_get(run_index);
     if (run_info->id.slot_num != run_index) {
         anim_id_to_str(&(run_info->id), str);
         tig_debug_printf("%s != %d:%d:%d\n",
@@ -3915,8 +3941,8 @@ int anim_goal_pending_active_goals_count()
     int cnt = 0;
     int stack_index;
 
-    for (index = 0; index < 216; index++) {
-        run_info = &(anim_run_info[index]);
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        run_info = anim_run_info_get(index);
         if ((run_info->flags & 0x1) != 0) {
             for (stack_index = 0; stack_index <= run_info->current_goal; stack_index++) {
                 ASSERT(run_info->goals[stack_index].type >= 0); // pRunInfo->goal_stack[j].goal_type >= 0
@@ -3978,7 +4004,7 @@ bool anim_clear_goals(int64_t obj)
     slot = anim_find_first(obj);
     while (slot != -1 && slot != prev) {
         prev = slot;
-        if (!AnimGoalCancel(&(anim_run_info[slot].id))) {
+        if (!AnimGoalCancel(&(anim_run_info_get(slot)->id))) {
             return false;
         }
 
@@ -4032,7 +4058,7 @@ bool anim_set_priority_level(int64_t obj, int priority_level, bool a3, bool a4)
     slot = anim_find_first(obj);
     while (slot != -1 && slot != prev) {
         prev = slot;
-        if (!InterruptAnimation(&(anim_run_info[slot].id), priority_level)) {
+        if (!InterruptAnimation(&(anim_run_info_get(slot)->id), priority_level)) {
             return false;
         }
 
@@ -4048,9 +4074,9 @@ bool anim_goal_interrupt_all_goals()
     int index;
 
     if (g_anim_system_active > 0) {
-        for (index = 0; index < 216; index++) {
-            if ((anim_run_info[index].flags & 0x1) != 0
-                && !InterruptAnimation(&(anim_run_info[index].id), PRIORITY_ABSOLUTE_SYSTEM_INTERRUPT)) {
+        for (index = 0; index < anim_run_info_capacity; index++) {
+            if ((anim_run_info_get(index)->flags & 0x1) != 0
+                && !InterruptAnimation(&(anim_run_info_get(index)->id), PRIORITY_ABSOLUTE_SYSTEM_INTERRUPT)) {
                 return false;
             }
         }
@@ -4066,9 +4092,9 @@ bool anim_goal_interrupt_all_goals_of_priority(int priority_level)
 
     ASSERT(priority_level >= PRIORITY_INACTIVE && priority_level < PRIORITY_ABSOLUTE_SYSTEM_INTERRUPT); // (priorityLevel >= priorityNone)&&(priorityLevel <= priorityHighest)
 
-    for (index = 0; index < 216; index++) {
-        if ((anim_run_info[index].flags & 0x1) != 0
-            && !InterruptAnimation(&(anim_run_info[index].id), priority_level)) {
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        if ((anim_run_info_get(index)->flags & 0x1) != 0
+            && !InterruptAnimation(&(anim_run_info_get(index)->id), priority_level)) {
             tig_debug_printf("Anim: anim_goal_interrupt_all_goals_of_priority: ERROR: Failed to interrupt slot: %d!\n", index);
         }
     }
@@ -4082,8 +4108,8 @@ bool anim_goal_interrupt_all_for_tb_combat()
     int index = 0;
     AnimRunInfo* run_info;
 
-    for (index = 0; index < 216; index++) {
-        run_info = &(anim_run_info[index]);
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        run_info = anim_run_info_get(index);
         if ((run_info->flags & 0x1) != 0
             && !AnimGoalIsPassive(run_info)
             && !InterruptAnimation(&(run_info->id), 3)) {
@@ -4119,7 +4145,7 @@ bool anim_play_eye_candy_on_obj(int64_t obj, tig_art_id_t eye_candy_id, int mt_i
             break;
         }
 
-        run_info = &(anim_run_info[cur_anim_id.slot_num]);
+        run_info = anim_run_info_get(cur_anim_id.slot_num);
 
         ASSERT(run_info->current_goal > -1); // 2839, "pRunInfo->current_goal > -1"
         ASSERT(run_info->current_goal < 14); // 2840, "pRunInfo->current_goal < ANIM_GOAL_MAX_SUBNODES"
@@ -4167,7 +4193,7 @@ bool anim_play_eye_candy_on_obj_ex(int64_t obj, tig_art_id_t eye_candy_id, int m
             break;
         }
 
-        run_info = &(anim_run_info[cur_anim_id.slot_num]);
+        run_info = anim_run_info_get(cur_anim_id.slot_num);
         if (run_info->cur_stack_data == NULL) {
             run_info->cur_stack_data = &(run_info->goals[run_info->current_goal]);
         }
@@ -11525,7 +11551,7 @@ bool AG_UpdateMoveFrame(AnimRunInfo* run_info)
             exit(EXIT_FAILURE);
         }
 
-        v2 = anim_run_info[anim_id.slot_num].cur_stack_data->params[AGDATA_SCRATCH_VAL1].data;
+        v2 = anim_run_info_get(anim_id.slot_num)->cur_stack_data->params[AGDATA_SCRATCH_VAL1].data;
         g_anim_float_offset_y = 15 - 2 * v2;
     }
 
@@ -13354,7 +13380,7 @@ bool anim_goal_animate_loop(int64_t obj)
         return false;
     }
 
-    anim_run_info[g_anim_slot_scratch.slot_num].goals[0].params[AGDATA_SOUND_HANDLE].data = TIG_SOUND_HANDLE_INVALID;
+    anim_run_info_get(g_anim_slot_scratch.slot_num)->goals[0].params[AGDATA_SOUND_HANDLE].data = TIG_SOUND_HANDLE_INVALID;
 
     return true;
 }
@@ -13415,7 +13441,7 @@ bool anim_is_obj_convinced_to_move(int64_t obj, int64_t loc)
         return true;
     }
 
-    run_info = &(anim_run_info[g_anim_slot_scratch.slot_num]);
+    run_info = anim_run_info_get(g_anim_slot_scratch.slot_num);
 
     if (run_info->goals[0].params[AGDATA_TARGET_TILE].loc == loc) {
         return true;
@@ -13508,7 +13534,7 @@ bool anim_goal_move_to(int64_t obj, int64_t loc, bool a3)
     }
 
     if (anim_is_current_goal_type(obj, AG_MOVE_TO_TILE, &g_anim_slot_scratch) || a3) {
-        run_info = &(anim_run_info[g_anim_slot_scratch.slot_num]);
+        run_info = anim_run_info_get(g_anim_slot_scratch.slot_num);
         if (run_info->goals[0].params[AGDATA_TARGET_TILE].loc == loc) {
             return true;
         }
@@ -13583,7 +13609,7 @@ bool anim_goal_run_to(int64_t obj, int64_t loc)
         return true;
     }
 
-    run_info = &(anim_run_info[g_anim_slot_scratch.slot_num]);
+    run_info = anim_run_info_get(g_anim_slot_scratch.slot_num);
     run_info->flags |= 0x40;
 
     // TODO: Looks wrong, checking for 0 immediately after OR'ing 0x40.
@@ -13675,7 +13701,7 @@ bool anim_goal_move_to_combat(int64_t obj, int64_t loc)
         return true;
     }
 
-    run_info = &(anim_run_info[g_anim_slot_scratch.slot_num]);
+    run_info = anim_run_info_get(g_anim_slot_scratch.slot_num);
     run_info->flags |= 0x40;
     if (run_info->goals[0].params[AGDATA_TARGET_TILE].loc != loc) {
         AnimGoalDataInitNoPriority(&goal_data, obj, 3);
@@ -13711,7 +13737,7 @@ bool anim_goal_move_near_loc(int64_t source_obj, int64_t target_loc, int range)
         return false;
     }
 
-    run_info = &(anim_run_info[g_anim_slot_scratch.slot_num]);
+    run_info = anim_run_info_get(g_anim_slot_scratch.slot_num);
 
     if (run_info->goals[0].params[AGDATA_TARGET_TILE].loc == target_loc) {
         return true;
@@ -13786,7 +13812,7 @@ bool anim_goal_move_near_loc_combat(int64_t source_obj, int64_t target_loc, int
         return false;
     }
 
-    run_info = &(anim_run_info[g_anim_slot_scratch.slot_num]);
+    run_info = anim_run_info_get(g_anim_slot_scratch.slot_num);
     if ((run_info->flags & 0x40) == 0
         && critter_encumbrance_level_get(run_info->anim_obj) < ENCUMBRANCE_LEVEL_SIGNIFICANT) {
         run_info->flags |= 0x40;
@@ -13860,7 +13886,7 @@ bool anim_goal_follow_obj(int64_t source_obj, int64_t target_obj)
     }
 
     if (anim_get_current_id(source_obj, &anim_id)) {
-        run_info = &(anim_run_info[anim_id.slot_num]);
+        run_info = anim_run_info_get(anim_id.slot_num);
         if ((run_info->cur_stack_data->params[AGDATA_FLAGS_DATA].data & 0x1000) == 0) {
             if (run_info->cur_stack_data->type != AG_ANIM_FIDGET) {
                 return false;
@@ -13886,7 +13912,7 @@ bool anim_goal_follow_obj(int64_t source_obj, int64_t target_obj)
     }
 
     if (AnimGoalFindExisting(source_obj, &goal_data, &anim_id)) {
-        run_info = &(anim_run_info[anim_id.slot_num]);
+        run_info = anim_run_info_get(anim_id.slot_num);
         switch (run_info->cur_stack_data->type) {
         // NOTE: Not sure why this one was specified explicitly.
         case AG_RUN_NEAR_OBJ:
@@ -14500,7 +14526,7 @@ bool anim_goal_projectile_fire(int64_t proj_obj, int64_t a2, int64_t a3)
         return false;
     }
 
-    run_info = &(anim_run_info[anim_id.slot_num]);
+    run_info = anim_run_info_get(anim_id.slot_num);
     run_info->goals[0].params[AGDATA_TARGET_TILE].loc = a2;
     run_info->goals[0].params[AGDATA_SCRATCH_OBJ].obj = a3;
     run_info->goals[0].params[AGDATA_TARGET_OBJ].obj = run_info->goals[0].params[AGDATA_PARENT_OBJ].obj;
@@ -14942,17 +14968,8 @@ void anim_goal_death(int64_t obj)
                 }
             }
 
-            while (pc_head != NULL) {
-                obj_node = pc_head->next;
-                object_node_destroy(pc_head);
-                pc_head = obj_node;
-            }
-
-            while (npc_head != NULL) {
-                obj_node = npc_head->next;
-                object_node_destroy(npc_head);
-                npc_head = obj_node;
-            }
+            object_node_destroy_list(pc_head);
+            object_node_destroy_list(npc_head);
         }
     }
 
@@ -15048,7 +15065,7 @@ bool anim_goal_attempt_spread_out(int64_t obj, int64_t target_obj)
     goal_data.params[AGDATA_TARGET_OBJ].obj = target_obj;
 
     if (AnimGoalFindExisting(obj, &goal_data, &anim_id)) {
-        run_info = &(anim_run_info[anim_id.slot_num]);
+        run_info = anim_run_info_get(anim_id.slot_num);
 
         // FIXME: Unused.
         obj_field_int32_get(obj, OBJ_F_NPC_FLAGS);
@@ -15237,7 +15254,7 @@ void notify_speed_recalc(AnimID* anim_id)
     }
 
     // FIXME: Should use obtained `run_info`, not lookup from the master table.
-    anim_run_info[anim_id->slot_num].flags |= 0x80;
+    anim_run_info_get(anim_id->slot_num)->flags |= 0x80;
 }
 
 // 0x436FA0
@@ -15264,7 +15281,7 @@ bool anim_can_move(int64_t a1, int64_t a2)
     }
 
     while (index != -1) {
-        run_info = &(anim_run_info[index]);
+        run_info = anim_run_info_get(index);
         goal_index = run_info->current_goal;
         if (goal_index >= 0) {
             // FIXME: Refactor.
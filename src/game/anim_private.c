@@ -12,12 +12,35 @@
 #include "game/timeevent.h"
 #include "game/ui.h"
 
+#define ANIM_OBJ_INDEX_MIN_SIZE 512
+
+// Object-to-slot index entry. `head` is the lowest slot bound to `obj`, or -1
+// when none is (such entries are dropped on the next refill).
+typedef struct AnimObjIndexEntry {
+    int64_t obj;
+    int head;
+} AnimObjIndexEntry;
+
+// Per-slot index state, mirrors `anim_obj` and the in-use flag of the slot as
+// of the last `anim_run_info_index_update`.
+typedef struct AnimSlotIndexNode {
+    int64_t obj;
+    int next;
+    bool used;
+} AnimSlotIndexNode;
+
 static bool anim_allocate_this_run_index(AnimID* anim_id);
 static bool AnimResetSlot(int index);
 static bool IsGlobalTimeEvent(TimeEvent* timeevent);
 static void anim_path_debug(AnimPath* path);
 static void anim_goal_data_debug(AnimGoalData* goal_data);
 static void anim_run_info_debug(AnimRunInfo* run_info);
+static bool anim_run_info_grow();
+static int anim_run_info_slot_of(AnimRunInfo* run_info);
+static bool anim_slot_matches(AnimRunInfo* run_info, int64_t obj);
+static unsigned int anim_obj_index_hash(int64_t obj);
+static AnimObjIndexEntry* anim_obj_index_find(int64_t obj, bool create);
+static void anim_obj_index_refill();
 
 // 0x5A164C
 const char* off_5A164C[] = {
@@ -194,7 +217,7 @@ static bool anim_private_editor;
 int g_anim_save_version;
 
 // 0x687700
-AnimRunInfo anim_run_info[216];
+static AnimRunInfo anim_run_info[ANIM_RUN_INFO_PAGE_SIZE];
 
 // 0x739E40
 int g_anim_unknown_739E40;
@@ -202,6 +225,22 @@ int g_anim_unknown_739E40;
 // 0x739E44
 int g_anim_unknown_739E44;
 
+AnimRunInfo* anim_run_info_pages[ANIM_RUN_INFO_MAX_PAGES] = { anim_run_info };
+
+int anim_run_info_capacity = ANIM_RUN_INFO_PAGE_SIZE;
+
+static AnimSlotIndexNode* anim_slot_index_nodes;
+
+static AnimObjIndexEntry* anim_obj_index;
+
+static int anim_obj_index_size;
+
+static int anim_obj_index_used;
+
+static int anim_slots_in_use;
+
+static AnimSlotStats anim_slot_stats_data;
+
 // 0x44C840
 void AnimRunSetGoalNode(AnimRunInfo* run_info, AnimGoalNode* goal_node)
 {
@@ -262,14 +301,17 @@ bool anim_private_init(GameInitInfo* init_info)
 
     anim_private_editor = init_info->editor;
 
-    for (index = 0; index < 216; index++) {
-        anim_run_info[index].id.slot_num = index;
-        anim_run_info[index].flags = 0;
-        anim_run_info[index].path.flags = 1;
-        anim_run_info[index].path.field_CC = 200;
-        AnimPathReset(&(anim_run_info[index].path));
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        anim_run_info_get(index)->id.slot_num = index;
+        anim_run_info_get(index)->flags = 0;
+        anim_run_info_get(index)->path.flags = 1;
+        anim_run_info_get(index)->path.field_CC = 200;
+        AnimPathReset(&(anim_run_info_get(index)->path));
     }
 
+    anim_slot_index_nodes = (AnimSlotIndexNode*)MALLOC(sizeof(*anim_slot_index_nodes) * anim_run_info_capacity);
+    anim_run_info_index_rebuild();
+
     g_anim_save_version = random_between(0, 10024);
     animNumActiveGoals = 0;
     g_anim_system_active = 0;
@@ -282,11 +324,32 @@ void anim_private_exit()
 {
     int index;
 
-    for (index = 0; index < 216; index++) {
-        anim_run_info[index].flags = 0;
-        anim_run_info[index].path.flags = 1;
-        AnimPathClear(&(anim_run_info[index].path));
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        anim_run_info_get(index)->flags = 0;
+        anim_run_info_get(index)->path.flags = 1;
+        AnimPathClear(&(anim_run_info_get(index)->path));
+    }
+
+    for (index = 1; index < ANIM_RUN_INFO_MAX_PAGES; index++) {
+        if (anim_run_info_pages[index] != NULL) {
+            FREE(anim_run_info_pages[index]);
+            anim_run_info_pages[index] = NULL;
+        }
     }
+    anim_run_info_capacity = ANIM_RUN_INFO_PAGE_SIZE;
+
+    if (anim_slot_index_nodes != NULL) {
+        FREE(anim_slot_index_nodes);
+        anim_slot_index_nodes = NULL;
+    }
+
+    if (anim_obj_index != NULL) {
+        FREE(anim_obj_index);
+        anim_obj_index = NULL;
+    }
+    anim_obj_index_size = 0;
+    anim_obj_index_used = 0;
+    anim_slots_in_use = 0;
 
     animNumActiveGoals = 0;
 }
@@ -296,11 +359,13 @@ void anim_private_reset()
 {
     int index;
 
-    for (index = 0; index < 216; index++) {
-        anim_run_info[index].flags = 0;
-        anim_run_info[index].path.flags = 1;
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        anim_run_info_get(index)->flags = 0;
+        anim_run_info_get(index)->path.flags = 1;
     }
 
+    anim_run_info_index_rebuild();
+
     animNumActiveGoals = 0;
     g_anim_system_active = 0;
 }
@@ -364,19 +429,20 @@ bool AnimAllocateSlot(AnimID* anim_id)
 
     ASSERT(anim_id != NULL); // pAnimID != NULL
 
-    for (index = 0; index < 216; index++) {
-        if ((anim_run_info[index].flags & 0x1) == 0) {
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        if ((anim_run_info_get(index)->flags & 0x1) == 0) {
             break;
         }
     }
 
-    if (index == 216) {
+    if (index == anim_run_info_capacity && !anim_run_info_grow()) {
+        anim_slot_stats_data.exhausted++;
         tig_debug_printf("Anim: WARNING: Ran out of animation slots!\n");
         g_anim_interrupt_priority_3_flag = 1;
         return false;
     }
 
-    run_info = &(anim_run_info[index]);
+    run_info = anim_run_info_get(index);
     run_info->id.slot_num = index;
     run_info->id.field_4 = g_anim_save_version++;
     run_info->id.field_8 = 0;
@@ -398,6 +464,8 @@ bool AnimAllocateSlot(AnimID* anim_id)
         run_info->goals[0].field_B0[subindex].objid.type = OID_TYPE_NULL;
     }
 
+    anim_run_info_index_update(index);
+
     g_anim_system_active++;
 
     return true;
@@ -417,8 +485,8 @@ bool anim_allocate_this_run_index(AnimID* anim_id)
         return false;
     }
 
-    for (slot = 0; slot < 216; slot++) {
-        run_info = &(anim_run_info[slot]);
+    for (slot = 0; slot < anim_run_info_capacity; slot++) {
+        run_info = anim_run_info_get(slot);
         if (run_info->id.field_4 == anim_id->field_4) {
             if ((run_info->flags & 0x1) != 0
                 && !InterruptAnimation(&(run_info->id), PRIORITY_HIGHEST)) {
@@ -432,12 +500,12 @@ bool anim_allocate_this_run_index(AnimID* anim_id)
         }
     }
 
-    if (slot == 216) {
+    if (slot == anim_run_info_capacity) {
         if (anim_id->slot_num >= 0
-            && anim_id->slot_num < 216
-            && (anim_run_info[anim_id->slot_num].flags & 0x1) != 0) {
-            for (slot = 0; slot < 216; slot++) {
-                run_info = &(anim_run_info[slot]);
+            && anim_id->slot_num < anim_run_info_capacity
+            && (anim_run_info_get(anim_id->slot_num)->flags & 0x1) != 0) {
+            for (slot = 0; slot < anim_run_info_capacity; slot++) {
+                run_info = anim_run_info_get(slot);
                 if ((run_info->flags & 0x1) == 0) {
                     anim_id->slot_num = slot;
                     anim_id->field_8 = 0;
@@ -445,14 +513,29 @@ bool anim_allocate_this_run_index(AnimID* anim_id)
                 }
             }
 
-            if (slot == 216) {
+            if (slot == anim_run_info_capacity && anim_run_info_grow()) {
+                anim_id->slot_num = slot;
+                anim_id->field_8 = 0;
+            }
+
+            if (slot == anim_run_info_capacity) {
+                anim_slot_stats_data.exhausted++;
                 tig_debug_printf("Anim: anim_allocate_this_run_index: could not allocate a run index, ALL FULL!.\n");
                 return false;
             }
+        } else if (anim_id->slot_num >= 0
+            && anim_run_info_reserve(anim_id->slot_num + 1)) {
+            // The requested slot is free (or lies past the current end of
+            // the pool), take it as is.
+            slot = anim_id->slot_num;
+        } else {
+            anim_slot_stats_data.exhausted++;
+            tig_debug_printf("Anim: anim_allocate_this_run_index: could not allocate a run index, ALL FULL!.\n");
+            return false;
         }
     }
 
-    run_info = &(anim_run_info[slot]);
+    run_info = anim_run_info_get(slot);
     run_info->id = *anim_id;
     run_info->flags = 0x1;
     run_info->path.maxPathLength = 0;
@@ -468,6 +551,8 @@ bool anim_allocate_this_run_index(AnimID* anim_id)
         run_info->goals[0].field_B0[idx].objid.type = OID_TYPE_NULL;
     }
 
+    anim_run_info_index_update(slot);
+
     g_anim_system_active++;
 
     return true;
@@ -508,6 +593,7 @@ bool mp_deallocate_run_index(AnimID* anim_id)
         run_info->flags = 0;
         run_info->current_goal = -1;
         run_info->path.flags = 1;
+        anim_run_info_index_update(anim_run_info_slot_of(run_info));
 
         g_anim_system_active--;
         anim_set_debug_error_msg("Free Run Index");
@@ -524,6 +610,7 @@ bool mp_deallocate_run_index(AnimID* anim_id)
         run_info->flags = 0;
         run_info->current_goal = -1;
         run_info->path.flags = 1;
+        anim_run_info_index_update(anim_run_info_slot_of(run_info));
     }
 
     return true;
@@ -594,12 +681,13 @@ bool AnimResetSlot(int index)
 {
     AnimRunInfo* run_info;
 
-    run_info = &(anim_run_info[index]);
+    run_info = anim_run_info_get(index);
     run_info->anim_obj = 0;
     run_info->cur_stack_data = NULL;
     run_info->flags = 0;
     run_info->current_goal = -1;
     run_info->path.flags |= 0x1;
+    anim_run_info_index_update(index);
 
     s_animIdToClearTimeEvents = run_info->id;
     timeevent_clear_one_ex(TIMEEVENT_TYPE_ANIM, TimeEventMatchesAnim);
@@ -610,38 +698,44 @@ bool AnimResetSlot(int index)
 // 0x44D2F0
 int anim_find_first(int64_t obj)
 {
-    int slot;
-    AnimRunInfo* run_info;
-
-    for (slot = 0; slot < 216; slot++) {
-        run_info = &(anim_run_info[slot]);
-        if ((run_info->flags & 0x1) != 0
-            && (run_info->flags & 0x2) == 0
-            && run_info->current_goal > -1
-            && run_info->id.slot_num != -1
-            && run_info->anim_obj == obj) {
-            return slot;
-        }
-    }
-
-    return -1;
+    return anim_find_next(-1, obj);
 }
 
 // 0x44D340
 int anim_find_next(int prev, int64_t obj)
 {
     int slot;
-    AnimRunInfo* run_info;
+    AnimObjIndexEntry* entry;
+
+    // Slots without an object are not indexed.
+    if (obj == OBJ_HANDLE_NULL) {
+        for (slot = prev + 1; slot < anim_run_info_capacity; slot++) {
+            if (anim_slot_matches(anim_run_info_get(slot), obj)) {
+                return slot;
+            }
+        }
+
+        return -1;
+    }
 
-    for (slot = prev + 1; slot < 216; slot++) {
-        run_info = &(anim_run_info[slot]);
-        if ((run_info->flags & 0x1) != 0
-            && (run_info->flags & 0x2) == 0
-            && run_info->current_goal > -1
-            && run_info->id.slot_num != -1
-            && run_info->anim_obj == obj) {
+    anim_slot_stats_data.lookups++;
+
+    entry = anim_obj_index_find(obj, false);
+    if (entry == NULL) {
+        return -1;
+    }
+
+    // Chains are kept in slot order, so this visits slots in the same order
+    // as a linear scan would.
+    slot = entry->head;
+    while (slot != -1) {
+        anim_slot_stats_data.lookup_steps++;
+
+        if (slot > prev && anim_slot_matches(anim_run_info_get(slot), obj)) {
             return slot;
         }
+
+        slot = anim_slot_index_nodes[slot].next;
     }
 
     return -1;
@@ -808,12 +902,13 @@ bool AnimGoalStartLocal(AnimGoalData* goal_data, AnimID* anim_id, bool a3, unsig
         return false;
     }
 
-    run_info = &(anim_run_info[new_anim_id.slot_num]);
+    run_info = anim_run_info_get(new_anim_id.slot_num);
     run_info->current_goal = 0;
     run_info->current_state = 0;
     run_info->path_attached_to_stack_index = -1;
     run_info->anim_obj = goal_data->params[AGDATA_SELF_OBJ].obj;
     run_info->flags |= flags;
+    anim_run_info_index_update(new_anim_id.slot_num);
     run_info->goals[0] = *goal_data;
     run_info->cur_stack_data = &(run_info->goals[0]);
     for (idx = 0; idx < 5; idx++) {
@@ -821,6 +916,13 @@ bool AnimGoalStartLocal(AnimGoalData* goal_data, AnimID* anim_id, bool a3, unsig
     }
     AnimRunSetGoalNode(run_info, anim_goal_nodes[run_info->goals[0].type]);
     anim_set_debug_error_msg("GoalAdd");
+
+    // Start decoding animation art while the goal is waiting for its first
+    // time event.
+    if (goal_data->params[AGDATA_ANIM_ID].data != TIG_ART_ID_INVALID) {
+        tig_art_prefetch(goal_data->params[AGDATA_ANIM_ID].data);
+    }
+
     if ((goal_data->type == AG_ATTACK
             || goal_data->type == AG_ATTEMPT_ATTACK)
         && player_is_local_pc_obj(run_info->anim_obj)) {
@@ -955,6 +1057,7 @@ bool anim_recover_handles(AnimRunInfo* run_info, AnimGoalSubNode* goal_subnode)
                     run_info->cur_stack_data->params[idx].obj = OBJ_HANDLE_NULL;
                 }
                 run_info->anim_obj = OBJ_HANDLE_NULL;
+                anim_run_info_index_update(anim_run_info_slot_of(run_info));
                 return false;
             }
 
@@ -972,6 +1075,7 @@ bool anim_recover_handles(AnimRunInfo* run_info, AnimGoalSubNode* goal_subnode)
     }
 
     run_info->anim_obj = run_info->cur_stack_data->params[AGDATA_SELF_OBJ].obj;
+    anim_run_info_index_update(anim_run_info_slot_of(run_info));
 
     if (goal_subnode != NULL) {
         for (idx = 0; idx < 2; idx++) {
@@ -1038,7 +1142,7 @@ void InterruptAttackOnParty(int64_t a1, int64_t a2)
     AnimRunInfo* run_info;
 
     if (anim_get_current_id(a1, &anim_id)) {
-        run_info = &(anim_run_info[anim_id.slot_num]);
+        run_info = anim_run_info_get(anim_id.slot_num);
         if (run_info->goals[0].type == AG_ATTACK
             || run_info->goals[1].type == AG_ATTEMPT_ATTACK) {
             if (run_info->goals[0].params[AGDATA_TARGET_OBJ].obj == a2
@@ -1056,7 +1160,7 @@ void InterruptAttackOnTarget(int64_t a1, int64_t a2)
     AnimRunInfo* run_info;
 
     if (anim_get_current_id(a1, &anim_id)) {
-        run_info = &(anim_run_info[anim_id.slot_num]);
+        run_info = anim_run_info_get(anim_id.slot_num);
         if (run_info->goals[0].type == AG_ATTACK
             || run_info->goals[1].type == AG_ATTEMPT_ATTACK) {
             if (run_info->goals[0].params[AGDATA_TARGET_OBJ].obj == a2) {
@@ -1074,7 +1178,7 @@ bool AnimGoalCancel(AnimID* anim_id)
     AnimGoalNode* goal_node;
 
     ASSERT(anim_id != NULL); // 3979, "pAnimID != NULL"
-    ASSERT(anim_id->slot_num < 216); // 3980, "pAnimID->slotNum < ANIM_MAX_CURRENT_ANIMS"
+    ASSERT(anim_id->slot_num < anim_run_info_capacity); // 3980, "pAnimID->slotNum < ANIM_MAX_CURRENT_ANIMS"
 
     if (!anim_id_to_run_info(anim_id, &run_info)) {
         return false;
@@ -1127,7 +1231,7 @@ bool InterruptAnimation(AnimID* anim_id, int priority)
     bool freed;
 
     ASSERT(anim_id != NULL); // 4034, "pAnimID != NULL"
-    ASSERT(anim_id->slot_num < 216); // 4035, "pAnimID->slotNum < ANIM_MAX_CURRENT_ANIMS"
+    ASSERT(anim_id->slot_num < anim_run_info_capacity); // 4035, "pAnimID->slotNum < ANIM_MAX_CURRENT_ANIMS"
 
     if (!anim_id_to_run_info(anim_id, &run_info)) {
         return false;
@@ -1230,7 +1334,7 @@ bool InterruptAnimsByType(int64_t obj, int goal_type, int a3)
     while (slot != -1 && slot != prev_slot) {
         prev_slot = slot;
 
-        run_info = &(anim_run_info[slot]);
+        run_info = anim_run_info_get(slot);
         if (run_info->goals[0].type == goal_type) {
             if (!InterruptAnimation(&(run_info->id), priority)) {
                 return false;
@@ -1274,7 +1378,7 @@ bool anim_find_next_of_type(int64_t obj, int type, AnimID* anim_id)
     slot = anim_id != NULL ? anim_id->slot_num + 1 : anim_find_first(obj);
     while (slot != -1 && slot != prev_slot) {
         prev_slot = slot;
-        run_info = &(anim_run_info[slot]);
+        run_info = anim_run_info_get(slot);
         if (run_info->goals[0].type == type && run_info->id.slot_num != -1) {
             if (anim_id != NULL) {
                 *anim_id = run_info->id;
@@ -1313,7 +1417,7 @@ bool AnimGoalFindExisting(int64_t obj, AnimGoalData* goal_data, AnimID* anim_id)
     while (slot != -1) {
         prev_slot = slot;
 
-        run_info = &(anim_run_info[slot]);
+        run_info = anim_run_info_get(slot);
 
         if (goal_data->type != -1) {
             // NOTE: Original code is slightly different but does the same
@@ -1375,7 +1479,7 @@ bool anim_is_current_goal_type(int64_t obj, int goal_type, AnimID* anim_id)
         return false;
     }
 
-    run_info = &(anim_run_info[slot]);
+    run_info = anim_run_info_get(slot);
 
     if (goal_type == -1) {
         return false;
@@ -1419,9 +1523,9 @@ bool IsObjectAnimating(int64_t obj, AnimID* anim_id)
 
     slot = anim_find_first(obj);
     while (slot != -1) {
-        if (!anim_goal_nodes[anim_run_info[slot].goals[0].type]->field_C) {
+        if (!anim_goal_nodes[anim_run_info_get(slot)->goals[0].type]->field_C) {
             if (anim_id != NULL) {
-                *anim_id = anim_run_info[slot].id;
+                *anim_id = anim_run_info_get(slot)->id;
             }
             return true;
         }
@@ -1453,7 +1557,7 @@ bool FindAnimationByGoalType(int64_t obj, AnimID* anim_id, int64_t a2)
         return false;
     }
 
-    run_info = &(anim_run_info[slot]);
+    run_info = anim_run_info_get(slot);
 
     goal_type = AG_ATTACK;
     goal_node = anim_goal_nodes[goal_type];
@@ -1715,7 +1819,7 @@ void anim_run_info_debug(AnimRunInfo* run_info)
 // 0x44EEC0
 void anim_run_index_debug(int index)
 {
-    anim_run_info_debug(&(anim_run_info[index]));
+    anim_run_info_debug(anim_run_info_get(index));
 }
 
 // 0x44EEE0
@@ -1726,10 +1830,10 @@ void anim_stats()
     tig_debug_printf("Currently Existing Animations\n");
     tig_debug_printf("------------------------------------------------\n");
 
-    for (index = 0; index < 216; index++) {
-        if (anim_run_info[index].flags != 0) {
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        if (anim_run_info_get(index)->flags != 0) {
             tig_debug_printf("In Slot %d:\n", index);
-            anim_run_info_debug(&(anim_run_info[index]));
+            anim_run_info_debug(anim_run_info_get(index));
             tig_debug_printf("------------------------------------------------\n");
         }
     }
@@ -1737,3 +1841,285 @@ void anim_stats()
     tig_debug_printf("Done.\n");
     tig_debug_printf("------------------------------------------------\n");
 }
+
+bool anim_slot_matches(AnimRunInfo* run_info, int64_t obj)
+{
+    return (run_info->flags & 0x1) != 0
+        && (run_info->flags & 0x2) == 0
+        && run_info->current_goal > -1
+        && run_info->id.slot_num != -1
+        && run_info->anim_obj == obj;
+}
+
+int anim_run_info_slot_of(AnimRunInfo* run_info)
+{
+    int page;
+
+    for (page = 0; page < anim_run_info_capacity / ANIM_RUN_INFO_PAGE_SIZE; page++) {
+        if (run_info >= anim_run_info_pages[page]
+            && run_info < anim_run_info_pages[page] + ANIM_RUN_INFO_PAGE_SIZE) {
+            return page * ANIM_RUN_INFO_PAGE_SIZE + (int)(run_info - anim_run_info_pages[page]);
+        }
+    }
+
+    ASSERT(0); // run_info is not a pool slot
+
+    return -1;
+}
+
+bool anim_run_info_grow()
+{
+    int page;
+    int slot;
+    AnimRunInfo* run_info;
+    AnimSlotIndexNode* node;
+
+    page = anim_run_info_capacity / ANIM_RUN_INFO_PAGE_SIZE;
+    if (page >= ANIM_RUN_INFO_MAX_PAGES) {
+        return false;
+    }
+
+    // Pages are kept across resets, so the one we need may already exist.
+    if (anim_run_info_pages[page] == NULL) {
+        anim_run_info_pages[page] = (AnimRunInfo*)CALLOC(ANIM_RUN_INFO_PAGE_SIZE, sizeof(AnimRunInfo));
+    }
+
+    anim_slot_index_nodes = (AnimSlotIndexNode*)REALLOC(anim_slot_index_nodes,
+        sizeof(*anim_slot_index_nodes) * (anim_run_info_capacity + ANIM_RUN_INFO_PAGE_SIZE));
+
+    for (slot = anim_run_info_capacity; slot < anim_run_info_capacity + ANIM_RUN_INFO_PAGE_SIZE; slot++) {
+        run_info = anim_run_info_get(slot);
+        run_info->id.slot_num = slot;
+        run_info->anim_obj = OBJ_HANDLE_NULL;
+        run_info->flags = 0;
+        run_info->current_goal = -1;
+        run_info->path.flags = 1;
+        run_info->path.field_CC = 200;
+        AnimPathReset(&(run_info->path));
+
+        node = &(anim_slot_index_nodes[slot]);
+        node->obj = OBJ_HANDLE_NULL;
+        node->next = -1;
+        node->used = false;
+    }
+
+    anim_run_info_capacity += ANIM_RUN_INFO_PAGE_SIZE;
+    anim_slot_stats_data.grows++;
+
+    tig_debug_printf("Anim: Grew animation slot pool to %d slots.\n", anim_run_info_capacity);
+
+    // Resize the object index for the new capacity.
+    anim_obj_index_refill();
+
+    return true;
+}
+
+bool anim_run_info_reserve(int capacity)
+{
+    while (anim_run_info_capacity < capacity) {
+        if (!anim_run_info_grow()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+unsigned int anim_obj_index_hash(int64_t obj)
+{
+    uint64_t key;
+
+    key = (uint64_t)obj;
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+
+    return (unsigned int)key;
+}
+
+AnimObjIndexEntry* anim_obj_index_find(int64_t obj, bool create)
+{
+    unsigned int mask;
+    unsigned int pos;
+    AnimObjIndexEntry* entry;
+
+    // Entries are never removed individually, instead the table is refilled
+    // from live slots when it gets crowded.
+    if (create && (anim_obj_index_used + 1) * 4 > anim_obj_index_size * 3) {
+        anim_obj_index_refill();
+    }
+
+    mask = (unsigned int)anim_obj_index_size - 1;
+    pos = anim_obj_index_hash(obj) & mask;
+    for (;;) {
+        if (!create) {
+            anim_slot_stats_data.lookup_steps++;
+        }
+
+        entry = &(anim_obj_index[pos]);
+        if (entry->obj == obj) {
+            return entry;
+        }
+
+        if (entry->obj == OBJ_HANDLE_NULL) {
+            if (!create) {
+                return NULL;
+            }
+
+            entry->obj = obj;
+            entry->head = -1;
+            anim_obj_index_used++;
+            return entry;
+        }
+
+        pos = (pos + 1) & mask;
+    }
+}
+
+void anim_obj_index_refill()
+{
+    int size;
+    int slot;
+    AnimSlotIndexNode* node;
+    AnimObjIndexEntry* entry;
+
+    // Keep at most half of the table occupied by live objects.
+    size = ANIM_OBJ_INDEX_MIN_SIZE;
+    while (size < anim_run_info_capacity * 2) {
+        size *= 2;
+    }
+
+    if (size != anim_obj_index_size) {
+        if (anim_obj_index != NULL) {
+            FREE(anim_obj_index);
+        }
+
+        anim_obj_index = (AnimObjIndexEntry*)MALLOC(sizeof(*anim_obj_index) * size);
+        anim_obj_index_size = size;
+    }
+
+    memset(anim_obj_index, 0, sizeof(*anim_obj_index) * anim_obj_index_size);
+    anim_obj_index_used = 0;
+
+    // Walk backwards so that pushing to the front leaves chains sorted.
+    for (slot = anim_run_info_capacity - 1; slot >= 0; slot--) {
+        node = &(anim_slot_index_nodes[slot]);
+        if (node->obj != OBJ_HANDLE_NULL) {
+            entry = anim_obj_index_find(node->obj, true);
+            node->next = entry->head;
+            entry->head = slot;
+        }
+    }
+}
+
+void anim_run_info_index_update(int slot)
+{
+    AnimRunInfo* run_info;
+    AnimSlotIndexNode* node;
+    AnimObjIndexEntry* entry;
+    bool used;
+    int prev;
+    int curr;
+
+    run_info = anim_run_info_get(slot);
+    node = &(anim_slot_index_nodes[slot]);
+
+    used = (run_info->flags & 0x1) != 0;
+    if (node->used != used) {
+        node->used = used;
+        if (used) {
+            anim_slots_in_use++;
+            if (anim_slots_in_use > anim_slot_stats_data.peak) {
+                anim_slot_stats_data.peak = anim_slots_in_use;
+            }
+        } else {
+            anim_slots_in_use--;
+        }
+    }
+
+    if (node->obj == run_info->anim_obj) {
+        return;
+    }
+
+    if (node->obj != OBJ_HANDLE_NULL) {
+        entry = anim_obj_index_find(node->obj, false);
+
+        prev = -1;
+        curr = entry->head;
+        while (curr != slot) {
+            prev = curr;
+            curr = anim_slot_index_nodes[curr].next;
+        }
+
+        if (prev == -1) {
+            entry->head = node->next;
+        } else {
+            anim_slot_index_nodes[prev].next = node->next;
+        }
+
+        node->obj = OBJ_HANDLE_NULL;
+    }
+
+    if (run_info->anim_obj != OBJ_HANDLE_NULL) {
+        // Look up (and possibly refill) before binding the node, so that a
+        // refill does not link this slot on its own.
+        entry = anim_obj_index_find(run_info->anim_obj, true);
+        node->obj = run_info->anim_obj;
+
+        prev = -1;
+        curr = entry->head;
+        while (curr != -1 && curr < slot) {
+            prev = curr;
+            curr = anim_slot_index_nodes[curr].next;
+        }
+
+        node->next = curr;
+        if (prev == -1) {
+            entry->head = slot;
+        } else {
+            anim_slot_index_nodes[prev].next = slot;
+        }
+    }
+}
+
+void anim_run_info_index_rebuild()
+{
+    int slot;
+    AnimRunInfo* run_info;
+    AnimSlotIndexNode* node;
+
+    anim_slots_in_use = 0;
+
+    for (slot = 0; slot < anim_run_info_capacity; slot++) {
+        run_info = anim_run_info_get(slot);
+        node = &(anim_slot_index_nodes[slot]);
+        node->obj = run_info->anim_obj;
+        node->next = -1;
+        node->used = (run_info->flags & 0x1) != 0;
+        if (node->used) {
+            anim_slots_in_use++;
+        }
+    }
+
+    if (anim_slots_in_use > anim_slot_stats_data.peak) {
+        anim_slot_stats_data.peak = anim_slots_in_use;
+    }
+
+    anim_obj_index_refill();
+}
+
+void anim_slot_stats(AnimSlotStats* stats)
+{
+    *stats = anim_slot_stats_data;
+    stats->capacity = anim_run_info_capacity;
+    stats->in_use = anim_slots_in_use;
+}
+
+void anim_slot_reset_stats()
+{
+    anim_slot_stats_data.peak = anim_slots_in_use;
+    anim_slot_stats_data.grows = 0;
+    anim_slot_stats_data.exhausted = 0;
+    anim_slot_stats_data.lookups = 0;
+    anim_slot_stats_data.lookup_steps = 0;
+}
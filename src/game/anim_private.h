@@ -252,7 +252,44 @@ extern int g_anim_save_version;
 extern int g_anim_unknown_739E40;
 extern int g_anim_unknown_739E44;
 
-extern AnimRunInfo anim_run_info[216];
+// Run slots are kept in fixed-size pages so that pointers into the pool stay
+// valid when it grows. Slot ids are stable: slot `n` always lives at the same
+// place in the same page.
+#define ANIM_RUN_INFO_PAGE_SIZE 216
+#define ANIM_RUN_INFO_MAX_PAGES 8
+
+// Run slot pool counters, see `anim_slot_stats`.
+typedef struct AnimSlotStats {
+    // Number of slots currently backed by pages.
+    int capacity;
+
+    // Number of slots currently in use.
+    int in_use;
+
+    // Highest `in_use` observed since the last reset.
+    int peak;
+
+    // Number of pages added to the pool.
+    int grows;
+
+    // Number of allocations that failed because the pool is at its maximum
+    // size.
+    int exhausted;
+
+    // Number of object-to-slot lookups.
+    unsigned int lookups;
+
+    // Number of hash probes and chain links visited by those lookups.
+    unsigned int lookup_steps;
+} AnimSlotStats;
+
+extern AnimRunInfo* anim_run_info_pages[ANIM_RUN_INFO_MAX_PAGES];
+extern int anim_run_info_capacity;
+
+static inline AnimRunInfo* anim_run_info_get(int slot)
+{
+    return &(anim_run_info_pages[slot / ANIM_RUN_INFO_PAGE_SIZE][slot % ANIM_RUN_INFO_PAGE_SIZE]);
+}
 
 void AnimRunSetGoalNode(AnimRunInfo* run_info, AnimGoalNode* goal_node);
 bool AnimGoalIsPassive(AnimRunInfo* run_info);
@@ -293,5 +330,10 @@ void AnimPathClear(AnimPath* path);
 void AnimRunInfoAdvanceGoal(AnimRunInfo* run_info);
 void anim_run_index_debug(int index);
 void anim_stats();
+bool anim_run_info_reserve(int capacity);
+void anim_run_info_index_update(int slot);
+void anim_run_info_index_rebuild();
+void anim_slot_stats(AnimSlotStats* stats);
+void anim_slot_reset_stats();
 
 #endif /* ARCANUM_GAME_ANIM_PRIVATE_H_ */
@@ -123,6 +123,7 @@ static void gamelib_splash(tig_window_handle_t window_handle);
 static void sub_404A20();
 static bool sub_404C10(const char* module_name);
 static void sub_405070();
+static void gamelib_archive_done(bool success);
 
 // 0x59A330
 static GameLibModule gamelib_modules[] = {
@@ -130,7 +131,7 @@ static GameLibModule gamelib_modules[] = {
     { "Description", description_init, NULL, description_mod_load, description_mod_unload, description_exit, NULL, NULL, NULL, NULL },
     { "Item-Effect", item_effect_init, NULL, item_effect_mod_load, item_effect_mod_unload, item_effect_exit, NULL, NULL, NULL, NULL },
     { "Teleport", teleport_init, teleport_reset, NULL, NULL, teleport_exit, teleport_ping, NULL, NULL, NULL },
-    { "Sector", sector_history_init, sector_history_reset, NULL, NULL, sector_history_exit, NULL, NULL, sector_history_save, sector_history_load, NULL },
+    { "Sector", sector_history_init, sector_history_reset, NULL, NULL, sector_history_exit, sector_ping, NULL, sector_history_save, sector_history_load, NULL },
     { "Random", random_init, NULL, NULL, NULL, random_exit, NULL, NULL, NULL, NULL, NULL },
     { "Critter", critter_init, NULL, NULL, NULL, critter_exit, NULL, NULL, NULL, NULL, NULL },
     { "Name", name_init, NULL, NULL, NULL, name_exit, NULL, NULL, NULL, NULL },
@@ -142,7 +143,7 @@ static GameLibModule gamelib_modules[] = {
     { "MT-AT", mt_ai_init, mt_ai_reset, NULL, NULL, mt_ai_exit, NULL, NULL, NULL, NULL, NULL },
     { "MT-Item", mt_item_init, NULL, NULL, NULL, mt_item_exit, NULL, NULL, NULL, NULL, NULL },
     { "Spell", spell_init, NULL, NULL, NULL, spell_exit, NULL, NULL, NULL, NULL, NULL },
-    { "Stat", stat_init, NULL, NULL, NULL, stat_exit, NULL, NULL, NULL, NULL, NULL },
+    { "Stat", stat_init, stat_reset, NULL, NULL, stat_exit, NULL, NULL, NULL, NULL, NULL },
     { "Level", level_init, NULL, NULL, NULL, level_exit, NULL, NULL, NULL, NULL, NULL },
     { "Map", map_init, map_reset, map_mod_load, map_mod_unload, map_exit, map_ping, map_update_view, map_save, map_load, map_resize },
     { "LightScheme", light_scheme_init, light_scheme_reset, light_scheme_mod_load, light_scheme_mod_unload, light_scheme_exit, NULL, NULL, light_scheme_save, light_scheme_load, NULL },
@@ -294,6 +295,12 @@ static bool g_is_in_reset;
 // 0x5D10EC
 static int gamelib_cheat_level;
 
+// Name of the save being archived in the background.
+static char gamelib_archive_name[TIG_MAX_PATH];
+
+// Set when a background save has failed, reported on the next ping.
+static bool gamelib_archive_failed;
+
 // 0x739E60
 unsigned int gamelib_ping_time;
 
@@ -325,6 +332,9 @@ bool gamelib_init(GameInitInfo* init_info)
     settings_register(&settings, DIFFICULTY_KEY, "1", difficulty_changed);
     difficulty_changed();
 
+    // Compressed saves cannot be read by the original game.
+    settings_register(&settings, COMPRESS_SAVES_KEY, "0", NULL);
+
     gamelib_mod_loaded = false;
     sub_404A20();
 
@@ -492,6 +502,16 @@ void gamelib_ping()
 
     tig_timer_now(&gamelib_ping_time);
 
+    if (gamelib_archive_failed) {
+        UiMessage ui_message;
+
+        gamelib_archive_failed = false;
+
+        ui_message.type = UI_MSG_TYPE_EXCLAMATION;
+        ui_message.str = "Save failed!";
+        ui_message_post(&ui_message);
+    }
+
     for (index = 0; index < MODULE_COUNT; index++) {
         if (gamelib_modules[index].ping_func != NULL) {
             gamelib_modules[index].ping_func(gamelib_ping_time);
@@ -935,6 +955,7 @@ bool gamelib_save(const char* name, const char* description)
     unsigned int sentinel = 0xBEEFCAFE;
     int version;
     GameSaveInfo save_info;
+    unsigned int flags;
 
     tig_debug_printf("\ngamelib_save(): Saving to File: %s.\n", name);
     tig_timer_now(&start_time);
@@ -1038,8 +1059,20 @@ bool gamelib_save(const char* name, const char* description)
     sprintf(path, "save\\%s", name);
     tig_debug_printf("gamelib_save: creating folder archive...");
 
+    // The folder is read into memory up front, compressing and writing the
+    // archive is completed in the background.
+    flags = TIG_FILE_ARCHIVE_BACKGROUND;
+    if (settings_get_value(&settings, COMPRESS_SAVES_KEY) != 0) {
+        flags |= TIG_FILE_ARCHIVE_COMPRESS;
+    }
+
+    // Wait for the previous save so that its outcome is not reported under
+    // this save's name.
+    tig_file_archive_wait();
+    strcpy(gamelib_archive_name, name);
+
     tig_timer_now(&time);
-    if (!tig_file_archive(path, "Save\\Current")) {
+    if (!tig_file_archive_ex(path, "Save\\Current", flags, NULL, gamelib_archive_done)) {
         tig_debug_printf("gamelib_save(): error archiving folder to %s\n", path);
         in_save = false;
         return false;
@@ -1195,6 +1228,9 @@ bool gamelib_delete(const char* name)
         return false;
     }
 
+    // Make sure the save is not being written at the moment.
+    tig_file_archive_wait();
+
     sprintf(path, "save\\%s.gsi", name);
     tig_file_remove(path);
 
@@ -1913,3 +1949,25 @@ void sub_405070()
 
     g_module_guid_is_set = false;
 }
+
+// Called on the main thread once the background archive is complete.
+void gamelib_archive_done(bool success)
+{
+    char path[TIG_MAX_PATH];
+
+    if (success) {
+        return;
+    }
+
+    tig_debug_printf("gamelib_save(): error writing archive for %s\n", gamelib_archive_name);
+
+    // The archive itself is already removed, drop the save info and thumbnail
+    // so the broken slot does not show up in the save list.
+    sprintf(path, "save\\%s.gsi", gamelib_archive_name);
+    tig_file_remove(path);
+
+    sprintf(path, "save\\%s.bmp", gamelib_archive_name);
+    tig_file_remove(path);
+
+    gamelib_archive_failed = true;
+}
@@ -28,6 +28,7 @@
 #define SHOW_VERSION_KEY "show version"
 #define OBJECT_LIGHTING_KEY "object lighting"
 #define SHADOWS_KEY "shadows"
+#define COMPRESS_SAVES_KEY "compress saves"
 
 typedef bool(GameExtraSaveFunc)();
 typedef bool(GameExtraLoadFunc)();
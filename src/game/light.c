@@ -45,6 +45,31 @@ typedef struct LightSerializedData {
 // Serializeable.
 static_assert(sizeof(LightSerializedData) == 0x30, "wrong size");
 
+#define LIGHT_MASK_CACHE_SIZE 32
+
+// Marks mask pixels which contribute to lighting (i.e. not color keyed).
+#define LIGHT_MASK_OPAQUE 0x80000000u
+
+// Maximum number of samples accumulated in one go.
+#define LIGHT_SAMPLE_RUN_MAX 64
+
+// Decoded light art frame, see `light_mask_get`.
+typedef struct LightMask {
+    int width;
+    int height;
+    uint32_t* colors;
+} LightMask;
+
+// Decoded frames of light art. Keyed by art id with frame reset, so that
+// animated lights do not take up an entry per frame. Frames are decoded on the
+// first use.
+typedef struct LightMaskCacheEntry {
+    tig_art_id_t art_id;
+    int num_frames;
+    unsigned int last_used;
+    LightMask* frames;
+} LightMaskCacheEntry;
+
 static bool sub_4D89E0(int64_t loc, int a2, int a3, int a4, tig_color_t* color_ptr);
 static void sub_4D9310(LightCreateInfo* create_info, Light** light_ptr);
 static void sub_4D93B0(Light* light);
@@ -75,6 +100,11 @@ static bool sub_4DE820(TimeEvent* timeevent);
 static void sub_4DE870(LightCreateInfo* create_info, Light** light_ptr);
 static void light_render_internal(GameDrawInfo* draw_info);
 static void sub_4DF1D0(TigRect* rect);
+static void light_render_rect(Light* light, LightMask* mask, TigRect* light_rect, TigRect* rect, bool* tint_checked);
+static LightMask* light_mask_get(tig_art_id_t art_id);
+static bool light_mask_decode(tig_art_id_t art_id, LightMask* mask);
+static void light_mask_cache_entry_clear(LightMaskCacheEntry* entry);
+static void light_mask_cache_clear();
 
 // 0x5B9044
 static int dword_5B9044[] = {
@@ -202,6 +232,12 @@ static int dword_603418;
 // 0x60341C
 static int dword_60341C;
 
+// Recently used light arts.
+static LightMaskCacheEntry light_mask_cache[LIGHT_MASK_CACHE_SIZE];
+
+// Monotonic counter used to find least recently used light mask.
+static unsigned int light_mask_cache_clock;
+
 // 0x4D7F30
 bool light_init(GameInitInfo* init_info)
 {
@@ -265,6 +301,7 @@ void light_exit()
     light_iso_window_handle = TIG_WINDOW_HANDLE_INVALID;
     light_iso_window_invalidate_rect = NULL;
     sub_4F8340();
+    light_mask_cache_clear();
     FREE(dword_602E58);
 }
 
@@ -2432,8 +2469,6 @@ void sub_4DE870(LightCreateInfo* create_info, Light** light_ptr)
 // 0x4DE900
 void light_render_internal(GameDrawInfo* draw_info)
 {
-    tig_color_t indoor_color;
-    tig_color_t outdoor_color;
     TigRectListNode* rect_node;
     TigRect tmp_rect;
     TigRectListNode* head;
@@ -2441,19 +2476,14 @@ void light_render_internal(GameDrawInfo* draw_info)
     Sector* sector;
     SectorBlockListNode* light_node;
     Light* light;
-    bool art_anim_data_loaded;
-    TigArtAnimData art_anim_data;
-    int64_t loc;
-    int64_t loc_x;
-    int64_t loc_y;
+    bool mask_loaded;
+    LightMask* mask = NULL;
+    bool tint_checked;
 
     tig_video_buffer_fill(lighter_vb, NULL, 0);
     tig_video_buffer_fill(darker_vb, NULL, 0);
     light_buffers_lock();
 
-    indoor_color = light_get_indoor_color();
-    outdoor_color = light_get_outdoor_color();
-
     head = NULL;
     rect_node = *draw_info->rects;
     while (rect_node != NULL) {
@@ -2477,7 +2507,8 @@ void light_render_internal(GameDrawInfo* draw_info)
                 if ((light->flags & LF_OFF) == 0) {
                     light_get_rect_internal(light, &tmp_rect);
 
-                    art_anim_data_loaded = false;
+                    mask_loaded = false;
+                    tint_checked = false;
 
                     rect_node = head;
                     while (rect_node != NULL) {
@@ -2485,85 +2516,13 @@ void light_render_internal(GameDrawInfo* draw_info)
                             && tmp_rect.y < rect_node->rect.y + rect_node->rect.height
                             && rect_node->rect.x < tmp_rect.x + tmp_rect.width
                             && rect_node->rect.y < tmp_rect.y + tmp_rect.height) {
-                            if (!art_anim_data_loaded) {
-                                art_anim_data_loaded = true;
-                                tig_art_anim_data(light->art_id, &art_anim_data);
+                            if (!mask_loaded) {
+                                mask_loaded = true;
+                                mask = light_mask_get(light->art_id);
                             }
 
-                            location_at(rect_node->rect.x, rect_node->rect.y, &loc);
-                            location_xy(loc, &loc_x, &loc_y);
-
-                            int max_x = rect_node->rect.x + rect_node->rect.width - 1;
-                            int max_y = rect_node->rect.y + rect_node->rect.height - 1;
-
-                            for (int y = (int)loc_y; y <= max_y; y += 40) {
-                                for (int x = (int)loc_x; x <= max_x; x += 80) {
-                                    for (int i = 0; i < 2; i++) {
-                                        for (int j = 0; j < 2; j++) {
-                                            int lx = x + dword_5B9044[j];
-                                            int ly = y + dword_5B904C[i];
-                                            unsigned int color;
-
-                                            if (lx >= rect_node->rect.x
-                                                && ly >= rect_node->rect.y
-                                                && lx < rect_node->rect.x + rect_node->rect.width
-                                                && ly < rect_node->rect.y + rect_node->rect.height
-                                                && lx >= tmp_rect.x
-                                                && ly >= tmp_rect.y
-                                                && lx < tmp_rect.x + tmp_rect.width
-                                                && ly < tmp_rect.y + tmp_rect.height
-                                                && tig_art_frame_get_pixel_color(light->art_id, lx - tmp_rect.x, ly - tmp_rect.y, &color) == TIG_OK
-                                                && color != art_anim_data.color_key) {
-                                                int cx = (lx - dword_602ED0) / 40;
-                                                int cy = (ly - dword_602ED4) / 20;
-                                                if (cx >= 0
-                                                    && cx < dword_603418
-                                                    && cy >= 0
-                                                    && cy < dword_60341C) {
-                                                    if (((light->flags & LF_INDOOR) != 0
-                                                            && light->tint_color != indoor_color)
-                                                        || ((light->flags & LF_OUTDOOR) != 0
-                                                            && light->tint_color != outdoor_color)) {
-                                                        sub_4DE390(light);
-                                                        light_invalidate_rect(&tmp_rect, true);
-                                                    }
-
-                                                    switch (light_bpp) {
-                                                    case 8:
-                                                        break;
-                                                    case 16:
-                                                    case 24:
-                                                        // TODO: Incomplete.
-                                                        break;
-                                                    case 32: {
-                                                        uint32_t* dst;
-                                                        int idx;
-
-                                                        if (light->palette != NULL) {
-                                                            color = tig_color_mul(color, light->tint_color);
-                                                        }
-
-                                                        if ((light->flags & LF_DARK) != 0) {
-                                                            idx = cx + cy * darker_pitch;
-                                                            dst = darker_colors;
-                                                        } else {
-                                                            idx = cx + cy * lighter_pitch;
-                                                            dst = lighter_colors;
-                                                        }
-
-                                                        dst[idx] = tig_color_add(color, dst[idx]);
-
-                                                        break;
-                                                    }
-                                                    default:
-                                                        // Should be unreachable.
-                                                        assert(0);
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
+                            if (mask != NULL) {
+                                light_render_rect(light, mask, &tmp_rect, &(rect_node->rect), &tint_checked);
                             }
                         }
                         rect_node = rect_node->next;
@@ -2639,3 +2598,274 @@ void light_invalidate_rect(TigRect* rect, bool invalidate_objects)
         object_invalidate_rect(&dirty_rect);
     }
 }
+
+/**
+ * Accumulates light samples falling into `rect` (which is one of the dirty
+ * rects) into lighter/darker buffers.
+ *
+ * Lighting is sampled on a 40x20 grid anchored at the tile in the top-left
+ * corner of the rect. Every sample contributes to one cell of the light
+ * buffers. Consecutive samples in a row (usually) land in consecutive cells,
+ * so they are collected into runs which are then accumulated in bulk.
+ */
+void light_render_rect(Light* light, LightMask* mask, TigRect* light_rect, TigRect* rect, bool* tint_checked)
+{
+    int64_t loc;
+    int64_t loc_x;
+    int64_t loc_y;
+    int min_x;
+    int min_y;
+    int max_x;
+    int max_y;
+    int lx;
+    int ly;
+    int cx;
+    int cy;
+    uint32_t* row;
+    uint32_t* dst;
+    uint32_t samples[LIGHT_SAMPLE_RUN_MAX];
+    int start;
+    int cnt;
+    uint32_t color;
+
+    location_at(rect->x, rect->y, &loc);
+    location_xy(loc, &loc_x, &loc_y);
+
+    min_x = SDL_max(rect->x, light_rect->x);
+    min_y = SDL_max(rect->y, light_rect->y);
+    max_x = SDL_min(rect->x + rect->width, light_rect->x + light_rect->width);
+    max_y = SDL_min(rect->y + rect->height, light_rect->y + light_rect->height);
+
+    // Find first grid point within bounds.
+    lx = (int)loc_x;
+    if (lx < min_x) {
+        lx += (min_x - lx + 39) / 40 * 40;
+    }
+    min_x = lx;
+
+    ly = (int)loc_y;
+    if (ly < min_y) {
+        ly += (min_y - ly + 19) / 20 * 20;
+    }
+    min_y = ly;
+
+    for (ly = min_y; ly < max_y; ly += 20) {
+        cy = (ly - dword_602ED4) / 20;
+        if (cy < 0 || cy >= dword_60341C) {
+            continue;
+        }
+
+        row = &(mask->colors[(ly - light_rect->y) * mask->width]);
+
+        if ((light->flags & LF_DARK) != 0) {
+            dst = &(darker_colors[cy * darker_pitch]);
+        } else {
+            dst = &(lighter_colors[cy * lighter_pitch]);
+        }
+
+        start = 0;
+        cnt = 0;
+
+        for (lx = min_x; lx < max_x; lx += 40) {
+            cx = (lx - dword_602ED0) / 40;
+            if (cx < 0 || cx >= dword_603418) {
+                continue;
+            }
+
+            color = row[lx - light_rect->x];
+            if ((color & LIGHT_MASK_OPAQUE) != 0) {
+                color &= ~LIGHT_MASK_OPAQUE;
+
+                // Make sure the light is tinted with up-to-date ambient
+                // color.
+                if (!*tint_checked) {
+                    *tint_checked = true;
+
+                    if (((light->flags & LF_INDOOR) != 0
+                            && light->tint_color != light_get_indoor_color())
+                        || ((light->flags & LF_OUTDOOR) != 0
+                            && light->tint_color != light_get_outdoor_color())) {
+                        sub_4DE390(light);
+                        light_invalidate_rect(light_rect, true);
+                    }
+                }
+
+                if (light->palette != NULL) {
+                    color = tig_color_mul(color, light->tint_color);
+                }
+            } else {
+                color = 0;
+            }
+
+            // Flush current run if this sample does not extend it.
+            if (cnt != 0 && (cx != start + cnt || cnt == LIGHT_SAMPLE_RUN_MAX)) {
+                if (light_bpp == 32) {
+                    tig_color_add_span(&(dst[start]), samples, cnt);
+                }
+                cnt = 0;
+            }
+
+            if (cnt == 0) {
+                start = cx;
+            }
+
+            samples[cnt++] = color;
+        }
+
+        if (cnt != 0 && light_bpp == 32) {
+            tig_color_add_span(&(dst[start]), samples, cnt);
+        }
+    }
+}
+
+/**
+ * Retrieves decoded light art frame.
+ *
+ * Mask contains colors of every pixel of the frame (with `LIGHT_MASK_OPAQUE`
+ * bit set), or `0` for color keyed pixels. Masks are kept in a small cache, so
+ * each frame is decoded once rather than looked up in the art cache for every
+ * sample.
+ *
+ * The returned mask is valid until the next call.
+ */
+LightMask* light_mask_get(tig_art_id_t art_id)
+{
+    tig_art_id_t key;
+    int frame;
+    LightMaskCacheEntry* entry;
+    TigArtAnimData art_anim_data;
+    int index;
+
+    key = tig_art_id_frame_set(art_id, 0);
+    frame = tig_art_id_frame_get(art_id);
+
+    light_mask_cache_clock++;
+
+    entry = NULL;
+    for (index = 0; index < LIGHT_MASK_CACHE_SIZE; index++) {
+        if (light_mask_cache[index].frames != NULL
+            && light_mask_cache[index].art_id == key) {
+            entry = &(light_mask_cache[index]);
+            break;
+        }
+    }
+
+    if (entry == NULL) {
+        // Reuse empty or least recently used entry.
+        entry = &(light_mask_cache[0]);
+        for (index = 1; index < LIGHT_MASK_CACHE_SIZE && entry->frames != NULL; index++) {
+            if (light_mask_cache[index].frames == NULL
+                || light_mask_cache[index].last_used < entry->last_used) {
+                entry = &(light_mask_cache[index]);
+            }
+        }
+
+        if (tig_art_anim_data(art_id, &art_anim_data) != TIG_OK
+            || art_anim_data.num_frames <= 0) {
+            return NULL;
+        }
+
+        light_mask_cache_entry_clear(entry);
+
+        entry->art_id = key;
+        entry->num_frames = art_anim_data.num_frames;
+        entry->frames = (LightMask*)CALLOC(entry->num_frames, sizeof(*entry->frames));
+    }
+
+    entry->last_used = light_mask_cache_clock;
+
+    if (frame < 0 || frame >= entry->num_frames) {
+        return NULL;
+    }
+
+    if (entry->frames[frame].colors == NULL
+        && !light_mask_decode(art_id, &(entry->frames[frame]))) {
+        return NULL;
+    }
+
+    return &(entry->frames[frame]);
+}
+
+// Decodes light art frame from its pixel buffer, palette indices are mapped to
+// mask colors with a lookup table.
+//
+// NOTE: Light art is never mirrored, so the pixel buffer is used as is.
+bool light_mask_decode(tig_art_id_t art_id, LightMask* mask)
+{
+    TigArtFrameData art_frame_data;
+    TigArtAnimData art_anim_data;
+    uint32_t lookup[256];
+    unsigned int rgb_mask;
+    unsigned int color;
+    uint8_t* pixels;
+    int count;
+    int index;
+
+    if (tig_art_frame_data(art_id, &art_frame_data) != TIG_OK
+        || tig_art_anim_data(art_id, &art_anim_data) != TIG_OK
+        || art_frame_data.width <= 0
+        || art_frame_data.height <= 0) {
+        return false;
+    }
+
+    count = art_frame_data.width * art_frame_data.height;
+    pixels = (uint8_t*)MALLOC(count);
+    if (tig_art_frame_get_raw_pixels(art_id, pixels, art_frame_data.width) != TIG_OK) {
+        FREE(pixels);
+        return false;
+    }
+
+    // Same conversion as `tig_art_frame_get_pixel_color`.
+    rgb_mask = tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask;
+    for (index = 0; index < 256; index++) {
+        if (art_anim_data.bpp == 16) {
+            color = ((uint16_t*)art_anim_data.palette2)[index];
+        } else {
+            color = ((uint32_t*)art_anim_data.palette2)[index];
+        }
+
+        lookup[index] = color != art_anim_data.color_key
+            ? (color & rgb_mask) | LIGHT_MASK_OPAQUE
+            : 0;
+    }
+
+    mask->width = art_frame_data.width;
+    mask->height = art_frame_data.height;
+    mask->colors = (uint32_t*)MALLOC(sizeof(*mask->colors) * count);
+
+    for (index = 0; index < count; index++) {
+        mask->colors[index] = lookup[pixels[index]];
+    }
+
+    FREE(pixels);
+
+    return true;
+}
+
+void light_mask_cache_entry_clear(LightMaskCacheEntry* entry)
+{
+    int frame;
+
+    if (entry->frames == NULL) {
+        return;
+    }
+
+    for (frame = 0; frame < entry->num_frames; frame++) {
+        if (entry->frames[frame].colors != NULL) {
+            FREE(entry->frames[frame].colors);
+        }
+    }
+
+    FREE(entry->frames);
+    entry->frames = NULL;
+    entry->num_frames = 0;
+}
+
+void light_mask_cache_clear()
+{
+    int index;
+
+    for (index = 0; index < LIGHT_MASK_CACHE_SIZE; index++) {
+        light_mask_cache_entry_clear(&(light_mask_cache[index]));
+    }
+}
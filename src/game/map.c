@@ -1360,7 +1360,10 @@ bool map_load_mobile(const char* base_path, const char* save_path)
     ObjectID oid;
     int64_t obj;
     TigFile* stream;
+    TigFile* dif_stream;
     TigGuid guid;
+    TigFileBatchEntry entries[2];
+    int cnt;
 
     if (map_editor) {
         sprintf(path, "%s\\*.mob", base_path);
@@ -1400,15 +1403,50 @@ bool map_load_mobile(const char* base_path, const char* save_path)
     strcat(path3, "\\");
     fname = &(path3[strlen(path3)]);
 
-    stream = tig_file_fopen(path2, "rb");
-    if (stream == NULL) {
+    // Read mobile objects and their differences in one batch, so that both
+    // files are inflated in parallel.
+    entries[0].path = path2;
+    cnt = 1;
+
+    strcpy(fname, "mobile.md");
+    if (tig_file_exists(path3, NULL)) {
+        entries[1].path = path3;
+        cnt++;
+    }
+
+    tig_file_read_batch(entries, cnt);
+
+    dif_stream = NULL;
+    if (cnt > 1) {
+        if (entries[1].data == NULL) {
+            if (entries[0].data != NULL) {
+                FREE(entries[0].data);
+            }
+
+            tig_debug_printf("Error opening differences file %s for reading\n", path3);
+            return false;
+        }
+
+        dif_stream = tig_file_fopen_memory(entries[1].data, entries[1].size);
+    }
+
+    if (entries[0].data == NULL) {
+        if (dif_stream != NULL) {
+            tig_file_fclose(dif_stream);
+        }
+
         tig_debug_printf("Error opening file %s\n", path2);
         return false;
     }
 
+    stream = tig_file_fopen_memory(entries[0].data, entries[0].size);
+
     if (tig_file_fread(&guid, sizeof(guid), 1, stream) != 1) {
         // FIX: Release `stream`.
         tig_file_fclose(stream);
+        if (dif_stream != NULL) {
+            tig_file_fclose(dif_stream);
+        }
 
         tig_debug_printf("Error reading GUID from file %s\n", path2);
         return false;
@@ -1420,6 +1458,9 @@ bool map_load_mobile(const char* base_path, const char* save_path)
     if (tig_file_feof(stream) == 0) {
         // FIX: Release `stream`.
         tig_file_fclose(stream);
+        if (dif_stream != NULL) {
+            tig_file_fclose(dif_stream);
+        }
 
         tig_debug_printf("Error reading object from file %s\n", path2);
         return false;
@@ -1428,13 +1469,8 @@ bool map_load_mobile(const char* base_path, const char* save_path)
     // FIX: Release `stream`.
     tig_file_fclose(stream);
 
-    strcpy(fname, "mobile.md");
-    if (tig_file_exists(path3, NULL)) {
-        stream = tig_file_fopen(path3, "rb");
-        if (stream == NULL) {
-            tig_debug_printf("Error opening differences file %s for reading\n", path3);
-            return false;
-        }
+    if (dif_stream != NULL) {
+        stream = dif_stream;
 
         while (tig_file_fread(&oid, sizeof(oid), 1, stream) == 1) {
             obj = objp_perm_lookup(oid);
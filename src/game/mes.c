@@ -23,6 +23,7 @@ static bool parse_field(TigFile* stream, char* buffer);
 static TigFile* mes_file_open(const char* path, const char* mode);
 static void mes_file_close(TigFile* stream);
 static int consume_next_char(TigFile* stream);
+static void mes_file_read_all(TigFile* stream);
 static int compare_mes_file_entry(const void* a, const void* b);
 static void copy_mes_file_entry(MesFileEntry* dst, MesFileEntry* src, char* str);
 static void check_duplicates(MesFile* mes_file);
@@ -35,11 +36,17 @@ static void check_duplicates(MesFile* mes_file);
 static int mes_file_parse_line;
 
 /**
- * Buffer for storing a single line during parsing.
+ * Buffer holding the contents of the currently parsed message file.
  *
- * 0x6018E0
+ * Message files are read in one go (see `mes_file_read_all`) rather than line
+ * by line. The buffer is kept between loads and only grows.
  */
-static char mes_file_parse_buffer[MAX_STRING];
+static char* mes_file_parse_buffer;
+
+/**
+ * The capacity of the parsing buffer (`mes_file_parse_buffer`).
+ */
+static int mes_file_parse_capacity;
 
 /**
  * Path of the currently parsed message file, used for error reporting.
@@ -326,6 +333,12 @@ bool mes_unload(mes_file_handle_t mes_file_handle)
             FREE(mes_files);
             mes_files = NULL;
             mes_files_capacity = 0;
+
+            if (mes_file_parse_buffer != NULL) {
+                FREE(mes_file_parse_buffer);
+                mes_file_parse_buffer = NULL;
+                mes_file_parse_capacity = 0;
+            }
         }
     }
 
@@ -478,7 +491,7 @@ void mes_load_internal(MesFile* mes_file)
     while (parse_entry(stream, &mes_file_entry)) {
         // Expand the entries array if necessary.
         if (mes_file->num_entries == mes_file->max_entries) {
-            mes_file->max_entries += 10;
+            mes_file->max_entries = mes_file->max_entries != 0 ? mes_file->max_entries * 2 : 64;
             mes_file->entries = (MesFileEntry*)REALLOC(mes_file->entries,
                 sizeof(MesFileEntry) * mes_file->max_entries);
         }
@@ -495,8 +508,15 @@ void mes_load_internal(MesFile* mes_file)
     mes_file->size = offset;
     mes_file_close(stream);
 
-    // Sort entries by number (since all lookups use binary search).
-    if (mes_file->num_entries != 0) {
+    // Sort entries by number (since all lookups use binary search). Most files
+    // are already written in order, so check that first.
+    for (offset = 1; offset < mes_file->num_entries; offset++) {
+        if (mes_file->entries[offset - 1].num > mes_file->entries[offset].num) {
+            break;
+        }
+    }
+
+    if (offset < mes_file->num_entries) {
         qsort(mes_file->entries,
             mes_file->num_entries,
             sizeof(MesFileEntry),
@@ -623,9 +643,17 @@ bool parse_field(TigFile* stream, char* buffer)
  */
 TigFile* mes_file_open(const char* path, const char* mode)
 {
+    TigFile* stream;
+
     mes_file_parse_pos = 0;
     mes_file_parse_len = 0;
-    return tig_file_fopen(path, mode);
+
+    stream = tig_file_fopen(path, mode);
+    if (stream != NULL) {
+        mes_file_read_all(stream);
+    }
+
+    return stream;
 }
 
 /**
@@ -645,19 +673,10 @@ void mes_file_close(TigFile* stream)
  */
 int consume_next_char(TigFile* stream)
 {
-    // Refill the buffer if the current position reaches the end.
-    if (mes_file_parse_pos == mes_file_parse_len) {
-        mes_file_parse_pos = 0;
-        mes_file_parse_len = 0;
+    (void)stream;
 
-        if (tig_file_fgets(mes_file_parse_buffer, sizeof(mes_file_parse_buffer), stream) == NULL) {
-            return EOF;
-        }
-
-        mes_file_parse_len = (int)strlen(mes_file_parse_buffer);
-        if (mes_file_parse_len == 0) {
-            return EOF;
-        }
+    if (mes_file_parse_pos == mes_file_parse_len) {
+        return EOF;
     }
 
     return mes_file_parse_buffer[mes_file_parse_pos++];
@@ -699,20 +718,16 @@ void copy_mes_file_entry(MesFileEntry* dst, MesFileEntry* src, char* str)
  */
 void check_duplicates(MesFile* mes_file)
 {
-    int index1;
-    int index2;
-
-    // NOTE: It seems the Troika developers were in a hurry when writing this
-    // check. This is a quick-and-dirty O(n^2) algorithm, which may be slow for
-    // large files. Since the entries are guaranteed to be sorted, duplicates
-    // should be adjacent, which is O(n).
-    for (index1 = 0; index1 < mes_file->num_entries; index1++) {
-        for (index2 = 0; index2 < index1; index2++) {
-            if (mes_file->entries[index1].num == mes_file->entries[index2].num) {
-                tig_debug_printf("%s: two lines numbered %d\n",
-                    mes_file->path,
-                    mes_file->entries[index1].num);
-            }
+    int index;
+
+    // NOTE: Original code compared every pair of entries, which is O(n^2) and
+    // dominated loading of large files. Since the entries are guaranteed to be
+    // sorted, duplicates are adjacent.
+    for (index = 1; index < mes_file->num_entries; index++) {
+        if (mes_file->entries[index].num == mes_file->entries[index - 1].num) {
+            tig_debug_printf("%s: two lines numbered %d\n",
+                mes_file->path,
+                mes_file->entries[index].num);
         }
     }
 }
@@ -734,3 +749,53 @@ void mes_stats()
         }
     }
 }
+
+/**
+ * Reads the entire message file into the parsing buffer.
+ *
+ * Line endings are normalized to `\n` to match what text-mode reads produce.
+ * NUL characters are handled the way the former line-based reader did: the
+ * rest of the line is dropped, and a line starting with NUL ends the file.
+ */
+void mes_file_read_all(TigFile* stream)
+{
+    int size;
+    int src;
+    int dst;
+    char ch;
+
+    size = tig_file_filelength(stream);
+    if (size <= 0) {
+        return;
+    }
+
+    if (size > mes_file_parse_capacity) {
+        mes_file_parse_capacity = size;
+        mes_file_parse_buffer = (char*)REALLOC(mes_file_parse_buffer, mes_file_parse_capacity);
+    }
+
+    size = (int)tig_file_fread(mes_file_parse_buffer, 1, size, stream);
+
+    dst = 0;
+    for (src = 0; src < size; src++) {
+        ch = mes_file_parse_buffer[src];
+        if (ch == '\0') {
+            if (dst == 0 || mes_file_parse_buffer[dst - 1] == '\n') {
+                break;
+            }
+
+            while (src < size && mes_file_parse_buffer[src] != '\n') {
+                src++;
+            }
+            continue;
+        }
+
+        if (ch == '\r' && src + 1 < size && mes_file_parse_buffer[src + 1] == '\n') {
+            continue;
+        }
+
+        mes_file_parse_buffer[dst++] = ch;
+    }
+
+    mes_file_parse_len = dst;
+}
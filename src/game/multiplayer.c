@@ -2421,11 +2421,11 @@ void multiplayer_anim_ping_handler()
     int index;
     char str[ANIM_ID_STR_SIZE];
 
-    for (index = 0; index < 216; index++) {
-        if ((anim_run_info[index].flags & 0x1) != 0) {
-            if (!anim_goal_restart(&(anim_run_info[index].id))) {
+    for (index = 0; index < anim_run_info_capacity; index++) {
+        if ((anim_run_info_get(index)->flags & 0x1) != 0) {
+            if (!anim_goal_restart(&(anim_run_info_get(index)->id))) {
                 // FIXME: Meaningless.
-                anim_id_to_str(&(anim_run_info[index].id), str);
+                anim_id_to_str(&(anim_run_info_get(index)->id), str);
             }
         }
     }
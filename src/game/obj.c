@@ -2,6 +2,7 @@
 
 #include <inttypes.h>
 
+#include "game/ai.h"
 #include "game/item.h"
 #include "game/obj_file.h"
 #include "game/obj_find.h"
@@ -931,6 +932,7 @@ void obj_deallocate(int64_t obj)
     }
 
     obj_unlock(obj);
+    stat_cache_invalidate(obj);
     obj_pool_deallocate(obj);
 }
 
@@ -959,6 +961,7 @@ void sub_405CC0(int64_t obj)
     }
 
     obj_unlock(obj);
+    stat_cache_invalidate(obj);
     obj_pool_deallocate(obj);
 }
 
@@ -1411,6 +1414,7 @@ bool obj_dif_read(TigFile* stream, int64_t obj)
     }
 
     obj_unlock(obj);
+    stat_cache_invalidate(obj);
 
     if (!objf_read(&marker, sizeof(marker), stream)) {
         tig_debug_println("Error in obj_dif_read:\n  Unable to read the end marker");
@@ -1481,6 +1485,7 @@ void object_field_not_exists(Object* object, int fld)
 void obj_field_int32_set(int64_t obj, int fld, int value)
 {
     Object* object;
+    int old_value = 0;
 
     object = obj_lock(obj);
     if (!object_field_valid(object->type, fld)) {
@@ -1489,8 +1494,15 @@ void obj_field_int32_set(int64_t obj, int fld, int value)
         return;
     }
 
+    // The line of sight cache only cares about a few flag bits.
+    if (fld == OBJ_F_FLAGS || fld == OBJ_F_SPELL_FLAGS) {
+        sub_408A20(object, fld, &old_value);
+    }
+
     sub_408760(object, fld, &value);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
+    ai_los_cache_field_changed(obj, fld, old_value, value);
 }
 
 // 0x406DA0
@@ -1526,6 +1538,7 @@ void obj_field_int64_set(int64_t obj, int fld, int64_t value)
 
     sub_408760(object, fld, &value);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 
     if (fld == OBJ_F_LOCATION) {
         obj_find_move(obj);
@@ -1582,6 +1595,7 @@ void obj_field_handle_set(int64_t obj, int fld, int64_t value)
 
     sub_408760(object, fld, &oid);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 }
 
 // 0x406FB0
@@ -1735,6 +1749,7 @@ void obj_arrayfield_int32_set(int64_t obj, int fld, int index, int value)
 
     sub_4088B0(object, fld, index, &value);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 }
 
 // 0x407470
@@ -1770,6 +1785,7 @@ void obj_arrayfield_uint32_set(int64_t obj, int fld, int index, unsigned int val
 
     sub_4088B0(object, fld, index, &value);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 }
 
 // 0x407540
@@ -1805,6 +1821,7 @@ void obj_arrayfield_int64_set(int64_t obj, int fld, int index, int64_t value)
 
     sub_4088B0(object, fld, index, &value);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 }
 
 // 0x407610
@@ -1892,6 +1909,7 @@ void obj_arrayfield_obj_set(int64_t obj, int fld, int index, int64_t value)
 
     sub_4088B0(object, fld, index, &oid);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 }
 
 // 0x407840
@@ -1991,6 +2009,7 @@ void obj_arrayfield_length_set(int64_t obj, int fld, int length)
 
     sub_408E70(object, fld, length);
     obj_unlock(obj);
+    stat_cache_field_changed(obj, fld);
 }
 
 // 0x407BA0
@@ -1,7 +1,9 @@
 #include "game/obj_find.h"
 
+#include "game/ai.h"
 #include "game/obj.h"
 #include "game/sector.h"
+#include "game/tile.h"
 
 #define OBJ_FIND_BUCKET_SIZE 128
 #define OBJ_FIND_SECTOR_GROW 32
@@ -12,11 +14,23 @@ typedef struct FindNode {
     /* 0010 */ struct FindNode* prev;
     /* 0014 */ struct FindNode* next;
     /* 0018 */ int64_t sec;
+    int cell;
+    int type;
 } FindNode;
 
+/**
+ * Per-cell object type tracking for a `FindSector`, see
+ * `obj_find_sector_has_types`.
+ */
+typedef struct FindSectorCells {
+    unsigned int types[OBJLIST_CELL_COUNT];
+    int counts[OBJLIST_CELL_COUNT][OBJ_TYPE_COUNT];
+} FindSectorCells;
+
 typedef struct FindSector {
     /* 0000 */ int64_t sec;
     /* 0008 */ FindNode* head;
+    FindSectorCells* cells;
 } FindSector;
 
 static void obj_find_node_reserve();
@@ -29,6 +43,9 @@ static void obj_find_sector_reserve();
 static bool obj_find_sector_find(int64_t sec, int* index_ptr);
 static void obj_find_sector_allocate(int64_t sec, FindSector** find_sector_ptr);
 static void obj_find_sector_deallocate(FindSector* find_sector);
+static int obj_find_cell_from_loc(int64_t loc);
+static void obj_find_cell_add(FindSector* find_sector, FindNode* find_node);
+static void obj_find_cell_remove(FindSector* find_sector, FindNode* find_node);
 
 /**
  * A pool of the freed `FindNode` instances for reuse.
@@ -112,6 +129,10 @@ void obj_find_exit()
 
     obj_find_node_clear();
 
+    while (find_sectors_size != 0) {
+        FREE(find_sectors[--find_sectors_size].cells);
+    }
+
     if (find_sectors != NULL) {
         FREE(find_sectors);
     }
@@ -137,12 +158,16 @@ void obj_find_add(int64_t obj)
 
     obj_find_node_allocate(&find_node);
     find_node->obj = obj;
+    find_node->cell = obj_find_cell_from_loc(loc);
+    find_node->type = obj_field_int32_get(obj, OBJ_F_TYPE);
 
     obj_find_sector_allocate(sec, &find_sector);
     obj_find_node_attach(find_sector, find_node);
 
     // Keep reference to the find node.
     obj_field_ptr_set(obj, OBJ_F_FIND_NODE, find_node);
+
+    ai_los_cache_object_changed(obj, find_node->type);
 }
 
 /**
@@ -171,6 +196,8 @@ void obj_find_remove(int64_t obj)
 
     // Detach the node from sector and deallocate it (returning to the free
     // pool).
+    ai_los_cache_object_changed(obj, find_node->type);
+
     obj_find_node_detach(find_node);
     obj_find_node_deallocate(find_node);
 
@@ -187,12 +214,15 @@ void obj_find_move(int64_t obj)
 {
     int64_t loc;
     int64_t sec;
+    int cell;
+    int index;
     FindNode* find_node;
     FindSector* find_sector;
 
     // Retrieve the new object's location/sector.
     loc = obj_field_int64_get(obj, OBJ_F_LOCATION);
     sec = sector_id_from_loc(loc);
+    cell = obj_find_cell_from_loc(loc);
 
     // Retrieve the object's find node.
     find_node = (FindNode*)obj_field_ptr_get(obj, OBJ_F_FIND_NODE);
@@ -212,14 +242,24 @@ void obj_find_move(int64_t obj)
         return;
     }
 
+    ai_los_cache_object_changed(obj, find_node->type);
+
     // Move the node to a new sector if the sector has changed.
     if (find_node->sec != sec) {
         // Detach from old sector.
         obj_find_node_detach(find_node);
 
         // Attach to the new sector.
+        find_node->cell = cell;
         obj_find_sector_allocate(sec, &find_sector);
         obj_find_node_attach(find_sector, find_node);
+    } else if (find_node->cell != cell) {
+        // Same sector, only update cell tracking.
+        if (obj_find_sector_find(sec, &index)) {
+            obj_find_cell_remove(&(find_sectors[index]), find_node);
+            find_node->cell = cell;
+            obj_find_cell_add(&(find_sectors[index]), find_node);
+        }
     }
 }
 
@@ -268,6 +308,95 @@ bool obj_find_walk_next(int64_t* obj_ptr, FindNode** iter_ptr)
     }
 }
 
+/**
+ * Initiates iteration over objects of the specified types within the given
+ * tile rectangle (sector-relative, inclusive) of a sector.
+ *
+ * Objects are rejected by their type and 8x8 cell without reading any object
+ * fields, so the results may still contain objects in the cells overlapping
+ * the rectangle edges. `types` is a set of `OBJ_TM_xxx` flags.
+ */
+bool obj_find_walk_rect_first(int64_t sec, int x1, int y1, int x2, int y2, unsigned int types, int64_t* obj_ptr, FindNode** iter_ptr)
+{
+    int index;
+
+    if (!obj_find_sector_find(sec, &index)) {
+        *obj_ptr = OBJ_HANDLE_NULL;
+        return false;
+    }
+
+    *iter_ptr = find_sectors[index].head;
+
+    return obj_find_walk_rect_next(x1, y1, x2, y2, types, obj_ptr, iter_ptr);
+}
+
+/**
+ * Continues iteration started with `obj_find_walk_rect_first`, the filter
+ * must be the same.
+ */
+bool obj_find_walk_rect_next(int x1, int y1, int x2, int y2, unsigned int types, int64_t* obj_ptr, FindNode** iter_ptr)
+{
+    FindNode* node;
+    int cx;
+    int cy;
+
+    x1 /= OBJLIST_CELL_SIZE;
+    y1 /= OBJLIST_CELL_SIZE;
+    x2 /= OBJLIST_CELL_SIZE;
+    y2 /= OBJLIST_CELL_SIZE;
+
+    for (node = *iter_ptr; node != NULL; node = node->next) {
+        if ((types & (1u << node->type)) == 0) {
+            continue;
+        }
+
+        cx = node->cell % OBJLIST_CELLS_PER_ROW;
+        cy = node->cell / OBJLIST_CELLS_PER_ROW;
+        if (cx < x1 || cx > x2 || cy < y1 || cy > y2) {
+            continue;
+        }
+
+        *obj_ptr = node->obj;
+        *iter_ptr = node->next;
+        return true;
+    }
+
+    *obj_ptr = OBJ_HANDLE_NULL;
+    *iter_ptr = NULL;
+    return false;
+}
+
+/**
+ * Checks whether a sector may contain objects of the specified types within
+ * the given tile rectangle (sector-relative, inclusive).
+ *
+ * `types` is a set of `OBJ_TM_xxx` flags. Returns `false` only when no
+ * tracked object can match, so callers can skip walking the sector.
+ */
+bool obj_find_sector_has_types(int64_t sec, int x1, int y1, int x2, int y2, unsigned int types)
+{
+    int index;
+    int cx;
+    int cy;
+    FindSectorCells* cells;
+
+    if (!obj_find_sector_find(sec, &index)) {
+        return false;
+    }
+
+    cells = find_sectors[index].cells;
+
+    for (cy = y1 / OBJLIST_CELL_SIZE; cy <= y2 / OBJLIST_CELL_SIZE; cy++) {
+        for (cx = x1 / OBJLIST_CELL_SIZE; cx <= x2 / OBJLIST_CELL_SIZE; cx++) {
+            if ((cells->types[cy * OBJLIST_CELLS_PER_ROW + cx] & types) != 0) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 /**
  * Allocates a new bucket of `FindNode` instances and adds them to the free
  * list.
@@ -364,6 +493,7 @@ void obj_find_node_attach(FindSector* find_sector, FindNode* find_node)
     }
     find_sector->head = find_node;
     find_node->sec = find_sector->sec;
+    obj_find_cell_add(find_sector, find_node);
 }
 
 /**
@@ -382,6 +512,7 @@ void obj_find_node_detach(FindNode* find_node)
     }
 
     find_sector = &(find_sectors[index]);
+    obj_find_cell_remove(find_sector, find_node);
 
     if (find_node->next != NULL) {
         find_node->next->prev = find_node->prev;
@@ -477,6 +608,7 @@ void obj_find_sector_allocate(int64_t sec, FindSector** find_sector_ptr)
     *find_sector_ptr = &(find_sectors[index]);
     (*find_sector_ptr)->sec = sec;
     (*find_sector_ptr)->head = NULL;
+    (*find_sector_ptr)->cells = (FindSectorCells*)CALLOC(1, sizeof(FindSectorCells));
 
     find_sectors_size++;
 }
@@ -493,6 +625,8 @@ void obj_find_sector_deallocate(FindSector* find_sector)
     // Calculate the index of the element in array.
     index = find_sector - find_sectors;
 
+    FREE(find_sector->cells);
+
     // Shift remaining sectors to fill the gap.
     if (find_sectors_size - index != 1) {
         memmove(&(find_sectors[index]),
@@ -502,3 +636,41 @@ void obj_find_sector_deallocate(FindSector* find_sector)
 
     find_sectors_size--;
 }
+
+/**
+ * Returns the sector cell containing the specified location.
+ */
+int obj_find_cell_from_loc(int64_t loc)
+{
+    int tile;
+
+    tile = tile_id_from_loc(loc);
+
+    return OBJLIST_CELL_OF_TILE(tile);
+}
+
+/**
+ * Accounts a find node in its sector's cell tracking.
+ */
+void obj_find_cell_add(FindSector* find_sector, FindNode* find_node)
+{
+    FindSectorCells* cells;
+
+    cells = find_sector->cells;
+    if (cells->counts[find_node->cell][find_node->type]++ == 0) {
+        cells->types[find_node->cell] |= 1u << find_node->type;
+    }
+}
+
+/**
+ * Removes a find node from its sector's cell tracking.
+ */
+void obj_find_cell_remove(FindSector* find_sector, FindNode* find_node)
+{
+    FindSectorCells* cells;
+
+    cells = find_sector->cells;
+    if (--cells->counts[find_node->cell][find_node->type] == 0) {
+        cells->types[find_node->cell] &= ~(1u << find_node->type);
+    }
+}
@@ -12,5 +12,8 @@ void obj_find_remove(int64_t obj);
 void obj_find_move(int64_t obj);
 bool obj_find_walk_first(int64_t sec, int64_t* obj_ptr, FindNode** iter_ptr);
 bool obj_find_walk_next(int64_t* obj_ptr, FindNode** iter_ptr);
+bool obj_find_walk_rect_first(int64_t sec, int x1, int y1, int x2, int y2, unsigned int types, int64_t* obj_ptr, FindNode** iter_ptr);
+bool obj_find_walk_rect_next(int x1, int y1, int x2, int y2, unsigned int types, int64_t* obj_ptr, FindNode** iter_ptr);
+bool obj_find_sector_has_types(int64_t sec, int x1, int y1, int x2, int y2, unsigned int types);
 
 #endif /* ARCANUM_GAME_OBJ_FIND_H_ */
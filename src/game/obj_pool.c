@@ -17,6 +17,13 @@
 #define STATUS_HANDLE 'H'
 #define STATUS_RELEASED 'P'
 
+#define OBJP_PERM_LOOKUP_MIN_SLOTS 2048
+
+// Reverse index slot states, entry indexes are stored biased by one.
+#define OBJP_PERM_OBJ_SLOT_EMPTY 0
+#define OBJP_PERM_OBJ_SLOT_NONE (-1)
+#define OBJP_PERM_OBJ_SLOT_DIRTY (-2)
+
 typedef struct ObjPoolEntryHeader {
     int status : 8;
     int seq : 24;
@@ -27,11 +34,25 @@ typedef struct PermOidLookupEntry {
     /* 0018 */ int64_t obj;
 } PermOidLookupEntry;
 
+typedef struct PermOidObjSlot {
+    int64_t obj;
+    int index;
+    int head;
+} PermOidObjSlot;
+
 static int acquire_index();
 static void release_index(int index);
 static bool grow_pool();
 static void recycle_index(int index);
 static bool objp_perm_lookup_find_index(ObjectID oid, int* index_ptr);
+static unsigned int objp_perm_lookup_oid_hash(const ObjectID* oid);
+static void objp_perm_lookup_add_oid(int index);
+static void objp_perm_lookup_rebuild_oids(int capacity);
+static int objp_perm_lookup_obj_slot(int64_t obj);
+static void objp_perm_lookup_bind_obj(int index);
+static void objp_perm_lookup_bind_obj_slot(int index);
+static void objp_perm_lookup_unbind_obj(int index);
+static void objp_perm_lookup_rebuild_objs(int capacity);
 static int64_t make_handle(int index, int seq);
 static int index_from_handle(int64_t obj);
 static ObjPoolEntryHeader* element_hdr_at_index(int index);
@@ -93,6 +114,63 @@ static int64_t obj_handle_requested;
 // 0x6036F8
 static bool obj_pool_initialized;
 
+/**
+ * Open-addressing index over `objp_perm_lookup_table` keyed by object ID.
+ * Each slot holds an entry index biased by one, zero marks an empty slot.
+ */
+static int* objp_perm_lookup_oid_slots;
+
+static int objp_perm_lookup_oid_slots_capacity;
+
+/**
+ * Open-addressing reverse index keyed by object handle. Each slot points to
+ * the entry with the smallest object ID (in `objid_compare` order) bound to
+ * that handle, which is what the original linear scan used to return.
+ */
+static PermOidObjSlot* objp_perm_lookup_obj_slots;
+
+static int objp_perm_lookup_obj_slots_capacity;
+
+static int objp_perm_lookup_obj_slots_size;
+
+/**
+ * Links entries bound to the same handle, starting from `head` of its reverse
+ * index slot and terminated with -1. Sized as `objp_perm_lookup_table`.
+ */
+static int* objp_perm_lookup_next;
+
+static inline uint64_t objp_perm_lookup_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Matches the equivalence implied by `objid_compare` - IDs of other types
+// are considered equal when their types match.
+static inline bool objp_perm_lookup_oid_is_equal(const ObjectID* a, const ObjectID* b)
+{
+    if (a->type != b->type) {
+        return false;
+    }
+
+    switch (a->type) {
+    case OID_TYPE_A:
+        return a->d.a == b->d.a;
+    case OID_TYPE_GUID:
+        return memcmp(a->d.g.data, b->d.g.data, sizeof(a->d.g.data)) == 0;
+    case OID_TYPE_P:
+        return a->d.p.location == b->d.p.location
+            && a->d.p.temp_id == b->d.p.temp_id
+            && a->d.p.map == b->d.p.map;
+    }
+
+    return true;
+}
+
 // 0x4E4CD0
 void obj_pool_init(int size, bool editor)
 {
@@ -113,6 +191,9 @@ void obj_pool_init(int size, bool editor)
     objp_perm_lookup_size = 0;
     obj_handle_requested = OBJ_HANDLE_NULL;
     objp_perm_lookup_table = (PermOidLookupEntry*)MALLOC(sizeof(*objp_perm_lookup_table) * objp_perm_lookup_capacity);
+    objp_perm_lookup_next = (int*)MALLOC(sizeof(*objp_perm_lookup_next) * objp_perm_lookup_capacity);
+    objp_perm_lookup_rebuild_oids(OBJP_PERM_LOOKUP_MIN_SLOTS);
+    objp_perm_lookup_rebuild_objs(OBJP_PERM_LOOKUP_MIN_SLOTS);
     obj_pool_initialized = true;
 }
 
@@ -142,6 +223,15 @@ void obj_pool_exit()
 
     FREE(obj_pool_freed_indexes);
     FREE(objp_perm_lookup_table);
+    FREE(objp_perm_lookup_next);
+    objp_perm_lookup_next = NULL;
+    FREE(objp_perm_lookup_oid_slots);
+    objp_perm_lookup_oid_slots = NULL;
+    objp_perm_lookup_oid_slots_capacity = 0;
+    FREE(objp_perm_lookup_obj_slots);
+    objp_perm_lookup_obj_slots = NULL;
+    objp_perm_lookup_obj_slots_capacity = 0;
+    objp_perm_lookup_obj_slots_size = 0;
     FREE(obj_pool_buckets);
     obj_pool_initialized = false;
 }
@@ -212,28 +302,36 @@ void objp_perm_lookup_set(ObjectID oid, int64_t obj)
     int index;
 
     if (objp_perm_lookup_find_index(oid, &index)) {
-        objp_perm_lookup_table[index].obj = obj;
+        if (objp_perm_lookup_table[index].obj != obj) {
+            objp_perm_lookup_unbind_obj(index);
+            objp_perm_lookup_table[index].obj = obj;
+            objp_perm_lookup_bind_obj(index);
+        }
         return;
     }
 
     if (objp_perm_lookup_size == objp_perm_lookup_capacity) {
-        objp_perm_lookup_capacity += 0x200;
-        if (objp_perm_lookup_capacity > OBJ_POOL_CAP) {
+        if (objp_perm_lookup_capacity >= OBJ_POOL_CAP) {
             return;
         }
 
-        objp_perm_lookup_table = (PermOidLookupEntry*)REALLOC(objp_perm_lookup_table, sizeof(*objp_perm_lookup_table) * objp_perm_lookup_capacity);
-    }
+        // Grow geometrically, growing by a fixed step made populating large
+        // worlds quadratic.
+        objp_perm_lookup_capacity *= 2;
+        if (objp_perm_lookup_capacity > OBJ_POOL_CAP) {
+            objp_perm_lookup_capacity = OBJ_POOL_CAP;
+        }
 
-    if (index != objp_perm_lookup_size) {
-        memmove(&(objp_perm_lookup_table[index + 1]),
-            &(objp_perm_lookup_table[index]),
-            sizeof(*objp_perm_lookup_table) * (objp_perm_lookup_size - index));
+        objp_perm_lookup_table = (PermOidLookupEntry*)REALLOC(objp_perm_lookup_table, sizeof(*objp_perm_lookup_table) * objp_perm_lookup_capacity);
+        objp_perm_lookup_next = (int*)REALLOC(objp_perm_lookup_next, sizeof(*objp_perm_lookup_next) * objp_perm_lookup_capacity);
     }
 
     objp_perm_lookup_table[index].oid = oid;
     objp_perm_lookup_table[index].obj = obj;
     objp_perm_lookup_size++;
+
+    objp_perm_lookup_add_oid(index);
+    objp_perm_lookup_bind_obj(index);
 }
 
 // 0x4E50E0
@@ -297,12 +395,26 @@ int64_t objp_perm_lookup(ObjectID oid)
 ObjectID objp_perm_get_oid(int64_t obj)
 {
     ObjectID oid;
+    PermOidObjSlot* slot;
     int index;
-
-    for (index = 0; index < objp_perm_lookup_size; index++) {
-        if (objp_perm_lookup_table[index].obj == obj) {
-            return objp_perm_lookup_table[index].oid;
+    int best;
+
+    slot = &(objp_perm_lookup_obj_slots[objp_perm_lookup_obj_slot(obj)]);
+    if (slot->index == OBJP_PERM_OBJ_SLOT_DIRTY) {
+        // The entry this handle resolved to was rebound to another handle,
+        // pick the next best match among the remaining ones.
+        best = -1;
+        for (index = slot->head; index != -1; index = objp_perm_lookup_next[index]) {
+            if (best == -1 || objid_compare(objp_perm_lookup_table[index].oid, objp_perm_lookup_table[best].oid)) {
+                best = index;
+            }
         }
+
+        slot->index = best != -1 ? best + 1 : OBJP_PERM_OBJ_SLOT_NONE;
+    }
+
+    if (slot->index > 0) {
+        return objp_perm_lookup_table[slot->index - 1].oid;
     }
 
     oid.type = OID_TYPE_NULL;
@@ -342,6 +454,9 @@ void objp_perm_lookup_compact()
     memcpy(objp_perm_lookup_table, &(v1[v3 + 1]), sizeof(*objp_perm_lookup_table) * cnt);
     FREE(v1);
     objp_perm_lookup_size = cnt;
+
+    objp_perm_lookup_rebuild_oids(objp_perm_lookup_oid_slots_capacity);
+    objp_perm_lookup_rebuild_objs(objp_perm_lookup_obj_slots_capacity);
 }
 
 // 0x4E53C0
@@ -550,26 +665,22 @@ void recycle_index(int index)
 // 0x4E57E0
 bool objp_perm_lookup_find_index(ObjectID oid, int* index_ptr)
 {
-    int l;
-    int r;
-    int m;
-
-    l = 0;
-    r = objp_perm_lookup_size - 1;
-    while (l <= r) {
-        m = (l + r) / 2;
-        // FIXME: Unnecessary copying.
-        if (objid_compare(objp_perm_lookup_table[m].oid, oid)) {
-            l = m + 1;
-        } else if (objid_compare(oid, objp_perm_lookup_table[m].oid)) {
-            r = m - 1;
-        } else {
-            *index_ptr = m;
+    unsigned int mask;
+    unsigned int slot;
+    int entry;
+
+    mask = (unsigned int)objp_perm_lookup_oid_slots_capacity - 1;
+    slot = objp_perm_lookup_oid_hash(&oid) & mask;
+    while ((entry = objp_perm_lookup_oid_slots[slot]) != 0) {
+        if (objp_perm_lookup_oid_is_equal(&(objp_perm_lookup_table[entry - 1].oid), &oid)) {
+            *index_ptr = entry - 1;
             return true;
         }
+        slot = (slot + 1) & mask;
     }
 
-    *index_ptr = l;
+    // Entries are no longer kept sorted, new ones are appended.
+    *index_ptr = objp_perm_lookup_size;
     return false;
 }
 
@@ -612,3 +723,177 @@ int sequence_from_hdr(ObjPoolEntryHeader* hdr)
 {
     return hdr->seq;
 }
+
+unsigned int objp_perm_lookup_oid_hash(const ObjectID* oid)
+{
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t h;
+
+    switch (oid->type) {
+    case OID_TYPE_A:
+        h = (uint64_t)(uint32_t)oid->d.a;
+        break;
+    case OID_TYPE_GUID:
+        memcpy(&lo, &(oid->d.g.data[0]), sizeof(lo));
+        memcpy(&hi, &(oid->d.g.data[8]), sizeof(hi));
+        h = lo ^ objp_perm_lookup_mix(hi);
+        break;
+    case OID_TYPE_P:
+        h = (uint64_t)oid->d.p.location
+            ^ objp_perm_lookup_mix(((uint64_t)(uint32_t)oid->d.p.temp_id << 32) | (uint32_t)oid->d.p.map);
+        break;
+    default:
+        h = 0;
+        break;
+    }
+
+    return (unsigned int)objp_perm_lookup_mix(h + (uint64_t)(uint16_t)oid->type);
+}
+
+void objp_perm_lookup_add_oid(int index)
+{
+    unsigned int mask;
+    unsigned int slot;
+
+    if (objp_perm_lookup_size * 2 > objp_perm_lookup_oid_slots_capacity) {
+        // Rebuild picks up the new entry as well.
+        objp_perm_lookup_rebuild_oids(objp_perm_lookup_oid_slots_capacity * 2);
+        return;
+    }
+
+    mask = (unsigned int)objp_perm_lookup_oid_slots_capacity - 1;
+    slot = objp_perm_lookup_oid_hash(&(objp_perm_lookup_table[index].oid)) & mask;
+    while (objp_perm_lookup_oid_slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    objp_perm_lookup_oid_slots[slot] = index + 1;
+}
+
+void objp_perm_lookup_rebuild_oids(int capacity)
+{
+    unsigned int mask;
+    unsigned int slot;
+    int index;
+
+    while (capacity < objp_perm_lookup_size * 2) {
+        capacity *= 2;
+    }
+
+    if (objp_perm_lookup_oid_slots != NULL) {
+        FREE(objp_perm_lookup_oid_slots);
+    }
+    objp_perm_lookup_oid_slots = (int*)CALLOC(capacity, sizeof(*objp_perm_lookup_oid_slots));
+    objp_perm_lookup_oid_slots_capacity = capacity;
+
+    mask = (unsigned int)capacity - 1;
+    for (index = 0; index < objp_perm_lookup_size; index++) {
+        slot = objp_perm_lookup_oid_hash(&(objp_perm_lookup_table[index].oid)) & mask;
+        while (objp_perm_lookup_oid_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        objp_perm_lookup_oid_slots[slot] = index + 1;
+    }
+}
+
+int objp_perm_lookup_obj_slot(int64_t obj)
+{
+    unsigned int mask;
+    unsigned int slot;
+
+    mask = (unsigned int)objp_perm_lookup_obj_slots_capacity - 1;
+    slot = (unsigned int)objp_perm_lookup_mix((uint64_t)obj) & mask;
+    while (objp_perm_lookup_obj_slots[slot].index != OBJP_PERM_OBJ_SLOT_EMPTY
+        && objp_perm_lookup_obj_slots[slot].obj != obj) {
+        slot = (slot + 1) & mask;
+    }
+
+    return (int)slot;
+}
+
+void objp_perm_lookup_bind_obj(int index)
+{
+    if ((objp_perm_lookup_obj_slots_size + 1) * 2 > objp_perm_lookup_obj_slots_capacity) {
+        // Rebuilding from the live entries also drops handles left behind by
+        // rebinds, so only grow when those are not the bulk of the index.
+        if (objp_perm_lookup_obj_slots_size > objp_perm_lookup_size * 2) {
+            objp_perm_lookup_rebuild_objs(objp_perm_lookup_obj_slots_capacity);
+        } else {
+            objp_perm_lookup_rebuild_objs(objp_perm_lookup_obj_slots_capacity * 2);
+        }
+        return;
+    }
+
+    objp_perm_lookup_bind_obj_slot(index);
+}
+
+void objp_perm_lookup_bind_obj_slot(int index)
+{
+    PermOidObjSlot* slot;
+
+    slot = &(objp_perm_lookup_obj_slots[objp_perm_lookup_obj_slot(objp_perm_lookup_table[index].obj)]);
+    if (slot->index == OBJP_PERM_OBJ_SLOT_EMPTY) {
+        slot->obj = objp_perm_lookup_table[index].obj;
+        slot->head = -1;
+        objp_perm_lookup_obj_slots_size++;
+    }
+
+    objp_perm_lookup_next[index] = slot->head;
+    slot->head = index;
+
+    switch (slot->index) {
+    case OBJP_PERM_OBJ_SLOT_EMPTY:
+        slot->index = index + 1;
+        break;
+    case OBJP_PERM_OBJ_SLOT_NONE:
+        slot->index = index + 1;
+        break;
+    case OBJP_PERM_OBJ_SLOT_DIRTY:
+        // Resolved on the next `objp_perm_get_oid`.
+        break;
+    default:
+        if (objid_compare(objp_perm_lookup_table[index].oid, objp_perm_lookup_table[slot->index - 1].oid)) {
+            slot->index = index + 1;
+        }
+        break;
+    }
+}
+
+void objp_perm_lookup_unbind_obj(int index)
+{
+    PermOidObjSlot* slot;
+    int* link;
+
+    slot = &(objp_perm_lookup_obj_slots[objp_perm_lookup_obj_slot(objp_perm_lookup_table[index].obj)]);
+
+    link = &(slot->head);
+    while (*link != index) {
+        link = &(objp_perm_lookup_next[*link]);
+    }
+    *link = objp_perm_lookup_next[index];
+
+    if (slot->index == index + 1) {
+        slot->index = OBJP_PERM_OBJ_SLOT_DIRTY;
+    }
+}
+
+void objp_perm_lookup_rebuild_objs(int capacity)
+{
+    int index;
+
+    while (capacity < (objp_perm_lookup_size + 1) * 2) {
+        capacity *= 2;
+    }
+
+    if (objp_perm_lookup_obj_slots != NULL) {
+        FREE(objp_perm_lookup_obj_slots);
+    }
+    objp_perm_lookup_obj_slots = (PermOidObjSlot*)CALLOC(capacity, sizeof(*objp_perm_lookup_obj_slots));
+    objp_perm_lookup_obj_slots_capacity = capacity;
+    objp_perm_lookup_obj_slots_size = 0;
+
+    for (index = 0; index < objp_perm_lookup_size; index++) {
+        objp_perm_lookup_bind_obj_slot(index);
+    }
+}
@@ -3346,10 +3346,17 @@ void object_list_location(int64_t loc, unsigned int flags, ObjectList* objects)
         || sub_4D04E0(sector_id)) {
         if (sector_lock(sector_id, &sector)) {
             ObjectNode* node;
+            int tile;
 
             objects->sectors[objects->num_sectors++] = sector_id;
 
-            node = sector->objects.heads[tile_id_from_loc(loc)];
+            tile = tile_id_from_loc(loc);
+
+            // Skip the tile entirely if its cell has no objects of requested
+            // types.
+            node = (sector->objects.cell_types[OBJLIST_CELL_OF_TILE(tile)] & flags) != 0
+                ? sector->objects.heads[tile]
+                : NULL;
             while (node != NULL) {
                 if ((dword_5E2F88 & obj_field_int32_get(node->obj, OBJ_F_FLAGS)) == 0
                     && types[obj_field_int32_get(node->obj, OBJ_F_TYPE)]) {
@@ -3366,8 +3373,12 @@ void object_list_location(int64_t loc, unsigned int flags, ObjectList* objects)
     } else {
         int64_t obj;
         FindNode* iter;
+        int tile;
+
+        tile = tile_id_from_loc(loc);
 
-        if (obj_find_walk_first(sector_id, &obj, &iter)) {
+        if (obj_find_sector_has_types(sector_id, TILE_X(tile), TILE_Y(tile), TILE_X(tile), TILE_Y(tile), flags)
+            && obj_find_walk_first(sector_id, &obj, &iter)) {
             do {
                 if (!object_is_static_type(obj)
                     && (obj_field_int32_get(obj, OBJ_F_FLAGS) & OF_INVENTORY) == 0
@@ -3444,7 +3455,27 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
             v2 = &(v1.field_8[col]);
 
             for (row = 0; row < v2->width; row++) {
-                if (obj_find_walk_first(v2->field_20[row], &obj, &iter)) {
+                // Skip sectors without objects of requested types in the
+                // covered part.
+                if (!obj_find_sector_has_types(v2->field_20[row],
+                        TILE_X(v2->field_38[row]),
+                        TILE_Y(v2->field_38[row]),
+                        TILE_X(v2->field_38[row]) + v2->field_44[row] - 1,
+                        TILE_Y(v2->field_38[row]) + v2->field_50 - 1,
+                        flags)) {
+                    continue;
+                }
+
+                // Reject objects by type and cell before touching their
+                // fields.
+                if (obj_find_walk_rect_first(v2->field_20[row],
+                        TILE_X(v2->field_38[row]),
+                        TILE_Y(v2->field_38[row]),
+                        TILE_X(v2->field_38[row]) + v2->field_44[row] - 1,
+                        TILE_Y(v2->field_38[row]) + v2->field_50 - 1,
+                        flags,
+                        &obj,
+                        &iter)) {
                     do {
                         if (!object_is_static_type(obj)
                             && (obj_field_int32_get(obj, OBJ_F_FLAGS) & OF_INVENTORY) == 0
@@ -3462,7 +3493,13 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
                                 prev_ptr = &(new_node->next);
                             }
                         }
-                    } while (obj_find_walk_next(&obj, &iter));
+                    } while (obj_find_walk_rect_next(TILE_X(v2->field_38[row]),
+                        TILE_Y(v2->field_38[row]),
+                        TILE_X(v2->field_38[row]) + v2->field_44[row] - 1,
+                        TILE_Y(v2->field_38[row]) + v2->field_50 - 1,
+                        flags,
+                        &obj,
+                        &iter));
                 }
             }
         }
@@ -3484,7 +3521,9 @@ void object_list_rect(LocRect* loc_rect, unsigned int flags, ObjectList* objects
                 for (row = 0; row < v2->width; row++) {
                     if (locks[row]) {
                         for (v4 = 0; v4 < v2->field_44[row]; v4++) {
-                            obj_node = sectors[row]->objects.heads[indexes[row]];
+                            obj_node = (sectors[row]->objects.cell_types[OBJLIST_CELL_OF_TILE(indexes[row])] & flags) != 0
+                                ? sectors[row]->objects.heads[indexes[row]]
+                                : NULL;
                             while (obj_node != NULL) {
                                 if ((dword_5E2F88 & obj_field_int32_get(obj_node->obj, OBJ_F_FLAGS)) == 0
                                     && types[obj_field_int32_get(obj_node->obj, OBJ_F_TYPE)]) {
@@ -3549,16 +3588,9 @@ void object_list_vicinity_loc(int64_t loc, unsigned int flags, ObjectList* objec
 // 0x4410E0
 void object_list_destroy(ObjectList* objects)
 {
-    ObjectNode* node;
-    ObjectNode* next;
     int index;
 
-    node = objects->head;
-    while (node != NULL) {
-        next = node->next;
-        object_node_destroy(node);
-        node = next;
-    }
+    object_node_destroy_list(objects->head);
 
     for (index = 0; index < objects->num_sectors; index++) {
         sector_unlock(objects->sectors[index]);
@@ -1,6 +1,7 @@
 #include "game/object_node.h"
 
-#define OBJECT_NODE_LIST_GROW_SIZE 64
+// Number of nodes carved from a single allocation.
+#define OBJECT_NODE_SLAB_SIZE 256
 
 static void object_node_reserve();
 static void object_node_remove_all();
@@ -8,10 +9,31 @@ static void object_node_remove_all();
 /**
  * A pool of the free `ObjectNode` instances for reuse.
  *
+ * The pool is a stack of chains so that whole lists can be released in
+ * constant time. Nodes within a chain are linked via `next`, the `obj` field
+ * of the first node in a chain holds the pointer to the next chain.
+ *
  * 0x603AC0
  */
 static ObjectNode* object_node_head;
 
+/**
+ * Slabs backing all `ObjectNode` instances.
+ */
+static ObjectNode** object_node_slabs;
+
+/**
+ * Number of elements in `object_node_slabs` array.
+ */
+static int object_node_slabs_size;
+
+/**
+ * The maximum number of elements in `object_node_slabs` array.
+ */
+static int object_node_slabs_capacity;
+
+static ObjectNodeStats object_node_stats_data;
+
 /**
  * Called when the game is initialized.
  *
@@ -50,9 +72,18 @@ ObjectNode* object_node_create()
         node = object_node_head;
     }
 
-    object_node_head = node->next;
+    if (node->next != NULL) {
+        // Pass the link to the next chain on to the new chain head.
+        node->next->obj = node->obj;
+        object_node_head = node->next;
+    } else {
+        object_node_head = (ObjectNode*)(intptr_t)node->obj;
+    }
+
     node->next = NULL;
 
+    object_node_stats_data.allocations++;
+
     return node;
 }
 
@@ -63,8 +94,47 @@ ObjectNode* object_node_create()
  */
 void object_node_destroy(ObjectNode* node)
 {
+    node->obj = object_node_head != NULL ? object_node_head->obj : 0;
     node->next = object_node_head;
     object_node_head = node;
+
+    object_node_stats_data.releases++;
+}
+
+/**
+ * Returns a whole chain of `ObjectNode` instances (linked via `next` and
+ * terminated with `NULL`) to the free pool in constant time.
+ */
+void object_node_destroy_list(ObjectNode* head)
+{
+    if (head == NULL) {
+        return;
+    }
+
+    head->obj = (int64_t)(intptr_t)object_node_head;
+    object_node_head = head;
+
+    object_node_stats_data.list_releases++;
+}
+
+/**
+ * Retrieves object node pool counters.
+ */
+void object_node_stats(ObjectNodeStats* stats)
+{
+    *stats = object_node_stats_data;
+}
+
+/**
+ * Resets object node pool activity counters.
+ *
+ * Slab counters reflect the current pool size and are kept.
+ */
+void object_node_reset_stats()
+{
+    object_node_stats_data.allocations = 0;
+    object_node_stats_data.releases = 0;
+    object_node_stats_data.list_releases = 0;
 }
 
 /**
@@ -75,17 +145,31 @@ void object_node_destroy(ObjectNode* node)
 void object_node_reserve()
 {
     int index;
-    ObjectNode* node;
+    ObjectNode* slab;
 
     if (object_node_head != NULL) {
         return;
     }
 
-    for (index = 0; index < OBJECT_NODE_LIST_GROW_SIZE; index++) {
-        node = (ObjectNode*)MALLOC(sizeof(*node));
-        node->next = object_node_head;
-        object_node_head = node;
+    if (object_node_slabs_size == object_node_slabs_capacity) {
+        object_node_slabs_capacity = object_node_slabs_capacity != 0 ? object_node_slabs_capacity * 2 : 16;
+        object_node_slabs = (ObjectNode**)REALLOC(object_node_slabs, sizeof(*object_node_slabs) * object_node_slabs_capacity);
+    }
+
+    slab = (ObjectNode*)MALLOC(sizeof(*slab) * OBJECT_NODE_SLAB_SIZE);
+    object_node_slabs[object_node_slabs_size++] = slab;
+
+    // Link the slab into a single chain.
+    for (index = 0; index < OBJECT_NODE_SLAB_SIZE - 1; index++) {
+        slab[index].next = &(slab[index + 1]);
     }
+    slab[OBJECT_NODE_SLAB_SIZE - 1].next = NULL;
+    slab[0].obj = 0;
+
+    object_node_head = slab;
+
+    object_node_stats_data.slabs++;
+    object_node_stats_data.capacity += OBJECT_NODE_SLAB_SIZE;
 }
 
 /**
@@ -95,11 +179,16 @@ void object_node_reserve()
  */
 void object_node_remove_all()
 {
-    ObjectNode* next;
+    while (object_node_slabs_size != 0) {
+        FREE(object_node_slabs[--object_node_slabs_size]);
+    }
 
-    while (object_node_head != NULL) {
-        next = object_node_head->next;
-        FREE(object_node_head);
-        object_node_head = next;
+    if (object_node_slabs != NULL) {
+        FREE(object_node_slabs);
+        object_node_slabs = NULL;
     }
+
+    object_node_slabs_capacity = 0;
+    object_node_head = NULL;
+    memset(&object_node_stats_data, 0, sizeof(object_node_stats_data));
 }
@@ -8,9 +8,31 @@ typedef struct ObjectNode {
     /* 0004 */ struct ObjectNode* next;
 } ObjectNode;
 
+// Object node pool counters, see `object_node_stats`.
+typedef struct ObjectNodeStats {
+    // Number of nodes handed out by `object_node_create`.
+    unsigned int allocations;
+
+    // Number of nodes returned one by one with `object_node_destroy`.
+    unsigned int releases;
+
+    // Number of whole lists returned with `object_node_destroy_list`.
+    unsigned int list_releases;
+
+    // Number of slabs allocated.
+    unsigned int slabs;
+
+    // Number of nodes backed by slabs. Nodes are kept until exit, so this is
+    // the high-water mark of nodes in use rounded up to the slab size.
+    unsigned int capacity;
+} ObjectNodeStats;
+
 bool object_node_init(GameInitInfo* init_info);
 void object_node_exit();
 ObjectNode* object_node_create();
 void object_node_destroy(ObjectNode* node);
+void object_node_destroy_list(ObjectNode* head);
+void object_node_stats(ObjectNodeStats* stats);
+void object_node_reset_stats();
 
 #endif /* ARCANUM_GAME_OBJECT_NODE_H_ */
@@ -1,8 +1,10 @@
 #include "game/path.h"
 
+#include "game/a_name.h"
 #include "game/critter.h"
 #include "game/location.h"
 #include "game/object.h"
+#include "game/player.h"
 #include "game/sector.h"
 #include "game/terrain.h"
 #include "game/tile.h"
@@ -19,9 +21,84 @@ typedef struct S420330 {
     /* 0020 */ uint8_t* rotations;
 } S420330;
 
+// Number of sectors which can have their cluster data cached at once.
+#define PATH_CLUSTER_CACHE_SIZE 128
+
+// Maximum number of border entrances of a single cluster (each border tile
+// can be an entrance at most once).
+#define PATH_CLUSTER_MAX_ENTRANCES 256
+
+// Border runs longer than this get an entrance at each end rather than a
+// single one in the middle.
+#define PATH_CLUSTER_LONG_RUN 16
+
+// Maximum distance (in sectors, along each axis) between the sectors of the
+// start and the goal of a hierarchical search.
+#define PATH_HPA_MAX_SECTOR_SPAN 4
+
+// Number of sectors around the start and goal sectors the abstract search is
+// allowed to detour through.
+#define PATH_HPA_SECTOR_MARGIN 1
+
+#define PATH_HPA_MAX_NODES 2048
+#define PATH_HPA_HASH_SIZE 4096
+
+// Number of searches run by `path_benchmark`, their start/goal pairs are
+// derived from the seed.
+#define PATH_BENCHMARK_SEARCHES 1000
+#define PATH_BENCHMARK_SEED 0x41F3C0
+#define PATH_BENCHMARK_MAX_ROTATIONS 200
+
+// Entrance of a cluster - a pair of adjacent walkable tiles on both sides of a
+// sector border.
+typedef struct PathClusterEntrance {
+    int tile;
+    int64_t loc;
+    int64_t exit_loc;
+} PathClusterEntrance;
+
+// Abstract pathfinding data of a sector (cluster).
+//
+// `blocked` is a tile blocking bitmap built from the sector's block list and
+// tile art (walls, portals and other objects are edge blockers and are left to
+// the local search). `entrances` and `dists` describe the abstract graph, the
+// latter holds movement costs between each pair of entrances within the
+// sector (-1 if not connected).
+typedef struct PathCluster {
+    bool used;
+    int64_t sec;
+    unsigned int timestamp;
+    bool grid_valid;
+    bool graph_valid;
+    uint32_t blocked[128];
+    int num_entrances;
+    PathClusterEntrance* entrances;
+    int* dists;
+} PathCluster;
+
+typedef struct PathHpaNode {
+    int64_t loc;
+    int cost;
+    int estimated_cost;
+    int parent;
+    int heap_pos;
+    bool closed;
+} PathHpaNode;
+
+// Connection of the start or the goal to an entrance of its cluster.
+typedef struct PathHpaLink {
+    int64_t loc;
+    int cost;
+} PathHpaLink;
+
 static int sub_41F6C0(PathCreateInfo* path_create_info);
 static int PathfindDirect(PathCreateInfo* path_create_info);
 static int PathfindAStar(PathCreateInfo* path_create_info);
+static bool path_heap_less(int a, int b);
+static void path_heap_push(int index);
+static int path_heap_pop();
+static void path_heap_sift_up(int pos);
+static void path_heap_sift_down(int pos);
 static int path_dist(int src, int dst, int width);
 static int sub_420110(int a1, int a2, int a3);
 static void PathBresenhamLineProcessor(int64_t x, int64_t y, S420330* a5);
@@ -30,6 +107,27 @@ static int PathCreateProjectile(int64_t from, int64_t to, uint8_t* rotations);
 static int sub_420900(WmapPathInfo* path_info);
 static int sub_4209C0(WmapPathInfo* path_info);
 static int sub_420E30(PathCreateInfo* path_create_info, tig_duration_t ms);
+static bool path_budget_acquire(int64_t obj, tig_timestamp_t* timestamp_ptr);
+static void path_budget_release(tig_timestamp_t timestamp);
+static int PathfindHierarchical(PathCreateInfo* path_create_info);
+static bool path_hpa_search(PathCreateInfo* path_create_info, int* cnt_ptr);
+static bool path_hpa_refine(PathCreateInfo* path_create_info, int64_t* waypoints, int cnt, int* steps_ptr);
+static bool path_hpa_in_window(int64_t a, int64_t b);
+static int path_hpa_heuristic(int64_t a, int64_t b);
+static int path_hpa_node_get(int64_t loc);
+static void path_hpa_relax(int from, int to, int cost, int64_t goal);
+static bool path_hpa_heap_less(int a, int b);
+static void path_hpa_heap_push(int index);
+static int path_hpa_heap_pop();
+static void path_hpa_heap_sift_up(int pos);
+static void path_hpa_heap_sift_down(int pos);
+static PathCluster* path_cluster_find(int64_t sec);
+static PathCluster* path_cluster_acquire(int64_t sec);
+static PathCluster* path_cluster_get_grid(int64_t sec);
+static PathCluster* path_cluster_get_graph(int64_t sec);
+static int path_cluster_side_tile(int side, int idx, bool inside);
+static void path_cluster_bfs(uint32_t* blocked, int start, int* dist_tbl, int* parent_tbl);
+static int64_t path_benchmark_coord(int64_t center, unsigned int* seed_ptr);
 
 // 0x5A15C0
 static int path_limit = 10;
@@ -43,6 +141,20 @@ static int path_cost_tbl[4096];
 // 0x5D9628
 static int path_backtrack_tbl[4096];
 
+// Open set of `PathfindAStar` - binary min-heap of node indices ordered by
+// estimated cost (ties are resolved in favor of lower index, which matches
+// original linear scan).
+//
+// A node is in the heap if and only if it has positive cost in
+// `path_cost_tbl`, so position table does not need to be reset between
+// searches.
+static int path_heap[4096];
+static int path_heap_pos[4096];
+static int path_heap_size;
+
+// Estimated total cost of open nodes (accumulated cost + heuristic).
+static int path_estimated_cost_tbl[4096];
+
 // NOTE: Unusual size.
 //
 // 0x5DD628
@@ -60,6 +172,39 @@ static int g_pathfinding_op_count;
 // 0x5DE600
 static tig_duration_t g_pathfinding_time_limit_ms;
 
+static PathCluster path_clusters[PATH_CLUSTER_CACHE_SIZE];
+
+static unsigned int path_cluster_clock;
+
+// Rotations leading from the inside tile of a cluster border to the tile
+// across it, for west, east, north and south borders respectively.
+static int path_cluster_side_dirs[4] = { 1, 5, 7, 3 };
+
+static PathClusterEntrance path_cluster_entrances[PATH_CLUSTER_MAX_ENTRANCES];
+
+// Scratch tables for breadth-first searches within a cluster.
+static int path_cluster_queue[4096];
+static int path_cluster_dist_tbl[4096];
+
+// Nodes of the abstract search, the start is always node 0 and the goal is
+// always node 1 (which is not hashed, since it can share location with an
+// entrance).
+static PathHpaNode path_hpa_nodes[PATH_HPA_MAX_NODES];
+static int path_hpa_num_nodes;
+static int path_hpa_hash[PATH_HPA_HASH_SIZE];
+static int path_hpa_heap[PATH_HPA_MAX_NODES];
+static int path_hpa_heap_size;
+
+static PathHpaLink path_hpa_start_links[PATH_CLUSTER_MAX_ENTRANCES + 1];
+static int path_hpa_num_start_links;
+static PathHpaLink path_hpa_goal_links[PATH_CLUSTER_MAX_ENTRANCES];
+static int path_hpa_num_goal_links;
+
+static int path_hpa_start_dist_tbl[4096];
+static int path_hpa_start_parent_tbl[4096];
+
+static int64_t path_hpa_waypoints[PATH_HPA_MAX_NODES];
+
 // 0x41F3C0
 int PathCreate(PathCreateInfo* path_create_info)
 {
@@ -127,7 +272,13 @@ int PathCreate(PathCreateInfo* path_create_info)
                 return 0;
             }
 
-            v2 = PathfindAStar(path_create_info);
+            // Locations which do not fit into the local search window are
+            // handled by the hierarchical search.
+            if (path_hpa_in_window(path_create_info->from, path_create_info->to)) {
+                v2 = PathfindAStar(path_create_info);
+            } else {
+                v2 = PathfindHierarchical(path_create_info);
+            }
         }
     }
 
@@ -310,29 +461,10 @@ int PathfindAStar(PathCreateInfo* path_create_info)
     int start_index;
     int target_index;
     int current_index;
-    int best_estimated_cost;
+    int estimated_cost;
 
-    if (obj_field_int32_get(path_create_info->obj, OBJ_F_TYPE) == OBJ_TYPE_NPC) {
-        if (g_pathfinding_timer_start == 0
-            || tig_timer_elapsed(g_pathfinding_timer_start) >= 1000) {
-            tig_timer_now(&g_pathfinding_timer_start);
-            g_pathfinding_op_count = 0;
-            g_pathfinding_time_limit_ms = 0;
-        }
-
-        if (g_pathfinding_op_count > path_limit) {
-            return 0;
-        }
-
-        if (g_pathfinding_time_limit_ms > path_time_limit) {
-            return 0;
-        }
-
-        g_pathfinding_op_count++;
-
-        tig_timer_now(&timestamp);
-    } else {
-        timestamp = 0;
+    if (!path_budget_acquire(path_create_info->obj, &timestamp)) {
+        return 0;
     }
 
     from_x = LOCATION_GET_X(path_create_info->from);
@@ -373,43 +505,33 @@ int PathfindAStar(PathCreateInfo* path_create_info)
     start_index = (int)(from_x + (from_y - origin_y) * 64 - origin_x);
     target_index = (int)(to_x + (to_y - origin_y) * 64 - origin_x);
 
-    // Initialize the cost array to zero (unprocessed state).
+    // Initialize the cost array to zero (unprocessed state). Positive cost
+    // denotes open nodes, negative cost denotes closed nodes.
     memset(path_cost_tbl, 0, sizeof(path_cost_tbl));
+    path_heap_size = 0;
+
     path_cost_tbl[start_index] = 1;
     path_backtrack_tbl[start_index] = -1;
 
-    while (true) {
-        current_index = -1;
-
-        // Grab open node with minimal cost.
-        for (int i = 0; i < 4096; i++) {
-            // Check if node is open, i.e. it has a positive cost (negative cost
-            // are closed nodes, zero cost are unprocessed nodes).
-            if (path_cost_tbl[i] > 0) {
-                int estimated_cost = path_cost_tbl[i] + path_dist(i, target_index, 64);
-                if (estimated_cost / 10 <= path_create_info->max_rotations) {
-                    // If no candidate node selected yet, or this candidate has
-                    // a lower cost, update current candidate.
-                    if (current_index == -1 || estimated_cost < best_estimated_cost) {
-                        best_estimated_cost = estimated_cost;
-                        current_index = i;
-                    }
-                } else {
-                    // Mark node as unreachable.
-                    path_cost_tbl[i] = -32768;
-                }
-            }
-        }
+    estimated_cost = path_cost_tbl[start_index] + path_dist(start_index, target_index, 64);
+    if (estimated_cost / 10 <= path_create_info->max_rotations) {
+        path_estimated_cost_tbl[start_index] = estimated_cost;
+        path_heap_push(start_index);
+    } else {
+        path_cost_tbl[start_index] = -32768;
+    }
 
-        // If no node has been found, path is not reachable.
-        if (current_index == -1) {
-            if (timestamp != 0) {
-                g_pathfinding_time_limit_ms += tig_timer_elapsed(timestamp);
-            }
+    while (true) {
+        // If there are no open nodes, path is not reachable.
+        if (path_heap_size == 0) {
+            path_budget_release(timestamp);
 
             return 0;
         }
 
+        // Grab open node with minimal cost.
+        current_index = path_heap_pop();
+
         // Check if we have reached the target.
         if (current_index == target_index) {
             break;
@@ -511,8 +633,25 @@ int PathfindAStar(PathCreateInfo* path_create_info)
             if ((path_cost_tbl[neighbor_index] > 0 && path_cost_tbl[neighbor_index] > cost)
                 || (path_cost_tbl[neighbor_index] < 0 && -path_cost_tbl[neighbor_index] > cost)
                 || path_cost_tbl[neighbor_index] == 0) {
+                bool open = path_cost_tbl[neighbor_index] > 0;
+
                 path_cost_tbl[neighbor_index] = cost;
                 path_backtrack_tbl[neighbor_index] = current_index;
+
+                // Nodes too far away are marked as unreachable right away
+                // rather than on the next selection. Open nodes always pass
+                // this check since their cost can only decrease.
+                estimated_cost = cost + path_dist(neighbor_index, target_index, 64);
+                if (estimated_cost / 10 <= path_create_info->max_rotations) {
+                    path_estimated_cost_tbl[neighbor_index] = estimated_cost;
+                    if (open) {
+                        path_heap_sift_up(path_heap_pos[neighbor_index]);
+                    } else {
+                        path_heap_push(neighbor_index);
+                    }
+                } else {
+                    path_cost_tbl[neighbor_index] = -32768;
+                }
             }
         }
 
@@ -530,9 +669,7 @@ int PathfindAStar(PathCreateInfo* path_create_info)
 
     // If the number of steps exceeds allowed maximum, there is no valid path.
     if (step > path_create_info->max_rotations) {
-        if (timestamp != 0) {
-            g_pathfinding_time_limit_ms += tig_timer_elapsed(timestamp);
-        }
+        path_budget_release(timestamp);
 
         return 0;
     }
@@ -547,14 +684,97 @@ int PathfindAStar(PathCreateInfo* path_create_info)
         step--;
     }
 
-    if (timestamp != 0) {
-        g_pathfinding_time_limit_ms += tig_timer_elapsed(timestamp);
-    }
+    path_budget_release(timestamp);
 
     // Return the number of steps in the computed path.
     return step;
 }
 
+bool path_heap_less(int a, int b)
+{
+    if (path_estimated_cost_tbl[a] != path_estimated_cost_tbl[b]) {
+        return path_estimated_cost_tbl[a] < path_estimated_cost_tbl[b];
+    }
+
+    return a < b;
+}
+
+void path_heap_push(int index)
+{
+    path_heap[path_heap_size] = index;
+    path_heap_pos[index] = path_heap_size;
+    path_heap_size++;
+
+    path_heap_sift_up(path_heap_size - 1);
+}
+
+int path_heap_pop()
+{
+    int index;
+
+    index = path_heap[0];
+
+    path_heap_size--;
+    if (path_heap_size > 0) {
+        path_heap[0] = path_heap[path_heap_size];
+        path_heap_pos[path_heap[0]] = 0;
+        path_heap_sift_down(0);
+    }
+
+    return index;
+}
+
+void path_heap_sift_up(int pos)
+{
+    int index;
+    int parent;
+
+    index = path_heap[pos];
+    while (pos > 0) {
+        parent = (pos - 1) / 2;
+        if (!path_heap_less(index, path_heap[parent])) {
+            break;
+        }
+
+        path_heap[pos] = path_heap[parent];
+        path_heap_pos[path_heap[pos]] = pos;
+        pos = parent;
+    }
+
+    path_heap[pos] = index;
+    path_heap_pos[index] = pos;
+}
+
+void path_heap_sift_down(int pos)
+{
+    int index;
+    int child;
+
+    index = path_heap[pos];
+    while (true) {
+        child = pos * 2 + 1;
+        if (child >= path_heap_size) {
+            break;
+        }
+
+        if (child + 1 < path_heap_size
+            && path_heap_less(path_heap[child + 1], path_heap[child])) {
+            child++;
+        }
+
+        if (!path_heap_less(path_heap[child], index)) {
+            break;
+        }
+
+        path_heap[pos] = path_heap[child];
+        path_heap_pos[path_heap[pos]] = pos;
+        pos = child;
+    }
+
+    path_heap[pos] = index;
+    path_heap_pos[index] = pos;
+}
+
 // 0x4200C0
 int path_dist(int src, int dst, int width)
 {
@@ -1035,3 +1255,990 @@ bool path_set_time_limit(int value)
 
     return true;
 }
+
+/**
+ * Finds a path between locations which are too far apart for `PathfindAStar`.
+ *
+ * Sectors are treated as clusters, the search runs on the abstract graph of
+ * their border entrances and then the leading part of the route which fits
+ * into the local search window is refined with `PathfindAStar`. The resulting
+ * path ends there (paths are clamped in `PathCreate` anyway), callers ask for
+ * a new one once it is walked.
+ *
+ * Only sectors which are already loaded are considered, the rest are treated
+ * as impassable unless they have been seen earlier. The search never loads
+ * sectors by itself, which would evict the ones around the player.
+ */
+int PathfindHierarchical(PathCreateInfo* path_create_info)
+{
+    tig_timestamp_t timestamp;
+    bool found;
+    int cnt;
+    int steps;
+
+    if (!path_budget_acquire(path_create_info->obj, &timestamp)) {
+        return 0;
+    }
+
+    found = path_hpa_search(path_create_info, &cnt);
+    path_budget_release(timestamp);
+
+    if (!found) {
+        return 0;
+    }
+
+    // Refinement is accounted by `PathfindAStar` itself.
+    if (!path_hpa_refine(path_create_info, path_hpa_waypoints, cnt, &steps)) {
+        return 0;
+    }
+
+    return steps;
+}
+
+/**
+ * Runs the abstract search, the resulting route is stored in
+ * `path_hpa_waypoints`.
+ */
+bool path_hpa_search(PathCreateInfo* path_create_info, int* cnt_ptr)
+{
+    int64_t from;
+    int64_t to;
+    int64_t from_sec;
+    int64_t to_sec;
+    int64_t min_x;
+    int64_t min_y;
+    int64_t max_x;
+    int64_t max_y;
+    int64_t sec;
+    int64_t exit_sec;
+    int64_t loc;
+    PathCluster* cluster;
+    PathClusterEntrance* entrance;
+    int to_tile;
+    int idx;
+    int other;
+    int node;
+    int current;
+    int cnt;
+    int dist;
+
+    from = path_create_info->from;
+    to = path_create_info->to;
+
+    from_sec = sector_id_from_loc(from);
+    to_sec = sector_id_from_loc(to);
+
+    if (SECTOR_X(from_sec) < SECTOR_X(to_sec)) {
+        min_x = SECTOR_X(from_sec);
+        max_x = SECTOR_X(to_sec);
+    } else {
+        min_x = SECTOR_X(to_sec);
+        max_x = SECTOR_X(from_sec);
+    }
+
+    if (SECTOR_Y(from_sec) < SECTOR_Y(to_sec)) {
+        min_y = SECTOR_Y(from_sec);
+        max_y = SECTOR_Y(to_sec);
+    } else {
+        min_y = SECTOR_Y(to_sec);
+        max_y = SECTOR_Y(from_sec);
+    }
+
+    // Check if the locations are too far apart.
+    if (max_x - min_x > PATH_HPA_MAX_SECTOR_SPAN
+        || max_y - min_y > PATH_HPA_MAX_SECTOR_SPAN) {
+        return false;
+    }
+
+    min_x -= PATH_HPA_SECTOR_MARGIN;
+    min_y -= PATH_HPA_SECTOR_MARGIN;
+    max_x += PATH_HPA_SECTOR_MARGIN;
+    max_y += PATH_HPA_SECTOR_MARGIN;
+
+    // Connect the start to the entrances of its cluster. Parents are kept to
+    // cut the route short in case the first entrance is out of the local
+    // search window.
+    cluster = path_cluster_get_graph(from_sec);
+    if (cluster == NULL) {
+        return false;
+    }
+
+    path_cluster_bfs(cluster->blocked,
+        tile_id_from_loc(from),
+        path_hpa_start_dist_tbl,
+        path_hpa_start_parent_tbl);
+
+    path_hpa_num_start_links = 0;
+    for (idx = 0; idx < cluster->num_entrances; idx++) {
+        entrance = &(cluster->entrances[idx]);
+        if (path_hpa_start_dist_tbl[entrance->tile] >= 0) {
+            path_hpa_start_links[path_hpa_num_start_links].loc = entrance->loc;
+            path_hpa_start_links[path_hpa_num_start_links].cost = path_hpa_start_dist_tbl[entrance->tile];
+            path_hpa_num_start_links++;
+        }
+    }
+
+    // Connect the goal to the entrances of its cluster.
+    cluster = path_cluster_get_graph(to_sec);
+    if (cluster == NULL) {
+        return false;
+    }
+
+    to_tile = tile_id_from_loc(to);
+    path_cluster_bfs(cluster->blocked, to_tile, path_cluster_dist_tbl, NULL);
+
+    path_hpa_num_goal_links = 0;
+    for (idx = 0; idx < cluster->num_entrances; idx++) {
+        entrance = &(cluster->entrances[idx]);
+        if (path_cluster_dist_tbl[entrance->tile] >= 0) {
+            path_hpa_goal_links[path_hpa_num_goal_links].loc = entrance->loc;
+            path_hpa_goal_links[path_hpa_num_goal_links].cost = path_cluster_dist_tbl[entrance->tile];
+            path_hpa_num_goal_links++;
+        }
+    }
+
+    for (idx = 0; idx < PATH_HPA_HASH_SIZE; idx++) {
+        path_hpa_hash[idx] = -1;
+    }
+
+    path_hpa_num_nodes = 0;
+    path_hpa_heap_size = 0;
+
+    node = path_hpa_node_get(from);
+    path_hpa_nodes[node].cost = 0;
+    path_hpa_nodes[node].estimated_cost = path_hpa_heuristic(from, to);
+    path_hpa_heap_push(node);
+
+    path_hpa_nodes[1].loc = to;
+    path_hpa_nodes[1].cost = -1;
+    path_hpa_nodes[1].parent = -1;
+    path_hpa_nodes[1].closed = false;
+    path_hpa_num_nodes = 2;
+
+    while (true) {
+        // If there are no open nodes, path is not reachable.
+        if (path_hpa_heap_size == 0) {
+            return false;
+        }
+
+        current = path_hpa_heap_pop();
+        if (current == 1) {
+            break;
+        }
+
+        path_hpa_nodes[current].closed = true;
+        loc = path_hpa_nodes[current].loc;
+        sec = sector_id_from_loc(loc);
+
+        if (current == 0) {
+            for (idx = 0; idx < path_hpa_num_start_links; idx++) {
+                node = path_hpa_node_get(path_hpa_start_links[idx].loc);
+                if (node == -1) {
+                    return false;
+                }
+
+                path_hpa_relax(current, node, path_hpa_start_links[idx].cost, to);
+            }
+
+            if (from_sec == to_sec && path_hpa_start_dist_tbl[to_tile] >= 0) {
+                path_hpa_relax(current, 1, path_hpa_start_dist_tbl[to_tile], to);
+            }
+        }
+
+        if (sec == to_sec) {
+            for (idx = 0; idx < path_hpa_num_goal_links; idx++) {
+                if (path_hpa_goal_links[idx].loc == loc) {
+                    path_hpa_relax(current, 1, path_hpa_goal_links[idx].cost, to);
+                    break;
+                }
+            }
+        }
+
+        cluster = path_cluster_get_graph(sec);
+        if (cluster == NULL) {
+            continue;
+        }
+
+        for (idx = 0; idx < cluster->num_entrances; idx++) {
+            if (cluster->entrances[idx].loc == loc) {
+                break;
+            }
+        }
+
+        if (idx == cluster->num_entrances) {
+            continue;
+        }
+
+        // Cross the border.
+        entrance = &(cluster->entrances[idx]);
+        exit_sec = sector_id_from_loc(entrance->exit_loc);
+        if (SECTOR_X(exit_sec) >= min_x
+            && SECTOR_X(exit_sec) <= max_x
+            && SECTOR_Y(exit_sec) >= min_y
+            && SECTOR_Y(exit_sec) <= max_y) {
+            node = path_hpa_node_get(entrance->exit_loc);
+            if (node == -1) {
+                return false;
+            }
+
+            path_hpa_relax(current, node, 10, to);
+        }
+
+        // Move to other entrances of the same cluster.
+        for (other = 0; other < cluster->num_entrances; other++) {
+            dist = cluster->dists[idx * cluster->num_entrances + other];
+            if (other != idx && dist >= 0) {
+                node = path_hpa_node_get(cluster->entrances[other].loc);
+                if (node == -1) {
+                    return false;
+                }
+
+                path_hpa_relax(current, node, dist, to);
+            }
+        }
+    }
+
+    // Collect waypoints from the start (exclusive) up to the goal.
+    cnt = 0;
+    for (current = 1; current != 0; current = path_hpa_nodes[current].parent) {
+        cnt++;
+    }
+
+    idx = cnt;
+    for (current = 1; current != 0; current = path_hpa_nodes[current].parent) {
+        path_hpa_waypoints[--idx] = path_hpa_nodes[current].loc;
+    }
+
+    *cnt_ptr = cnt;
+
+    return true;
+}
+
+/**
+ * Builds the concrete path along the leading part of the abstract route which
+ * fits into the local search window.
+ */
+bool path_hpa_refine(PathCreateInfo* path_create_info, int64_t* waypoints, int cnt, int* steps_ptr)
+{
+    PathCreateInfo segment_create_info;
+    int64_t from;
+    int64_t base;
+    int64_t loc;
+    int last;
+    int idx;
+    int tile;
+    int steps;
+
+    from = path_create_info->from;
+
+    last = -1;
+    while (last + 1 < cnt && path_hpa_in_window(from, waypoints[last + 1])) {
+        last++;
+    }
+
+    if (last == -1) {
+        // The first waypoint is an entrance of the start cluster on the far
+        // side of it, walk its route back until it gets into the window.
+        if (sector_id_from_loc(waypoints[0]) != sector_id_from_loc(from)) {
+            return false;
+        }
+
+        tile = tile_id_from_loc(waypoints[0]);
+        if (path_hpa_start_dist_tbl[tile] < 0) {
+            return false;
+        }
+
+        base = sector_loc_from_id(sector_id_from_loc(from));
+        while (true) {
+            loc = LOCATION_MAKE(LOCATION_GET_X(base) + TILE_X(tile), LOCATION_GET_Y(base) + TILE_Y(tile));
+            if (path_hpa_in_window(from, loc)) {
+                break;
+            }
+
+            tile = path_hpa_start_parent_tbl[tile];
+        }
+
+        waypoints[0] = loc;
+        last = 0;
+    }
+
+    // Walls, portals and other objects are not a part of the abstract graph,
+    // so the furthest waypoint might be unreachable. Fall back to the nearer
+    // ones.
+    for (idx = last; idx >= 0; idx--) {
+        segment_create_info = *path_create_info;
+        segment_create_info.to = waypoints[idx];
+        if (waypoints[idx] != path_create_info->to) {
+            segment_create_info.flags &= ~PATH_FLAG_0x0001;
+        }
+
+        steps = PathfindAStar(&segment_create_info);
+        if (steps > 0) {
+            *steps_ptr = steps;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool path_hpa_in_window(int64_t a, int64_t b)
+{
+    int64_t dx;
+    int64_t dy;
+
+    dx = LOCATION_GET_X(a) - LOCATION_GET_X(b);
+    if (dx < 0) {
+        dx = -dx;
+    }
+
+    dy = LOCATION_GET_Y(a) - LOCATION_GET_Y(b);
+    if (dy < 0) {
+        dy = -dy;
+    }
+
+    return dx <= 32 && dy <= 32;
+}
+
+int path_hpa_heuristic(int64_t a, int64_t b)
+{
+    int64_t dx;
+    int64_t dy;
+
+    dx = LOCATION_GET_X(a) - LOCATION_GET_X(b);
+    if (dx < 0) {
+        dx = -dx;
+    }
+
+    dy = LOCATION_GET_Y(a) - LOCATION_GET_Y(b);
+    if (dy < 0) {
+        dy = -dy;
+    }
+
+    return (int)(10 * (dx > dy ? dx : dy));
+}
+
+/**
+ * Returns the abstract search node at the specified location, adding a new one
+ * if needed. Returns -1 when the node limit is reached.
+ */
+int path_hpa_node_get(int64_t loc)
+{
+    unsigned int hash;
+    int node;
+
+    hash = (unsigned int)(LOCATION_GET_X(loc) * 73856093 ^ LOCATION_GET_Y(loc) * 19349663) % PATH_HPA_HASH_SIZE;
+    while (path_hpa_hash[hash] != -1) {
+        if (path_hpa_nodes[path_hpa_hash[hash]].loc == loc) {
+            return path_hpa_hash[hash];
+        }
+
+        hash = (hash + 1) % PATH_HPA_HASH_SIZE;
+    }
+
+    if (path_hpa_num_nodes == PATH_HPA_MAX_NODES) {
+        return -1;
+    }
+
+    node = path_hpa_num_nodes++;
+    path_hpa_nodes[node].loc = loc;
+    path_hpa_nodes[node].cost = -1;
+    path_hpa_nodes[node].parent = -1;
+    path_hpa_nodes[node].closed = false;
+    path_hpa_hash[hash] = node;
+
+    return node;
+}
+
+void path_hpa_relax(int from, int to, int cost, int64_t goal)
+{
+    PathHpaNode* node;
+    bool open;
+
+    node = &(path_hpa_nodes[to]);
+    if (node->closed) {
+        return;
+    }
+
+    cost += path_hpa_nodes[from].cost;
+    if (node->cost >= 0 && node->cost <= cost) {
+        return;
+    }
+
+    open = node->cost >= 0;
+
+    node->cost = cost;
+    node->parent = from;
+    node->estimated_cost = cost + path_hpa_heuristic(node->loc, goal);
+
+    if (open) {
+        path_hpa_heap_sift_up(node->heap_pos);
+    } else {
+        path_hpa_heap_push(to);
+    }
+}
+
+bool path_hpa_heap_less(int a, int b)
+{
+    if (path_hpa_nodes[a].estimated_cost != path_hpa_nodes[b].estimated_cost) {
+        return path_hpa_nodes[a].estimated_cost < path_hpa_nodes[b].estimated_cost;
+    }
+
+    return a < b;
+}
+
+void path_hpa_heap_push(int index)
+{
+    path_hpa_heap[path_hpa_heap_size] = index;
+    path_hpa_nodes[index].heap_pos = path_hpa_heap_size;
+    path_hpa_heap_size++;
+    path_hpa_heap_sift_up(path_hpa_heap_size - 1);
+}
+
+int path_hpa_heap_pop()
+{
+    int index;
+
+    index = path_hpa_heap[0];
+
+    path_hpa_heap_size--;
+    if (path_hpa_heap_size > 0) {
+        path_hpa_heap[0] = path_hpa_heap[path_hpa_heap_size];
+        path_hpa_nodes[path_hpa_heap[0]].heap_pos = 0;
+        path_hpa_heap_sift_down(0);
+    }
+
+    return index;
+}
+
+void path_hpa_heap_sift_up(int pos)
+{
+    int index;
+    int parent;
+
+    index = path_hpa_heap[pos];
+    while (pos > 0) {
+        parent = (pos - 1) / 2;
+        if (!path_hpa_heap_less(index, path_hpa_heap[parent])) {
+            break;
+        }
+
+        path_hpa_heap[pos] = path_hpa_heap[parent];
+        path_hpa_nodes[path_hpa_heap[pos]].heap_pos = pos;
+        pos = parent;
+    }
+
+    path_hpa_heap[pos] = index;
+    path_hpa_nodes[index].heap_pos = pos;
+}
+
+void path_hpa_heap_sift_down(int pos)
+{
+    int index;
+    int child;
+
+    index = path_hpa_heap[pos];
+    while (true) {
+        child = pos * 2 + 1;
+        if (child >= path_hpa_heap_size) {
+            break;
+        }
+
+        if (child + 1 < path_hpa_heap_size
+            && path_hpa_heap_less(path_hpa_heap[child + 1], path_hpa_heap[child])) {
+            child++;
+        }
+
+        if (!path_hpa_heap_less(path_hpa_heap[child], index)) {
+            break;
+        }
+
+        path_hpa_heap[pos] = path_hpa_heap[child];
+        path_hpa_nodes[path_hpa_heap[pos]].heap_pos = pos;
+        pos = child;
+    }
+
+    path_hpa_heap[pos] = index;
+    path_hpa_nodes[index].heap_pos = pos;
+}
+
+PathCluster* path_cluster_find(int64_t sec)
+{
+    int idx;
+
+    for (idx = 0; idx < PATH_CLUSTER_CACHE_SIZE; idx++) {
+        if (path_clusters[idx].used && path_clusters[idx].sec == sec) {
+            return &(path_clusters[idx]);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Returns the cache entry for the specified sector, evicting the least
+ * recently used one if needed.
+ */
+PathCluster* path_cluster_acquire(int64_t sec)
+{
+    PathCluster* cluster;
+    int idx;
+
+    cluster = path_cluster_find(sec);
+    if (cluster == NULL) {
+        for (idx = 0; idx < PATH_CLUSTER_CACHE_SIZE; idx++) {
+            if (!path_clusters[idx].used) {
+                cluster = &(path_clusters[idx]);
+                break;
+            }
+
+            if (cluster == NULL || path_clusters[idx].timestamp < cluster->timestamp) {
+                cluster = &(path_clusters[idx]);
+            }
+        }
+
+        if (cluster->entrances != NULL) {
+            FREE(cluster->entrances);
+            cluster->entrances = NULL;
+        }
+
+        if (cluster->dists != NULL) {
+            FREE(cluster->dists);
+            cluster->dists = NULL;
+        }
+
+        cluster->used = true;
+        cluster->sec = sec;
+        cluster->grid_valid = false;
+        cluster->graph_valid = false;
+        cluster->num_entrances = 0;
+    }
+
+    cluster->timestamp = ++path_cluster_clock;
+
+    return cluster;
+}
+
+/**
+ * Returns the cache entry for the specified sector with an up-to-date tile
+ * blocking bitmap, or `NULL` if the sector is not loaded.
+ */
+PathCluster* path_cluster_get_grid(int64_t sec)
+{
+    PathCluster* cluster;
+    Sector* sector;
+    int tile;
+    tig_art_id_t art_id;
+    bool blocked;
+
+    cluster = path_cluster_find(sec);
+    if (cluster != NULL && cluster->grid_valid) {
+        cluster->timestamp = ++path_cluster_clock;
+        return cluster;
+    }
+
+    // Locking a sector which is not in the sector cache loads it and can
+    // evict others (saving them and unloading their objects).
+    if (!sub_4D04E0(sec)) {
+        return NULL;
+    }
+
+    cluster = path_cluster_acquire(sec);
+
+    if (!sector_lock(sec, &sector)) {
+        return NULL;
+    }
+
+    // NOTE: Mirrors `tile_is_blocking`.
+    for (tile = 0; tile < 4096; tile++) {
+        blocked = (sector->blocks.mask[tile / 32] & (1u << (tile % 32))) != 0;
+        if (!blocked) {
+            art_id = sector->tiles.art_ids[tile];
+            if (tig_art_type(art_id) == TIG_ART_TYPE_FACADE) {
+                blocked = !tig_art_facade_id_walkable_get(art_id);
+            } else {
+                blocked = a_name_tile_is_blocking(art_id);
+            }
+        }
+
+        if (blocked) {
+            cluster->blocked[tile / 32] |= 1u << (tile % 32);
+        } else {
+            cluster->blocked[tile / 32] &= ~(1u << (tile % 32));
+        }
+    }
+
+    sector_unlock(sec);
+
+    cluster->grid_valid = true;
+
+    return cluster;
+}
+
+/**
+ * Returns the cache entry for the specified sector with up-to-date entrances
+ * and costs between them, or `NULL` if the sector is not loaded.
+ *
+ * The returned pointer is only valid until the next cluster is requested.
+ */
+PathCluster* path_cluster_get_graph(int64_t sec)
+{
+    PathCluster* cluster;
+    PathCluster* neighbor;
+    PathClusterEntrance* entrance;
+    int64_t neighbor_sec;
+    int64_t base;
+    bool open[4][64];
+    int positions[2];
+    int num_positions;
+    int side;
+    int idx;
+    int start;
+    int cnt;
+    int other;
+    int tile;
+
+    cluster = path_cluster_find(sec);
+    if (cluster != NULL && cluster->graph_valid) {
+        cluster->timestamp = ++path_cluster_clock;
+        return cluster;
+    }
+
+    // Collect walkable tiles along the facing borders of the neighbors first,
+    // requesting them can evict this cluster.
+    for (side = 0; side < 4; side++) {
+        neighbor = NULL;
+        if (sector_in_dir(sec, path_cluster_side_dirs[side], &neighbor_sec)) {
+            neighbor = path_cluster_get_grid(neighbor_sec);
+        }
+
+        for (idx = 0; idx < 64; idx++) {
+            tile = path_cluster_side_tile(side, idx, false);
+            open[side][idx] = neighbor != NULL
+                && (neighbor->blocked[tile / 32] & (1u << (tile % 32))) == 0;
+        }
+    }
+
+    cluster = path_cluster_get_grid(sec);
+    if (cluster == NULL) {
+        return NULL;
+    }
+
+    base = sector_loc_from_id(sec);
+
+    // Every run of border tiles walkable on both sides becomes an entrance
+    // (or two for long runs). Neighbors see the same runs, so entrances on
+    // both sides of a border always come in pairs.
+    cnt = 0;
+    for (side = 0; side < 4; side++) {
+        start = -1;
+        for (idx = 0; idx <= 64; idx++) {
+            if (idx < 64) {
+                tile = path_cluster_side_tile(side, idx, true);
+                if (open[side][idx]
+                    && (cluster->blocked[tile / 32] & (1u << (tile % 32))) == 0) {
+                    if (start == -1) {
+                        start = idx;
+                    }
+                    continue;
+                }
+            }
+
+            if (start != -1) {
+                if (idx - start > PATH_CLUSTER_LONG_RUN) {
+                    positions[0] = start;
+                    positions[1] = idx - 1;
+                    num_positions = 2;
+                } else {
+                    positions[0] = (start + idx - 1) / 2;
+                    num_positions = 1;
+                }
+
+                for (other = 0; other < num_positions; other++) {
+                    entrance = &(path_cluster_entrances[cnt++]);
+                    entrance->tile = path_cluster_side_tile(side, positions[other], true);
+                    entrance->loc = LOCATION_MAKE(LOCATION_GET_X(base) + TILE_X(entrance->tile),
+                        LOCATION_GET_Y(base) + TILE_Y(entrance->tile));
+                    location_in_dir(entrance->loc, path_cluster_side_dirs[side], &(entrance->exit_loc));
+                }
+
+                start = -1;
+            }
+        }
+    }
+
+    if (cluster->entrances != NULL) {
+        FREE(cluster->entrances);
+        cluster->entrances = NULL;
+    }
+
+    if (cluster->dists != NULL) {
+        FREE(cluster->dists);
+        cluster->dists = NULL;
+    }
+
+    cluster->num_entrances = cnt;
+
+    if (cnt != 0) {
+        cluster->entrances = (PathClusterEntrance*)MALLOC(sizeof(*cluster->entrances) * cnt);
+        memcpy(cluster->entrances, path_cluster_entrances, sizeof(*cluster->entrances) * cnt);
+
+        cluster->dists = (int*)MALLOC(sizeof(*cluster->dists) * cnt * cnt);
+        for (idx = 0; idx < cnt; idx++) {
+            path_cluster_bfs(cluster->blocked, cluster->entrances[idx].tile, path_cluster_dist_tbl, NULL);
+            for (other = 0; other < cnt; other++) {
+                cluster->dists[idx * cnt + other] = path_cluster_dist_tbl[cluster->entrances[other].tile];
+            }
+        }
+    }
+
+    cluster->graph_valid = true;
+
+    return cluster;
+}
+
+/**
+ * Returns the tile at the specified position along a cluster border, either
+ * inside the cluster or on the facing border of its neighbor.
+ */
+int path_cluster_side_tile(int side, int idx, bool inside)
+{
+    switch (side) {
+    case 0:
+        return TILE_MAKE(inside ? 0 : 63, idx);
+    case 1:
+        return TILE_MAKE(inside ? 63 : 0, idx);
+    case 2:
+        return TILE_MAKE(idx, inside ? 0 : 63);
+    default:
+        return TILE_MAKE(idx, inside ? 63 : 0);
+    }
+}
+
+/**
+ * Computes movement costs from the specified tile to every tile of a cluster
+ * (-1 for unreachable ones), optionally recording the predecessors.
+ */
+void path_cluster_bfs(uint32_t* blocked, int start, int* dist_tbl, int* parent_tbl)
+{
+    int head;
+    int tail;
+    int tile;
+    int next;
+    int x;
+    int y;
+    int dx;
+    int dy;
+
+    for (tile = 0; tile < 4096; tile++) {
+        dist_tbl[tile] = -1;
+    }
+
+    dist_tbl[start] = 0;
+    if (parent_tbl != NULL) {
+        parent_tbl[start] = -1;
+    }
+
+    path_cluster_queue[0] = start;
+    head = 0;
+    tail = 1;
+
+    while (head < tail) {
+        tile = path_cluster_queue[head++];
+        for (dy = -1; dy <= 1; dy++) {
+            y = TILE_Y(tile) + dy;
+            if (y < 0 || y >= 64) {
+                continue;
+            }
+
+            for (dx = -1; dx <= 1; dx++) {
+                x = TILE_X(tile) + dx;
+                if (x < 0 || x >= 64 || (dx == 0 && dy == 0)) {
+                    continue;
+                }
+
+                next = TILE_MAKE(x, y);
+                if (dist_tbl[next] >= 0
+                    || (blocked[next / 32] & (1u << (next % 32))) != 0) {
+                    continue;
+                }
+
+                dist_tbl[next] = dist_tbl[tile] + 10;
+                if (parent_tbl != NULL) {
+                    parent_tbl[next] = tile;
+                }
+
+                path_cluster_queue[tail++] = next;
+            }
+        }
+    }
+}
+
+void path_cluster_invalidate(int64_t sec)
+{
+    PathCluster* cluster;
+    int64_t neighbor_sec;
+    int side;
+
+    cluster = path_cluster_find(sec);
+    if (cluster != NULL) {
+        cluster->grid_valid = false;
+        cluster->graph_valid = false;
+    }
+
+    // Entrances of the neighbors depend on the borders of this sector.
+    for (side = 0; side < 4; side++) {
+        if (sector_in_dir(sec, path_cluster_side_dirs[side], &neighbor_sec)) {
+            cluster = path_cluster_find(neighbor_sec);
+            if (cluster != NULL) {
+                cluster->graph_valid = false;
+            }
+        }
+    }
+}
+
+void path_cluster_invalidate_all()
+{
+    int idx;
+
+    for (idx = 0; idx < PATH_CLUSTER_CACHE_SIZE; idx++) {
+        if (path_clusters[idx].entrances != NULL) {
+            FREE(path_clusters[idx].entrances);
+            path_clusters[idx].entrances = NULL;
+        }
+
+        if (path_clusters[idx].dists != NULL) {
+            FREE(path_clusters[idx].dists);
+            path_clusters[idx].dists = NULL;
+        }
+
+        path_clusters[idx].used = false;
+        path_clusters[idx].grid_valid = false;
+        path_clusters[idx].graph_valid = false;
+        path_clusters[idx].num_entrances = 0;
+    }
+}
+
+/**
+ * Accounts a pathfinding operation against the NPC budget (see `path_limit` and
+ * `path_time_limit`). Returns `false` if the budget is exhausted.
+ */
+bool path_budget_acquire(int64_t obj, tig_timestamp_t* timestamp_ptr)
+{
+    if (obj_field_int32_get(obj, OBJ_F_TYPE) != OBJ_TYPE_NPC) {
+        *timestamp_ptr = 0;
+        return true;
+    }
+
+    if (g_pathfinding_timer_start == 0
+        || tig_timer_elapsed(g_pathfinding_timer_start) >= 1000) {
+        tig_timer_now(&g_pathfinding_timer_start);
+        g_pathfinding_op_count = 0;
+        g_pathfinding_time_limit_ms = 0;
+    }
+
+    if (g_pathfinding_op_count > path_limit) {
+        return false;
+    }
+
+    if (g_pathfinding_time_limit_ms > path_time_limit) {
+        return false;
+    }
+
+    g_pathfinding_op_count++;
+
+    tig_timer_now(timestamp_ptr);
+
+    return true;
+}
+
+void path_budget_release(tig_timestamp_t timestamp)
+{
+    if (timestamp != 0) {
+        g_pathfinding_time_limit_ms += tig_timer_elapsed(timestamp);
+    }
+}
+
+/**
+ * Runs `PathfindAStar` over a fixed set of start/goal pairs around the player
+ * and reports the time spent along with a checksum of the resulting paths.
+ *
+ * Pairs are derived from a constant seed, so runs on the same map and location
+ * are comparable between builds. The player is used as the moving object,
+ * which is not subject to the NPC budget.
+ */
+void path_benchmark()
+{
+    int64_t pc_obj;
+    int64_t loc;
+    int64_t x;
+    int64_t y;
+    unsigned int seed;
+    int8_t rotations[PATH_BENCHMARK_MAX_ROTATIONS];
+    PathCreateInfo path_create_info;
+    tig_timestamp_t timestamp;
+    tig_duration_t elapsed;
+    int search;
+    int step;
+    int idx;
+    int found;
+    int total_steps;
+    unsigned int checksum;
+
+    pc_obj = player_get_local_pc_obj();
+    if (pc_obj == OBJ_HANDLE_NULL) {
+        return;
+    }
+
+    loc = obj_field_int64_get(pc_obj, OBJ_F_LOCATION);
+    x = LOCATION_GET_X(loc);
+    y = LOCATION_GET_Y(loc);
+
+    path_create_info.obj = pc_obj;
+    path_create_info.max_rotations = PATH_BENCHMARK_MAX_ROTATIONS;
+    path_create_info.rotations = rotations;
+    path_create_info.flags = 0;
+    path_create_info.field_24 = 0;
+
+    seed = PATH_BENCHMARK_SEED;
+    found = 0;
+    total_steps = 0;
+    checksum = 0;
+
+    tig_timer_now(&timestamp);
+
+    for (search = 0; search < PATH_BENCHMARK_SEARCHES; search++) {
+        path_create_info.from = location_make(path_benchmark_coord(x, &seed), path_benchmark_coord(y, &seed));
+        path_create_info.to = location_make(path_benchmark_coord(x, &seed), path_benchmark_coord(y, &seed));
+
+        step = PathfindAStar(&path_create_info);
+        if (step > 0) {
+            found++;
+            total_steps += step;
+            for (idx = 0; idx < step; idx++) {
+                checksum = checksum * 31 + (uint8_t)rotations[idx];
+            }
+        }
+    }
+
+    elapsed = tig_timer_elapsed(timestamp);
+
+    tig_debug_printf("Path benchmark: %d searches, %d found, %d steps, checksum %08X, %d ms\n",
+        PATH_BENCHMARK_SEARCHES,
+        found,
+        total_steps,
+        checksum,
+        elapsed);
+}
+
+// Picks coordinate within half the search window from `center`, so that every
+// pair fits into `PathfindAStar` window.
+int64_t path_benchmark_coord(int64_t center, unsigned int* seed_ptr)
+{
+    int64_t coord;
+
+    *seed_ptr = *seed_ptr * 1103515245 + 12345;
+    coord = center + (int)((*seed_ptr >> 16) % 33) - 16;
+
+    return coord >= 0 ? coord : 0;
+}
@@ -44,4 +44,15 @@ int sub_4207D0(WmapPathInfo* path_info);
 bool path_set_limit(int value);
 bool path_set_time_limit(int value);
 
+// Drops cached hierarchical pathfinding data of a sector, must be called
+// whenever its tile blocking changes.
+void path_cluster_invalidate(int64_t sec);
+
+// Drops cached hierarchical pathfinding data of all sectors.
+void path_cluster_invalidate_all();
+
+// Times `PathfindAStar` over a fixed set of searches around the player and
+// prints the results to the debug log.
+void path_benchmark();
+
 #endif /* ARCANUM_GAME_PATH_H_ */
@@ -21,6 +21,7 @@
 #include "game/mp_utils.h"
 #include "game/multiplayer.h"
 #include "game/newspaper.h"
+#include "game/obj_pool.h"
 #include "game/object.h"
 #include "game/player.h"
 #include "game/portal.h"
@@ -40,10 +41,17 @@
 #include "game/trap.h"
 #include "game/ui.h"
 
+// Number of cached scripts kept before idle ones are evicted. The cache grows
+// past this when every entry is locked.
 #define MAX_CACHE_ENTRIES 100
 #define MAX_GLOBAL_VARS 2000
 #define MAX_GLOBAL_FLAGS 100
 
+#define SCRIPT_CACHE_INDEX_DELETED (-1)
+
+#define SCRIPT_BENCHMARK_MAX_HEARTBEATS 512
+#define SCRIPT_BENCHMARK_PASSES 20
+
 #define NEXT -1
 #define RETURN_AND_SKIP_DEFAULT -2
 #define RETURN_AND_RUN_DEFAULT -3
@@ -71,6 +79,14 @@ typedef struct ScriptState {
     /* 03C8 */ int64_t lc_objs[10];
 } ScriptState;
 
+// Script state heartbeats can change, captured by `script_benchmark`.
+typedef struct ScriptBenchmarkState {
+    int global_vars[MAX_GLOBAL_VARS];
+    int global_flags[MAX_GLOBAL_FLAGS];
+    int story_state;
+    Script scr;
+} ScriptBenchmarkState;
+
 static int script_execute_condition(ScriptCondition* condition, int line, ScriptState* state);
 static int script_execute_action(ScriptAction* action, int line, ScriptState* state);
 static bool sub_44AFF0(TimeEvent* timeevent);
@@ -94,10 +110,17 @@ static bool script_file_destroy(ScriptFile* script_file);
 static bool cache_add(int cache_entry_id, int script_id);
 static void cache_remove(int cache_entry_id);
 static int cache_find(int script_id);
+static int cache_lookup(int script_id);
+static void cache_index_insert(int cache_entry_id);
+static void cache_index_remove(int cache_entry_id);
+static void cache_index_rebuild(int capacity);
 static bool script_file_load_hdr(TigFile* stream, ScriptHeader* hdr);
 static bool script_file_load_code(TigFile* stream, ScriptFile* script_file);
 static void script_fx_play(int64_t obj, int fx_id);
 static void script_fx_stop(int64_t obj, int fx_id);
+static void script_benchmark_save(ScriptBenchmarkState* benchmark_state, int64_t obj);
+static void script_benchmark_restore(ScriptBenchmarkState* benchmark_state, int64_t obj);
+static unsigned int script_benchmark_fingerprint(bool rc, Script* scr, int64_t obj);
 
 // 0x5A56FC
 static mes_file_handle_t script_story_state_mes_file = MES_FILE_HANDLE_INVALID;
@@ -145,20 +168,49 @@ static ScriptCacheEntry* script_cache_entries;
 // 0x5E2FF8
 static int64_t qword_5E2FF8;
 
+/**
+ * Number of elements in `script_cache_entries` array.
+ */
+static int script_cache_capacity;
+
+/**
+ * Open-addressing index of `script_cache_entries` keyed by script id. Each
+ * slot holds an entry index biased by one, zero marks an empty slot and
+ * `SCRIPT_CACHE_INDEX_DELETED` a removed one.
+ */
+static int* script_cache_index;
+
+static int script_cache_index_capacity;
+
+/**
+ * Number of used (live and deleted) slots in `script_cache_index`.
+ */
+static int script_cache_index_used;
+
+/**
+ * Executes statements from copies made with `sub_44C1B0`, the way the
+ * original interpreter did, instead of in place. Set by `script_benchmark`
+ * only.
+ */
+static bool script_execute_copies;
+
 // 0x4446E0
 bool script_init(GameInitInfo* init_info)
 {
     int index;
 
     script_editor = init_info->editor;
-    script_cache_entries = (ScriptCacheEntry*)CALLOC(MAX_CACHE_ENTRIES, sizeof(ScriptCacheEntry));
+    script_cache_capacity = MAX_CACHE_ENTRIES;
+    script_cache_entries = (ScriptCacheEntry*)CALLOC(script_cache_capacity, sizeof(ScriptCacheEntry));
     script_global_vars = (int*)CALLOC(MAX_GLOBAL_VARS, sizeof(int));
     script_global_flags = (int*)CALLOC(MAX_GLOBAL_FLAGS, sizeof(int));
 
-    for (index = 0; index < MAX_CACHE_ENTRIES; index++) {
+    for (index = 0; index < script_cache_capacity; index++) {
         script_cache_entries[index].script_id = 0;
     }
 
+    cache_index_rebuild(256);
+
     script_start_dialog_func = NULL;
     script_float_line_func = NULL;
     script_story_state = 0;
@@ -195,7 +247,7 @@ void script_reset()
 {
     int index;
 
-    for (index = 0; index < MAX_CACHE_ENTRIES; index++) {
+    for (index = 0; index < script_cache_capacity; index++) {
         cache_remove(index);
     }
 
@@ -215,12 +267,18 @@ void script_exit()
 {
     int index;
 
-    for (index = 0; index < MAX_CACHE_ENTRIES; index++) {
+    for (index = 0; index < script_cache_capacity; index++) {
         cache_remove(index);
     }
 
     script_story_state = 0;
     FREE(script_cache_entries);
+    FREE(script_cache_index);
+    script_cache_entries = NULL;
+    script_cache_index = NULL;
+    script_cache_capacity = 0;
+    script_cache_index_capacity = 0;
+    script_cache_index_used = 0;
     FREE(script_global_vars);
     FREE(script_global_flags);
 
@@ -285,6 +343,7 @@ bool script_execute(ScriptInvocation* invocation)
     int iter;
     int line;
     int next;
+    int locked_script_num;
     ScriptCondition statement;
     bool run_default;
 
@@ -343,18 +402,27 @@ bool script_execute(ScriptInvocation* invocation)
     memset(state.lc_vars, 0, sizeof(state.lc_vars));
     memset(state.lc_objs, 0, sizeof(state.lc_objs));
 
-    script_file = script_lock(invocation->script->num);
+    locked_script_num = invocation->script->num;
+    script_file = script_lock(locked_script_num);
     if (script_file != NULL) {
         line = invocation->line;
 
         // NOTE: Original code is probably different.
         for (iter = 0; iter < 1000; iter++) {
-            if (!sub_44C1B0(script_file, line, &statement)) {
+            // NOTE: Unsigned math, see `sub_44C1B0`.
+            if ((unsigned int)line >= (unsigned int)script_file->num_entries) {
                 run_default = false;
                 break;
             }
 
-            next = script_execute_condition(&statement, line, &state);
+            if (script_execute_copies) {
+                sub_44C1B0(script_file, line, &statement);
+                next = script_execute_condition(&statement, line, &state);
+            } else {
+                // Statements are executed in place, the file is kept alive by
+                // the lock for the duration of the invocation.
+                next = script_execute_condition(&(script_file->entries[line]), line, &state);
+            }
             if (next == NEXT) {
                 if (line < script_file->num_entries - 1) {
                     line++;
@@ -379,7 +447,9 @@ bool script_execute(ScriptInvocation* invocation)
             }
         }
 
-        script_unlock(invocation->script->num);
+        // The script number might have been reset above, release the lock
+        // taken on the original one.
+        script_unlock(locked_script_num);
     } else {
         run_default = true;
     }
@@ -3430,12 +3500,16 @@ void script_unlock(int script_id)
 {
     int cache_entry_id;
 
-    if (!script_editor) {
+    // FIX: Original code only released locks in the editor (where
+    // `script_lock` never succeeds), which left every script locked.
+    if (script_editor) {
         return;
     }
 
-    cache_entry_id = cache_find(script_id);
-    script_cache_entries[cache_entry_id].ref_count--;
+    cache_entry_id = cache_lookup(script_id);
+    if (cache_entry_id != -1 && script_cache_entries[cache_entry_id].ref_count > 0) {
+        script_cache_entries[cache_entry_id].ref_count--;
+    }
 }
 
 // 0x44C480
@@ -3506,6 +3580,7 @@ bool cache_add(int cache_entry_id, int script_id)
 
     script_cache_entries[cache_entry_id].script_id = script_id;
     script_cache_entries[cache_entry_id].ref_count = 0;
+    cache_index_insert(cache_entry_id);
 
     return true;
 }
@@ -3514,6 +3589,7 @@ bool cache_add(int cache_entry_id, int script_id)
 void cache_remove(int cache_entry_id)
 {
     if (script_cache_entries[cache_entry_id].script_id) {
+        cache_index_remove(cache_entry_id);
         script_file_destroy(script_cache_entries[cache_entry_id].file);
         script_cache_entries[cache_entry_id].script_id = 0;
     }
@@ -3525,12 +3601,14 @@ int cache_find(int script_id)
     int idx;
     int candidate = -1;
     int best_candidate = -1;
+    int old_capacity;
 
-    for (idx = 0; idx < MAX_CACHE_ENTRIES; idx++) {
-        if (script_cache_entries[idx].script_id == script_id) {
-            return idx;
-        }
+    idx = cache_lookup(script_id);
+    if (idx != -1) {
+        return idx;
+    }
 
+    for (idx = 0; idx < script_cache_capacity; idx++) {
         if (script_cache_entries[idx].script_id != 0) {
             if (script_cache_entries[idx].ref_count == 0) {
                 if (candidate == -1) {
@@ -3556,8 +3634,13 @@ int cache_find(int script_id)
         return candidate;
     }
 
-    tig_debug_printf("cache_find: Error: failed to find cache item!\n");
-    exit(EXIT_SUCCESS); // FIXME: Should be `EXIT_FAILURE`.
+    // Every cached script is locked, grow the cache instead of bailing out.
+    old_capacity = script_cache_capacity;
+    script_cache_capacity *= 2;
+    script_cache_entries = (ScriptCacheEntry*)REALLOC(script_cache_entries, sizeof(*script_cache_entries) * script_cache_capacity);
+    memset(&(script_cache_entries[old_capacity]), 0, sizeof(*script_cache_entries) * (script_cache_capacity - old_capacity));
+
+    return old_capacity;
 }
 
 // 0x44C710
@@ -3616,3 +3699,261 @@ void script_play_explosion_fx(int64_t obj)
 {
     script_fx_play(obj, 55);
 }
+
+// Replays heartbeats of the loaded world through both interpreters. Only
+// globals and heartbeat scripts are rolled back, anything else heartbeats
+// touch is not, so the game exits right after the benchmark (see `main`).
+void script_benchmark()
+{
+    int64_t* objs;
+    int num_objs;
+    int64_t obj;
+    int iter;
+    Script scr;
+    ScriptInvocation invocation;
+    ScriptBenchmarkState* initial_state;
+    ScriptBenchmarkState* benchmark_state;
+    uint64_t elapsed[2];
+    uint64_t start;
+    unsigned int fingerprint[2];
+    unsigned int checksum;
+    bool rc;
+    int pass;
+    int idx;
+    int mode;
+    int mismatches;
+    int skipped;
+
+    objs = (int64_t*)MALLOC(sizeof(*objs) * SCRIPT_BENCHMARK_MAX_HEARTBEATS);
+    num_objs = 0;
+
+    if (obj_pool_walk_first(&obj, &iter)) {
+        do {
+            if (!obj_is_proto(obj)) {
+                obj_arrayfield_script_get(obj, OBJ_F_SCRIPTS_IDX, SAP_HEARTBEAT, &scr);
+                if (scr.num != 0) {
+                    objs[num_objs++] = obj;
+                }
+            }
+        } while (num_objs < SCRIPT_BENCHMARK_MAX_HEARTBEATS && obj_pool_walk_next(&obj, &iter));
+    }
+
+    if (num_objs == 0) {
+        tig_debug_printf("Script benchmark: no heartbeat scripts\n");
+        FREE(objs);
+        return;
+    }
+
+    initial_state = (ScriptBenchmarkState*)MALLOC(sizeof(*initial_state));
+    benchmark_state = (ScriptBenchmarkState*)MALLOC(sizeof(*benchmark_state));
+    script_benchmark_save(initial_state, OBJ_HANDLE_NULL);
+
+    elapsed[0] = 0;
+    elapsed[1] = 0;
+    checksum = 0;
+    mismatches = 0;
+    skipped = 0;
+
+    // Every heartbeat is run by the copying interpreter first, then script
+    // state is rolled back and it is run again in place. Both runs have to
+    // leave script state the same way. Other side effects (such as moving or
+    // floating lines) are not rolled back and happen twice.
+    for (pass = 0; pass < SCRIPT_BENCHMARK_PASSES; pass++) {
+        for (idx = 0; idx < num_objs; idx++) {
+            obj = objs[idx];
+            if (!obj_handle_is_valid(obj)) {
+                skipped++;
+                continue;
+            }
+
+            script_benchmark_save(benchmark_state, obj);
+
+            for (mode = 0; mode < 2; mode++) {
+                if (mode != 0) {
+                    if (!obj_handle_is_valid(obj)) {
+                        break;
+                    }
+
+                    script_benchmark_restore(benchmark_state, obj);
+                }
+
+                scr = benchmark_state->scr;
+                invocation.script = &scr;
+                invocation.line = 0;
+                invocation.triggerer_obj = obj;
+                invocation.attachee_obj = obj;
+                invocation.extra_obj = OBJ_HANDLE_NULL;
+                invocation.attachment_point = SAP_HEARTBEAT;
+
+                script_execute_copies = mode == 0;
+                start = SDL_GetPerformanceCounter();
+                rc = script_execute(&invocation);
+                elapsed[mode] += SDL_GetPerformanceCounter() - start;
+                script_execute_copies = false;
+
+                fingerprint[mode] = obj_handle_is_valid(obj)
+                    ? script_benchmark_fingerprint(rc, &scr, obj)
+                    : 0;
+            }
+
+            if (mode != 2) {
+                // Destroyed by the first run.
+                skipped++;
+            } else if (fingerprint[0] != fingerprint[1]) {
+                mismatches++;
+            } else {
+                checksum = checksum * 31 + fingerprint[1];
+            }
+        }
+    }
+
+    script_benchmark_restore(initial_state, OBJ_HANDLE_NULL);
+
+    tig_debug_printf("Script benchmark: %d heartbeats, %d passes, %d mismatches, %d skipped, checksum %08X, copied %.2f ms, in place %.2f ms\n",
+        num_objs,
+        SCRIPT_BENCHMARK_PASSES,
+        mismatches,
+        skipped,
+        checksum,
+        (double)elapsed[0] * 1000.0 / (double)SDL_GetPerformanceFrequency(),
+        (double)elapsed[1] * 1000.0 / (double)SDL_GetPerformanceFrequency());
+
+    FREE(benchmark_state);
+    FREE(initial_state);
+    FREE(objs);
+}
+
+int cache_lookup(int script_id)
+{
+    unsigned int mask;
+    unsigned int slot;
+    int value;
+
+    mask = (unsigned int)script_cache_index_capacity - 1;
+    slot = ((unsigned int)script_id * 2654435761u) & mask;
+    while ((value = script_cache_index[slot]) != 0) {
+        if (value != SCRIPT_CACHE_INDEX_DELETED
+            && script_cache_entries[value - 1].script_id == script_id) {
+            return value - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return -1;
+}
+
+void cache_index_insert(int cache_entry_id)
+{
+    unsigned int mask;
+    unsigned int slot;
+
+    // Keep at least a quarter of the slots empty so probes terminate
+    // quickly, dropping deleted slots along the way.
+    if ((script_cache_index_used + 1) * 4 > script_cache_index_capacity * 3) {
+        cache_index_rebuild(script_cache_capacity * 4 > script_cache_index_capacity
+                ? script_cache_index_capacity * 2
+                : script_cache_index_capacity);
+
+        // Rebuilding indexes every entry with a script, including this one.
+        return;
+    }
+
+    mask = (unsigned int)script_cache_index_capacity - 1;
+    slot = ((unsigned int)script_cache_entries[cache_entry_id].script_id * 2654435761u) & mask;
+    while (script_cache_index[slot] > 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    if (script_cache_index[slot] == 0) {
+        script_cache_index_used++;
+    }
+
+    script_cache_index[slot] = cache_entry_id + 1;
+}
+
+void cache_index_remove(int cache_entry_id)
+{
+    unsigned int mask;
+    unsigned int slot;
+
+    mask = (unsigned int)script_cache_index_capacity - 1;
+    slot = ((unsigned int)script_cache_entries[cache_entry_id].script_id * 2654435761u) & mask;
+    while (script_cache_index[slot] != 0) {
+        if (script_cache_index[slot] == cache_entry_id + 1) {
+            script_cache_index[slot] = SCRIPT_CACHE_INDEX_DELETED;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+void cache_index_rebuild(int capacity)
+{
+    int index;
+
+    if (script_cache_index != NULL) {
+        FREE(script_cache_index);
+    }
+
+    script_cache_index = (int*)CALLOC(capacity, sizeof(*script_cache_index));
+    script_cache_index_capacity = capacity;
+    script_cache_index_used = 0;
+
+    for (index = 0; index < script_cache_capacity; index++) {
+        if (script_cache_entries[index].script_id != 0) {
+            cache_index_insert(index);
+        }
+    }
+}
+
+void script_benchmark_save(ScriptBenchmarkState* benchmark_state, int64_t obj)
+{
+    memcpy(benchmark_state->global_vars, script_global_vars, sizeof(benchmark_state->global_vars));
+    memcpy(benchmark_state->global_flags, script_global_flags, sizeof(benchmark_state->global_flags));
+    benchmark_state->story_state = script_story_state;
+
+    if (obj != OBJ_HANDLE_NULL) {
+        obj_arrayfield_script_get(obj, OBJ_F_SCRIPTS_IDX, SAP_HEARTBEAT, &(benchmark_state->scr));
+    }
+}
+
+void script_benchmark_restore(ScriptBenchmarkState* benchmark_state, int64_t obj)
+{
+    memcpy(script_global_vars, benchmark_state->global_vars, sizeof(benchmark_state->global_vars));
+    memcpy(script_global_flags, benchmark_state->global_flags, sizeof(benchmark_state->global_flags));
+    script_story_state = benchmark_state->story_state;
+
+    if (obj != OBJ_HANDLE_NULL) {
+        obj_arrayfield_script_set(obj, OBJ_F_SCRIPTS_IDX, SAP_HEARTBEAT, &(benchmark_state->scr));
+    }
+}
+
+// FNV-1a over invocation result and script state it could have changed.
+unsigned int script_benchmark_fingerprint(bool rc, Script* scr, int64_t obj)
+{
+    Script stored_scr;
+    unsigned int hash = 2166136261u;
+    int index;
+
+    obj_arrayfield_script_get(obj, OBJ_F_SCRIPTS_IDX, SAP_HEARTBEAT, &stored_scr);
+
+    hash = (hash ^ (rc ? 1 : 0)) * 16777619u;
+    hash = (hash ^ (unsigned int)scr->num) * 16777619u;
+    hash = (hash ^ scr->hdr.flags) * 16777619u;
+    hash = (hash ^ scr->hdr.counters) * 16777619u;
+    hash = (hash ^ (unsigned int)stored_scr.num) * 16777619u;
+    hash = (hash ^ stored_scr.hdr.flags) * 16777619u;
+    hash = (hash ^ stored_scr.hdr.counters) * 16777619u;
+
+    for (index = 0; index < MAX_GLOBAL_VARS; index++) {
+        hash = (hash ^ (unsigned int)script_global_vars[index]) * 16777619u;
+    }
+
+    for (index = 0; index < MAX_GLOBAL_FLAGS; index++) {
+        hash = (hash ^ (unsigned int)script_global_flags[index]) * 16777619u;
+    }
+
+    hash = (hash ^ (unsigned int)script_story_state) * 16777619u;
+
+    return hash;
+}
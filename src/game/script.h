@@ -380,6 +380,7 @@ bool script_timeevent_process(TimeEvent* timeevent);
 bool script_load_hdr(Script* scr);
 bool script_flags(Script* scr, ScriptFlags* flags_ptr);
 void script_play_explosion_fx(int64_t obj);
+void script_benchmark();
 
 static inline bool sfo_is_any(uint8_t type)
 {
@@ -3,11 +3,16 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#include "game/ai.h"
+#include "game/anim.h"
 #include "game/gamelib.h"
 #include "game/li.h"
 #include "game/map.h"
+#include "game/obj.h"
 #include "game/obj_file.h"
 #include "game/obj_private.h"
+#include "game/path.h"
+#include "game/player.h"
 #include "game/terrain.h"
 #include "game/tile.h"
 #include "game/timeevent.h"
@@ -46,6 +51,46 @@ typedef struct SectorHistoryEntry {
 // Serializeable.
 static_assert(sizeof(SectorHistoryEntry) == 0x10, "wrong size");
 
+#define SECTOR_PREFETCH_MAX_JOBS 8
+
+// Distance (in tiles) ahead of the player which is expected to become visible
+// soon. Sectors are 64x64 tiles.
+#define SECTOR_PREFETCH_LOOKAHEAD 48
+
+// Half-width (in tiles) of the band around the movement line which is
+// prefetched along with the sector straight ahead.
+#define SECTOR_PREFETCH_SPREAD 24
+
+// Location changes between pings larger than this are teleports rather than
+// movement, and are not used for prediction.
+#define SECTOR_PREFETCH_MAX_STEP 16
+
+typedef enum SectorPrefetchJobState {
+    SECTOR_PREFETCH_JOB_FREE,
+    SECTOR_PREFETCH_JOB_QUEUED,
+    SECTOR_PREFETCH_JOB_READING,
+    SECTOR_PREFETCH_JOB_DONE,
+} SectorPrefetchJobState;
+
+typedef struct SectorPrefetchJob {
+    SectorPrefetchJobState state;
+    unsigned int seq;
+    int64_t id;
+
+    // Resolved by the main thread, read by the worker.
+    TigFileSource sec_source;
+    TigFileSource dif_source;
+    bool has_dif;
+
+    // Staging buffers with raw contents of the sector and differences files.
+    void* sec_data;
+    size_t sec_size;
+    void* dif_data;
+    size_t dif_size;
+
+    bool ok;
+} SectorPrefetchJob;
+
 static bool sector_cache_init(unsigned int capacity);
 static void sector_block_clear();
 static void sector_history_clear();
@@ -73,6 +118,18 @@ static void sector_block_add(int64_t sec);
 static void sector_block_remove(int idx);
 static bool sector_block_save_internal();
 static bool sector_block_load_internal(const char* base_map_name, const char* current_map_name);
+static void sector_build_path(char* path, const char* dir, int64_t id, const char* ext);
+static bool sector_prefetch_init();
+static void sector_prefetch_exit();
+static int SDLCALL sector_prefetch_worker(void* userdata);
+static void sector_prefetch_read(SectorPrefetchJob* job);
+static SectorPrefetchJob* sector_prefetch_find_job(int64_t id);
+static SectorPrefetchJob* sector_prefetch_alloc_job();
+static void sector_prefetch_request(int64_t id);
+static bool sector_prefetch_take(int64_t id, TigFile** sec_stream_ptr, TigFile** dif_stream_ptr);
+static void sector_prefetch_discard(SectorPrefetchJob* job);
+static void sector_prefetch_cancel_all();
+static void sector_read_files(const char* sec_path, const char* dif_path, TigFile** sec_stream_ptr, TigFile** dif_stream_ptr);
 
 // 0x5B7CD0
 static DateTime qword_5B7CD0 = { -1, -1 };
@@ -197,6 +254,28 @@ static unsigned int sector_history_size;
 // 0x601838
 static int sector_refcount;
 
+// Sector prefetcher.
+//
+// Sectors the player is heading to are predicted in `sector_ping`. Their
+// files are looked up on the main thread (file system is not thread-safe),
+// and read into staging buffers by the worker through handles of its own (see
+// `tig_file_detach`). `sector_load_game` parses staged
+// data instead of reading files, objects and lights are materialized on the
+// main thread as usual.
+//
+// The mutex guards job states. Job contents are owned by whoever moved job
+// into `QUEUED` (main thread), `READING` (worker or main thread), or `DONE`
+// (main thread) state.
+static SDL_Mutex* sector_prefetch_mutex;
+static SDL_Condition* sector_prefetch_queued_cond;
+static SDL_Condition* sector_prefetch_done_cond;
+static SDL_Thread* sector_prefetch_thread;
+static bool sector_prefetch_quit;
+static unsigned int sector_prefetch_seq;
+static SectorPrefetchJob sector_prefetch_jobs[SECTOR_PREFETCH_MAX_JOBS];
+static int64_t sector_prefetch_last_loc;
+static SectorPrefetchStats sector_prefetch_stats_data;
+
 // 0x4CEF70
 bool sector_init(GameInitInfo* init_info)
 {
@@ -229,6 +308,10 @@ bool sector_init(GameInitInfo* init_info)
         return false;
     }
 
+    if (!sector_editor && !sector_prefetch_init()) {
+        tig_debug_printf("Sector: prefetch worker is not available, sectors are loaded synchronously\n");
+    }
+
     return true;
 }
 
@@ -247,6 +330,7 @@ void sector_exit()
     Sector* sector;
 
     sub_4D0B40();
+    sector_prefetch_exit();
 
     while (sector_list_free_node_head != NULL) {
         node = sector_list_free_node_head->next;
@@ -824,6 +908,9 @@ void sector_list_destroy(SectorListNode* node)
 // 0x4D0440
 bool sector_map_name_set(const char* base_path, const char* save_path)
 {
+    // Staged files belong to the previous map.
+    sector_prefetch_cancel_all();
+
     strcpy(sector_base_path, base_path);
     strcpy(sector_save_path, save_path);
 
@@ -863,6 +950,8 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
     unsigned int index;
     unsigned int oldest = -1;
     DateTime datetime;
+    tig_timestamp_t load_start;
+    bool loaded;
 
     if (in_sector_lock) {
         tig_debug_printf("Warning: recursive sector lock detected\n");
@@ -948,7 +1037,11 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
         cache_entry = &(sector_cache_entries[index]);
         cache_entry->sector.datetime = datetime;
 
-        if (!sector_load_func(id, &(cache_entry->sector))) {
+        tig_timer_now(&load_start);
+        loaded = sector_load_func(id, &(cache_entry->sector));
+        sector_prefetch_stats_data.stall_time += tig_timer_elapsed(load_start);
+
+        if (!loaded) {
             tig_debug_printf("Error: attempt to lock sector %I64u in cache failed due to error in load.  This is bad.  Help.\n", id);
             in_sector_lock = false;
             return false;
@@ -964,6 +1057,10 @@ bool sector_lock(int64_t id, Sector** sector_ptr)
         cache_entry->refcount = 1;
         cache_entry->timestamp = dword_6017BC;
         cache_entry->sector.id = id;
+
+        // The sector might have changed since its pathfinding data was
+        // built.
+        path_cluster_invalidate(id);
     }
 
     *sector_ptr = &(cache_entry->sector);
@@ -1000,6 +1097,11 @@ void sub_4D0B40()
     }
 
     sector_cache_size = 0;
+
+    path_cluster_invalidate_all();
+
+    sector_prefetch_cancel_all();
+    sector_prefetch_last_loc = 0;
 }
 
 // 0x4D0BC0
@@ -1290,6 +1392,9 @@ void sub_4D1400(Sector* sector)
         sector_history_entries[sector_history_size].id = sector->id;
         sector_history_entries[sector_history_size].datetime = datetime_get_current();
         sector_history_size++;
+
+        // Blocking objects of this sector are going away.
+        ai_los_cache_invalidate();
     }
 
     sector->flags = SECTOR_IS_NEW;
@@ -1458,10 +1563,16 @@ bool sector_load_game(int64_t id, Sector* sector)
     char sec_path[TIG_MAX_PATH];
     char dif_path[TIG_MAX_PATH];
     TigFile* sec_stream;
-    TigFile* dif_stream;
+    TigFile* dif_stream = NULL;
     int placeholder;
-
-    if (sector_check_demo_limits(id)) {
+    bool prefetched;
+
+    prefetched = sector_prefetch_take(id, &sec_stream, &dif_stream);
+    if (prefetched) {
+        // Only sectors with their own sector file are prefetched, see
+        // `sector_prefetch_request`.
+        sector_build_path(sec_path, sector_base_path, id, ".sec");
+    } else if (sector_check_demo_limits(id)) {
         strcpy(sec_path, sector_base_path);
         strcat(sec_path, "\\");
         SDL_ulltoa(id, &sec_path[strlen(sec_path)], 10);
@@ -1493,29 +1604,22 @@ bool sector_load_game(int64_t id, Sector* sector)
     sector_validate_game("sector pre-load");
     if (!generated) {
         li_update();
-        sec_stream = tig_file_fopen(sec_path, "rb");
-        if (sec_stream == NULL) {
-            tig_debug_printf("Error opening sector file %s\n", sec_path);
-        }
 
         strcpy(dif_path, sector_save_path);
         strcat(dif_path, "\\");
         SDL_ulltoa(id, &dif_path[strlen(dif_path)], 10);
         strcat(dif_path, ".dif");
 
-        if (tig_file_exists(dif_path, NULL)) {
-            dif_stream = tig_file_fopen(dif_path, "rb");
-            if (dif_stream != NULL) {
-                if (tig_file_fread(&dif_flags, sizeof(dif_flags), 1, dif_stream) != 1) {
-                    tig_debug_printf("Error reading flags from sector differences file %s\n", dif_path);
-                    tig_file_fclose(dif_stream);
-                    dif_stream = NULL;
-                }
-            } else {
-                tig_debug_printf("Error opening sector differences file %s\n", dif_path);
+        if (!prefetched) {
+            sector_read_files(sec_path, dif_path, &sec_stream, &dif_stream);
+        }
+
+        if (dif_stream != NULL) {
+            if (tig_file_fread(&dif_flags, sizeof(dif_flags), 1, dif_stream) != 1) {
+                tig_debug_printf("Error reading flags from sector differences file %s\n", dif_path);
+                tig_file_fclose(dif_stream);
+                dif_stream = NULL;
             }
-        } else {
-            dif_stream = NULL;
         }
 
         li_update();
@@ -1707,7 +1811,10 @@ bool sector_load_game(int64_t id, Sector* sector)
         }
 
         tig_file_fclose(sec_stream);
-        if (dif_flags != 0) {
+
+        // NOTE: Original code closes differences file only when it has any
+        // flags set, leaking it otherwise.
+        if (dif_stream != NULL) {
             tig_file_fclose(dif_stream);
         }
     }
@@ -2208,6 +2315,7 @@ void sector_art_cache_clear()
 void sector_precache_art(Sector* sector)
 {
     int index;
+    int cnt;
 
     if (sector_art_cache_state > 0) {
         li_update();
@@ -2220,14 +2328,20 @@ void sector_precache_art(Sector* sector)
         sector_art_cache_sort();
         li_update();
 
+        // Drop duplicates, the list is sorted.
+        cnt = 0;
         for (index = 0; index < sector_art_cache_size; index++) {
-            while (index + 1 < sector_art_cache_size && sector_art_cache[index] == sector_art_cache[index + 1]) {
-                index++;
+            if (cnt == 0 || sector_art_cache[cnt - 1] != sector_art_cache[index]) {
+                sector_art_cache[cnt++] = sector_art_cache[index];
             }
-            tig_art_touch(sector_art_cache[index]);
-            li_update();
         }
 
+        // Read all files at once and decode them in the background.
+        if (cnt != 0) {
+            tig_art_prefetch_batch(sector_art_cache, cnt);
+        }
+        li_update();
+
         sector_art_cache_reset();
     }
 }
@@ -2363,3 +2477,469 @@ bool sector_block_load_internal(const char* base_map_name, const char* current_m
     tig_file_fclose(stream);
     return true;
 }
+
+void sector_ping(tig_timestamp_t timestamp)
+{
+    int64_t pc_obj;
+    int64_t loc;
+    int64_t prev_loc;
+    int64_t dx;
+    int64_t dy;
+    int64_t dist;
+    int64_t ahead_x;
+    int64_t ahead_y;
+    int64_t sec;
+    int64_t ahead_sec;
+    int side;
+
+    (void)timestamp;
+
+    if (sector_prefetch_thread == NULL || !map_is_valid()) {
+        return;
+    }
+
+    pc_obj = player_get_local_pc_obj();
+    if (pc_obj == OBJ_HANDLE_NULL) {
+        sector_prefetch_last_loc = 0;
+        return;
+    }
+
+    loc = obj_field_int64_get(pc_obj, OBJ_F_LOCATION);
+    if (loc == sector_prefetch_last_loc) {
+        return;
+    }
+
+    prev_loc = sector_prefetch_last_loc;
+    sector_prefetch_last_loc = loc;
+
+    if (prev_loc == 0 || !anim_is_running(pc_obj)) {
+        return;
+    }
+
+    dx = LOCATION_GET_X(loc) - LOCATION_GET_X(prev_loc);
+    dy = LOCATION_GET_Y(loc) - LOCATION_GET_Y(prev_loc);
+    dist = llabs(dx) > llabs(dy) ? llabs(dx) : llabs(dy);
+    if (dist > SECTOR_PREFETCH_MAX_STEP) {
+        return;
+    }
+
+    sec = sector_id_from_loc(loc);
+
+    // Sample the point straight ahead, and two points to the sides of it
+    // (perpendicular to movement), so that sectors entering the view at an
+    // angle are covered too.
+    for (side = 0; side < 3; side++) {
+        ahead_x = LOCATION_GET_X(loc) + dx * SECTOR_PREFETCH_LOOKAHEAD / dist;
+        ahead_y = LOCATION_GET_Y(loc) + dy * SECTOR_PREFETCH_LOOKAHEAD / dist;
+
+        if (side == 1) {
+            ahead_x -= dy * SECTOR_PREFETCH_SPREAD / dist;
+            ahead_y += dx * SECTOR_PREFETCH_SPREAD / dist;
+        } else if (side == 2) {
+            ahead_x += dy * SECTOR_PREFETCH_SPREAD / dist;
+            ahead_y -= dx * SECTOR_PREFETCH_SPREAD / dist;
+        }
+
+        if (ahead_x < 0 || ahead_y < 0) {
+            continue;
+        }
+
+        ahead_sec = sector_id_from_loc(location_make(ahead_x, ahead_y));
+        if (ahead_sec != sec) {
+            sector_prefetch_request(ahead_sec);
+        }
+    }
+}
+
+void sector_prefetch_stats(SectorPrefetchStats* stats)
+{
+    *stats = sector_prefetch_stats_data;
+}
+
+void sector_prefetch_reset_stats()
+{
+    memset(&sector_prefetch_stats_data, 0, sizeof(sector_prefetch_stats_data));
+}
+
+void sector_build_path(char* path, const char* dir, int64_t id, const char* ext)
+{
+    strcpy(path, dir);
+    strcat(path, "\\");
+    SDL_ulltoa(id, &path[strlen(path)], 10);
+    strcat(path, ext);
+}
+
+bool sector_prefetch_init()
+{
+    sector_prefetch_quit = false;
+
+    sector_prefetch_mutex = SDL_CreateMutex();
+    sector_prefetch_queued_cond = SDL_CreateCondition();
+    sector_prefetch_done_cond = SDL_CreateCondition();
+    if (sector_prefetch_mutex == NULL
+        || sector_prefetch_queued_cond == NULL
+        || sector_prefetch_done_cond == NULL) {
+        sector_prefetch_exit();
+        return false;
+    }
+
+    sector_prefetch_thread = SDL_CreateThread(sector_prefetch_worker, "sector_prefetch", NULL);
+    if (sector_prefetch_thread == NULL) {
+        sector_prefetch_exit();
+        return false;
+    }
+
+    return true;
+}
+
+void sector_prefetch_exit()
+{
+    int index;
+
+    if (sector_prefetch_thread != NULL) {
+        SDL_LockMutex(sector_prefetch_mutex);
+        sector_prefetch_quit = true;
+        SDL_BroadcastCondition(sector_prefetch_queued_cond);
+        SDL_UnlockMutex(sector_prefetch_mutex);
+
+        SDL_WaitThread(sector_prefetch_thread, NULL);
+        sector_prefetch_thread = NULL;
+    }
+
+    // Worker is gone, remaining jobs can be released without locking.
+    for (index = 0; index < SECTOR_PREFETCH_MAX_JOBS; index++) {
+        if (sector_prefetch_jobs[index].state != SECTOR_PREFETCH_JOB_FREE) {
+            sector_prefetch_discard(&(sector_prefetch_jobs[index]));
+        }
+    }
+
+    if (sector_prefetch_done_cond != NULL) {
+        SDL_DestroyCondition(sector_prefetch_done_cond);
+        sector_prefetch_done_cond = NULL;
+    }
+
+    if (sector_prefetch_queued_cond != NULL) {
+        SDL_DestroyCondition(sector_prefetch_queued_cond);
+        sector_prefetch_queued_cond = NULL;
+    }
+
+    if (sector_prefetch_mutex != NULL) {
+        SDL_DestroyMutex(sector_prefetch_mutex);
+        sector_prefetch_mutex = NULL;
+    }
+}
+
+int SDLCALL sector_prefetch_worker(void* userdata)
+{
+    SectorPrefetchJob* job;
+    int index;
+
+    (void)userdata;
+
+    SDL_LockMutex(sector_prefetch_mutex);
+
+    while (!sector_prefetch_quit) {
+        // Pick the oldest request.
+        job = NULL;
+        for (index = 0; index < SECTOR_PREFETCH_MAX_JOBS; index++) {
+            if (sector_prefetch_jobs[index].state == SECTOR_PREFETCH_JOB_QUEUED
+                && (job == NULL || (int)(sector_prefetch_jobs[index].seq - job->seq) < 0)) {
+                job = &(sector_prefetch_jobs[index]);
+            }
+        }
+
+        if (job == NULL) {
+            SDL_WaitCondition(sector_prefetch_queued_cond, sector_prefetch_mutex);
+            continue;
+        }
+
+        job->state = SECTOR_PREFETCH_JOB_READING;
+        SDL_UnlockMutex(sector_prefetch_mutex);
+
+        sector_prefetch_read(job);
+
+        SDL_LockMutex(sector_prefetch_mutex);
+        job->state = SECTOR_PREFETCH_JOB_DONE;
+        SDL_BroadcastCondition(sector_prefetch_done_cond);
+    }
+
+    SDL_UnlockMutex(sector_prefetch_mutex);
+
+    return 0;
+}
+
+// Reads sector and differences files into staging buffers. Only touches job's
+// own file sources, so it's safe to call from the worker.
+void sector_prefetch_read(SectorPrefetchJob* job)
+{
+    job->ok = tig_file_read_detached(&(job->sec_source), &(job->sec_data), &(job->sec_size));
+
+    if (job->ok && job->has_dif) {
+        job->ok = tig_file_read_detached(&(job->dif_source), &(job->dif_data), &(job->dif_size));
+    }
+}
+
+// NOTE: Must be called with `sector_prefetch_mutex` held.
+SectorPrefetchJob* sector_prefetch_find_job(int64_t id)
+{
+    int index;
+
+    for (index = 0; index < SECTOR_PREFETCH_MAX_JOBS; index++) {
+        if (sector_prefetch_jobs[index].state != SECTOR_PREFETCH_JOB_FREE
+            && sector_prefetch_jobs[index].id == id) {
+            return &(sector_prefetch_jobs[index]);
+        }
+    }
+
+    return NULL;
+}
+
+// Finds free job slot, evicting the oldest unclaimed prefetch if there is
+// none.
+//
+// NOTE: Must be called with `sector_prefetch_mutex` held.
+SectorPrefetchJob* sector_prefetch_alloc_job()
+{
+    SectorPrefetchJob* oldest = NULL;
+    int index;
+
+    for (index = 0; index < SECTOR_PREFETCH_MAX_JOBS; index++) {
+        if (sector_prefetch_jobs[index].state == SECTOR_PREFETCH_JOB_FREE) {
+            return &(sector_prefetch_jobs[index]);
+        }
+
+        if (sector_prefetch_jobs[index].state == SECTOR_PREFETCH_JOB_DONE
+            && (oldest == NULL || (int)(sector_prefetch_jobs[index].seq - oldest->seq) < 0)) {
+            oldest = &(sector_prefetch_jobs[index]);
+        }
+    }
+
+    if (oldest != NULL) {
+        sector_prefetch_stats_data.wasted++;
+        sector_prefetch_discard(oldest);
+    }
+
+    return oldest;
+}
+
+// Queues sector for prefetch (main thread only).
+void sector_prefetch_request(int64_t id)
+{
+    SectorPrefetchJob* job;
+    char path[TIG_MAX_PATH];
+    int index;
+
+    if (SECTOR_X(id) >= sector_limit_x || SECTOR_Y(id) >= sector_limit_y) {
+        return;
+    }
+
+    if (sector_cache_find_by_id(id, &index)) {
+        return;
+    }
+
+    SDL_LockMutex(sector_prefetch_mutex);
+    job = sector_prefetch_find_job(id);
+    SDL_UnlockMutex(sector_prefetch_mutex);
+
+    if (job != NULL) {
+        return;
+    }
+
+    // Sectors beyond demo limits, and sectors without sector file are built
+    // from terrain, there is no point to prefetch them.
+    if (!sector_check_demo_limits(id)) {
+        return;
+    }
+
+    sector_build_path(path, sector_base_path, id, ".sec");
+    if (!tig_file_exists(path, NULL)) {
+        return;
+    }
+
+    SDL_LockMutex(sector_prefetch_mutex);
+    job = sector_prefetch_alloc_job();
+    SDL_UnlockMutex(sector_prefetch_mutex);
+
+    if (job == NULL) {
+        return;
+    }
+
+    if (!tig_file_detach(path, &(job->sec_source))) {
+        return;
+    }
+
+    job->has_dif = false;
+
+    sector_build_path(path, sector_save_path, id, ".dif");
+    if (tig_file_exists(path, NULL)) {
+        if (!tig_file_detach(path, &(job->dif_source))) {
+            tig_file_source_release(&(job->sec_source));
+            return;
+        }
+
+        job->has_dif = true;
+    }
+
+    job->id = id;
+    job->ok = false;
+
+    SDL_LockMutex(sector_prefetch_mutex);
+    job->seq = sector_prefetch_seq++;
+    job->state = SECTOR_PREFETCH_JOB_QUEUED;
+    SDL_SignalCondition(sector_prefetch_queued_cond);
+    SDL_UnlockMutex(sector_prefetch_mutex);
+
+    sector_prefetch_stats_data.requests++;
+}
+
+// Claims staged data of the sector as memory streams. If the sector is still
+// in the queue it is read right away, if it's being read by the worker - waits
+// for it.
+//
+// Returns `false` if there is no such job, or it has failed. In this case the
+// caller is expected to read sector files itself.
+bool sector_prefetch_take(int64_t id, TigFile** sec_stream_ptr, TigFile** dif_stream_ptr)
+{
+    SectorPrefetchJob* job;
+    bool read;
+    bool ok;
+
+    if (sector_prefetch_thread == NULL) {
+        return false;
+    }
+
+    SDL_LockMutex(sector_prefetch_mutex);
+
+    job = sector_prefetch_find_job(id);
+    if (job == NULL) {
+        SDL_UnlockMutex(sector_prefetch_mutex);
+        sector_prefetch_stats_data.misses++;
+        return false;
+    }
+
+    read = false;
+    if (job->state == SECTOR_PREFETCH_JOB_QUEUED) {
+        // Don't wait for the worker to pick it up.
+        job->state = SECTOR_PREFETCH_JOB_READING;
+        read = true;
+    } else {
+        while (job->state != SECTOR_PREFETCH_JOB_DONE) {
+            SDL_WaitCondition(sector_prefetch_done_cond, sector_prefetch_mutex);
+        }
+    }
+
+    SDL_UnlockMutex(sector_prefetch_mutex);
+
+    if (read) {
+        sector_prefetch_read(job);
+
+        SDL_LockMutex(sector_prefetch_mutex);
+        job->state = SECTOR_PREFETCH_JOB_DONE;
+        SDL_UnlockMutex(sector_prefetch_mutex);
+    }
+
+    ok = job->ok;
+    if (ok) {
+        // Streams own staging buffers now.
+        *sec_stream_ptr = tig_file_fopen_memory(job->sec_data, job->sec_size);
+        job->sec_data = NULL;
+
+        if (job->dif_data != NULL) {
+            *dif_stream_ptr = tig_file_fopen_memory(job->dif_data, job->dif_size);
+            job->dif_data = NULL;
+        } else {
+            *dif_stream_ptr = NULL;
+        }
+
+        sector_prefetch_stats_data.hits++;
+    } else {
+        sector_prefetch_stats_data.misses++;
+    }
+
+    sector_prefetch_discard(job);
+
+    return ok;
+}
+
+// Releases job resources (main thread only). The job must not be in `READING`
+// state.
+void sector_prefetch_discard(SectorPrefetchJob* job)
+{
+    tig_file_source_release(&(job->sec_source));
+    tig_file_source_release(&(job->dif_source));
+    job->has_dif = false;
+
+    if (job->sec_data != NULL) {
+        FREE(job->sec_data);
+        job->sec_data = NULL;
+    }
+
+    if (job->dif_data != NULL) {
+        FREE(job->dif_data);
+        job->dif_data = NULL;
+    }
+
+    job->state = SECTOR_PREFETCH_JOB_FREE;
+}
+
+void sector_prefetch_cancel_all()
+{
+    int index;
+
+    if (sector_prefetch_thread == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(sector_prefetch_mutex);
+
+    for (index = 0; index < SECTOR_PREFETCH_MAX_JOBS; index++) {
+        while (sector_prefetch_jobs[index].state == SECTOR_PREFETCH_JOB_READING) {
+            SDL_WaitCondition(sector_prefetch_done_cond, sector_prefetch_mutex);
+        }
+
+        if (sector_prefetch_jobs[index].state != SECTOR_PREFETCH_JOB_FREE) {
+            sector_prefetch_stats_data.wasted++;
+            sector_prefetch_discard(&(sector_prefetch_jobs[index]));
+        }
+    }
+
+    SDL_UnlockMutex(sector_prefetch_mutex);
+}
+
+// Reads sector file and, if there is one, differences file in one batch, and
+// opens memory streams over them.
+//
+// NOTE: The batch only runs archived files in parallel. Loose files (which is
+// where differences files are) are read serially before archived sector file
+// is inflated, so the two reads do not overlap.
+void sector_read_files(const char* sec_path, const char* dif_path, TigFile** sec_stream_ptr, TigFile** dif_stream_ptr)
+{
+    TigFileBatchEntry entries[2];
+    int cnt;
+
+    entries[0].path = sec_path;
+    cnt = 1;
+
+    if (tig_file_exists(dif_path, NULL)) {
+        entries[1].path = dif_path;
+        cnt++;
+    }
+
+    tig_file_read_batch(entries, cnt);
+
+    *sec_stream_ptr = NULL;
+    if (entries[0].data != NULL) {
+        *sec_stream_ptr = tig_file_fopen_memory(entries[0].data, entries[0].size);
+    } else {
+        tig_debug_printf("Error opening sector file %s\n", sec_path);
+    }
+
+    *dif_stream_ptr = NULL;
+    if (cnt > 1) {
+        if (entries[1].data != NULL) {
+            *dif_stream_ptr = tig_file_fopen_memory(entries[1].data, entries[1].size);
+        } else {
+            tig_debug_printf("Error opening sector differences file %s\n", dif_path);
+        }
+    }
+}
@@ -38,6 +38,24 @@ typedef struct Sector {
     /* 485C */ SectorObjectList objects;
 } Sector;
 
+// Sector prefetch counters, see `sector_prefetch_stats`.
+typedef struct SectorPrefetchStats {
+    // Number of sectors queued for prefetch.
+    unsigned int requests;
+
+    // Number of sector loads served from prefetched data.
+    unsigned int hits;
+
+    // Number of sector loads which had to read sector files synchronously.
+    unsigned int misses;
+
+    // Number of prefetched sectors which were dropped without being loaded.
+    unsigned int wasted;
+
+    // Total time (in milliseconds) spent loading sectors in `sector_lock`.
+    tig_duration_t stall_time;
+} SectorPrefetchStats;
+
 typedef bool(SectorEnumerateFunc)(Sector* sector);
 typedef bool(SectorLockFunc)(const char* path);
 
@@ -81,6 +99,13 @@ void sector_history_exit();
 bool sector_history_save(TigFile* stream);
 bool sector_history_load(GameLoadInfo* load_info);
 
+// Predicts sectors the player is heading to and prefetches them in the
+// background.
+void sector_ping(tig_timestamp_t timestamp);
+
+void sector_prefetch_stats(SectorPrefetchStats* stats);
+void sector_prefetch_reset_stats();
+
 #define SECTOR_X(a) ((a) & 0x3FFFFFF)
 #define SECTOR_Y(a) (((a) >> 26) & 0x3FFFFFF)
 #define SECTOR_MAKE(a, b) ((a) | ((b) << 26))
@@ -17,6 +17,8 @@
 static void sub_4F20A0(SectorObjectList* list, ObjectNode* node);
 static bool objlist_insert_internal(SectorObjectList* list, int64_t obj);
 static bool objlist_remove_internal(SectorObjectList* list, int64_t obj, ObjectNode** node_ptr);
+static void objlist_cell_add(SectorObjectList* list, int tile, int64_t obj);
+static void objlist_cell_remove(SectorObjectList* list, int tile, int64_t obj);
 
 // 0x4F1150
 bool sector_object_list_init(SectorObjectList* list)
@@ -49,6 +51,9 @@ bool sector_object_list_reset(SectorObjectList* list)
         }
     }
 
+    memset(list->cell_types, 0, sizeof(list->cell_types));
+    memset(list->cell_type_counts, 0, sizeof(list->cell_type_counts));
+
     return true;
 }
 
@@ -573,6 +578,8 @@ void sub_4F20A0(SectorObjectList* list, ObjectNode* new_node)
     sub_4F2230(new_node->obj, &v1, &v2);
     new_obj_tile = tile_id_from_loc(new_obj_loc);
 
+    objlist_cell_add(list, new_obj_tile, new_node->obj);
+
     node_ptr = &(list->heads[new_obj_tile]);
     while (*node_ptr != NULL) {
         flags = obj_field_int32_get((*node_ptr)->obj, OBJ_F_FLAGS);
@@ -667,6 +674,7 @@ bool objlist_remove_internal(SectorObjectList* list, int64_t obj, ObjectNode** n
             }
             *node_ptr = node;
             node->next = NULL;
+            objlist_cell_remove(list, tile, obj);
             return true;
         }
         prev = node;
@@ -729,3 +737,28 @@ void objlist_notify_sector_changed(int64_t sec, int64_t pc_obj)
 
     ui_notify_sector_changed(sec, pc_obj);
 }
+
+void objlist_cell_add(SectorObjectList* list, int tile, int64_t obj)
+{
+    int cell;
+    int type;
+
+    cell = OBJLIST_CELL_OF_TILE(tile);
+    type = obj_field_int32_get(obj, OBJ_F_TYPE);
+    if (list->cell_type_counts[cell][type]++ == 0) {
+        list->cell_types[cell] |= 1u << type;
+    }
+}
+
+void objlist_cell_remove(SectorObjectList* list, int tile, int64_t obj)
+{
+    int cell;
+    int type;
+
+    cell = OBJLIST_CELL_OF_TILE(tile);
+    type = obj_field_int32_get(obj, OBJ_F_TYPE);
+    if (list->cell_type_counts[cell][type] != 0
+        && --list->cell_type_counts[cell][type] == 0) {
+        list->cell_types[cell] &= ~(1u << type);
+    }
+}
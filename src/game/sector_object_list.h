@@ -1,12 +1,27 @@
 #ifndef ARCANUM_GAME_SECTOR_OBJECT_LIST_H_
 #define ARCANUM_GAME_SECTOR_OBJECT_LIST_H_
 
+#include "game/obj.h"
 #include "game/object_node.h"
 
+// Objects are additionally tracked per 8x8 tile cell so that range queries
+// can skip parts of a sector without walking individual tiles.
+#define OBJLIST_CELL_SIZE 8
+#define OBJLIST_CELLS_PER_ROW (64 / OBJLIST_CELL_SIZE)
+#define OBJLIST_CELL_COUNT (OBJLIST_CELLS_PER_ROW * OBJLIST_CELLS_PER_ROW)
+#define OBJLIST_CELL_OF_TILE(tile) (((((tile) >> 6) & 0x3F) / OBJLIST_CELL_SIZE) * OBJLIST_CELLS_PER_ROW + ((tile) & 0x3F) / OBJLIST_CELL_SIZE)
+
 typedef struct SectorObjectList {
     /* 0000 */ ObjectNode* heads[4096];
     /* 4000 */ int modified;
     /* 4004 */ int next_temp_id;
+
+    // Bitmask of object types (`1 << OBJ_TYPE_xxx`, which matches the
+    // `OBJ_TM_xxx` query flags) present in each cell.
+    unsigned int cell_types[OBJLIST_CELL_COUNT];
+
+    // Number of objects of each type in each cell, backs `cell_types`.
+    uint16_t cell_type_counts[OBJLIST_CELL_COUNT][OBJ_TYPE_COUNT];
 } SectorObjectList;
 
 bool sector_object_list_init(SectorObjectList* list);
@@ -34,8 +34,23 @@ typedef enum PoisonEventType {
     POISON_EVENT_RECOVERY,
 } PoisonEventType;
 
+#define STAT_CACHE_CAPACITY 1024
+#define STAT_CACHE_MAX_SIZE (STAT_CACHE_CAPACITY / 4 * 3)
+
+typedef struct StatCacheEntry {
+    int64_t obj;
+    unsigned int epoch;
+    unsigned int valid;
+    int values[STAT_COUNT];
+} StatCacheEntry;
+
 static bool poison_timeevent_check(TimeEvent* timeevent);
 static bool poison_timeevent_schedule(int64_t obj, int poison, bool recovery);
+static int stat_level_compute(int64_t obj, int stat);
+static unsigned int stat_cache_hash(int64_t obj);
+static StatCacheEntry* stat_cache_find(int64_t obj, bool create);
+static void stat_cache_clear();
+static void stat_cache_verify(int64_t obj, int stat, int value);
 
 /**
  * Minimum values for each stat.
@@ -258,6 +273,31 @@ static char* stat_short_names[STAT_COUNT];
 // 0x5F8728
 static int64_t poison_test_obj;
 
+/**
+ * Effective stat levels of recently queried critters.
+ *
+ * The table uses open addressing keyed by object handle. Slots are never
+ * removed individually - invalidating an object clears its `valid` mask, while
+ * flushing bumps `stat_cache_epoch` which makes every entry stale. The table
+ * is wiped when it becomes too crowded.
+ */
+static StatCacheEntry stat_cache_entries[STAT_CACHE_CAPACITY];
+
+// Number of occupied slots in `stat_cache_entries`.
+static int stat_cache_size;
+
+// Current cache generation, entries from other generations are stale.
+static unsigned int stat_cache_epoch;
+
+// Set by stat computation when the result depends on the critter's
+// surroundings and thus cannot be cached.
+static bool stat_cache_uncacheable;
+
+// Whether cached values are checked against recomputed ones.
+static bool stat_cache_verify_enabled;
+
+static StatCacheStats stat_cache_stats_data;
+
 /**
  * Called when the game is initialized.
  *
@@ -306,6 +346,14 @@ bool stat_init(GameInitInfo* init_info)
     return true;
 }
 
+/**
+ * Called when the game is being reset.
+ */
+void stat_reset()
+{
+    stat_cache_clear();
+}
+
 /**
  * Called when the game shuts down.
  *
@@ -314,6 +362,7 @@ bool stat_init(GameInitInfo* init_info)
 void stat_exit()
 {
     mes_unload(stat_msg_file);
+    stat_cache_clear();
 }
 
 /**
@@ -337,11 +386,9 @@ void stat_set_defaults(int64_t obj)
  */
 int stat_level_get(int64_t obj, int stat)
 {
+    StatCacheEntry* entry;
+    bool uncacheable;
     int value;
-    int64_t loc;
-    tig_art_id_t art_id;
-    int min_value;
-    int max_value;
 
     // Ensure the object is a critter.
     if (!obj_type_is_critter(obj_field_int32_get(obj, OBJ_F_TYPE))) {
@@ -353,6 +400,57 @@ int stat_level_get(int64_t obj, int stat)
         return 0;
     }
 
+    entry = stat_cache_find(obj, false);
+    if (entry != NULL && (entry->valid & (1 << stat)) != 0) {
+        stat_cache_stats_data.hits++;
+        value = entry->values[stat];
+
+        if (stat_cache_verify_enabled) {
+            stat_cache_verify(obj, stat, value);
+            value = entry->values[stat];
+        }
+
+        return value;
+    }
+
+    stat_cache_stats_data.misses++;
+
+    // Derived stats are computed from other stats, which in turn might
+    // depend on the surroundings. Track this separately for every nested
+    // computation and propagate it to the outer one.
+    uncacheable = stat_cache_uncacheable;
+    stat_cache_uncacheable = false;
+
+    value = stat_level_compute(obj, stat);
+
+    if (stat_cache_uncacheable) {
+        stat_cache_stats_data.uncacheable++;
+    } else {
+        // Nested computations might have reorganized the table, so the entry
+        // is looked up again.
+        entry = stat_cache_find(obj, true);
+        if (entry != NULL) {
+            entry->values[stat] = value;
+            entry->valid |= 1 << stat;
+        }
+    }
+
+    stat_cache_uncacheable |= uncacheable;
+
+    return value;
+}
+
+/**
+ * Computes the effective stat level for a critter bypassing the cache.
+ */
+int stat_level_compute(int64_t obj, int stat)
+{
+    int value;
+    int64_t loc;
+    tig_art_id_t art_id;
+    int min_value;
+    int max_value;
+
     // Obtain base value.
     value = stat_base_get(obj, stat);
 
@@ -395,6 +493,7 @@ int stat_level_get(int64_t obj, int stat)
             // - Intelligence -2
             // - Willpower -2
             // - Strength +2
+            stat_cache_uncacheable = true;
             loc = obj_field_int64_get(obj, OBJ_F_LOCATION);
             art_id = tile_art_id_at(loc);
             if (tig_art_tile_id_type_get(art_id) == TIG_ART_TILE_TYPE_INDOOR) {
@@ -420,6 +519,7 @@ int stat_level_get(int64_t obj, int stat)
             // - Strength +2
             //
             // NOTE: Persuation bonus is applied via effects.
+            stat_cache_uncacheable = true;
             loc = obj_field_int64_get(obj, OBJ_F_LOCATION);
             art_id = tile_art_id_at(loc);
             if (a_name_tile_is_sinkable(art_id)) {
@@ -441,6 +541,7 @@ int stat_level_get(int64_t obj, int stat)
             // - Strength +2
             //
             // NOTE: Perception bonus is applied via effects.
+            stat_cache_uncacheable = true;
             if (sub_4DCE10(obj) < 128) {
                 if (stat == STAT_STRENGTH) {
                     value += 2;
@@ -470,6 +571,7 @@ int stat_level_get(int64_t obj, int stat)
             // night. Each stat is normally within 1-20 range (but upper bound
             // can be modified by race, which is not taken into account), so 20%
             // is 4 points.
+            stat_cache_uncacheable = true;
             if (game_time_is_day()) {
                 value += 4;
             } else {
@@ -479,6 +581,7 @@ int stat_level_get(int64_t obj, int stat)
         case BACKGROUND_NIGHT_MAGE:
             // 20% bonus to magickal aptitude at night, and 20% penalty during
             // the day.
+            stat_cache_uncacheable = true;
             if (game_time_is_day()) {
                 value -= 4;
             } else {
@@ -488,6 +591,7 @@ int stat_level_get(int64_t obj, int stat)
         case BACKGROUND_SKY_MAGE:
             // 20% bonus to magickal aptitude in outdoor areas, and 20% penalty
             // when indoors or underground.
+            stat_cache_uncacheable = true;
             loc = obj_field_int64_get(obj, OBJ_F_LOCATION);
             art_id = tile_art_id_at(loc);
             if (tig_art_tile_id_type_get(art_id) == TIG_ART_TILE_TYPE_INDOOR) {
@@ -500,6 +604,7 @@ int stat_level_get(int64_t obj, int stat)
             // 20% bonus to magickal aptitude when standing on natural surface,
             // and 20% penalty otherwise. The "naturalness" of the tile is set
             // with flags in `tilename.mes`.
+            stat_cache_uncacheable = true;
             loc = obj_field_int64_get(obj, OBJ_F_LOCATION);
             art_id = tile_art_id_at(loc);
             if (!a_name_tile_is_natural(art_id)) {
@@ -606,6 +711,7 @@ int stat_base_get(int64_t obj, int stat)
         case STAT_MAGICK_TECH_APTITUDE:
             value = (50 * stat_level_get(obj, STAT_MAGICK_POINTS) - 55 * stat_level_get(obj, STAT_TECH_POINTS)) / 10;
             value += magictech_get_aptitude_adj(sector_id_from_loc(obj_field_int64_get(obj, OBJ_F_LOCATION)));
+            stat_cache_uncacheable = true;
             break;
         default:
             // Should be unreachable.
@@ -1160,3 +1266,182 @@ bool poison_timeevent_schedule(int64_t obj, int poison, bool recovery)
 
     return true;
 }
+
+/**
+ * Drops cached stats of the specified object.
+ *
+ * Should be called whenever the object is changed in a way which might affect
+ * its stats (or the object is being destroyed).
+ */
+void stat_cache_invalidate(int64_t obj)
+{
+    StatCacheEntry* entry;
+
+    entry = stat_cache_find(obj, false);
+    if (entry != NULL && entry->valid != 0) {
+        entry->valid = 0;
+        stat_cache_stats_data.invalidations++;
+    }
+}
+
+/**
+ * Called by object system when a field of the specified object is changed.
+ *
+ * Stats are derived from critter's own fields (base stats, effects, flags),
+ * so it's enough to drop cached stats of the object being changed. There are
+ * couple of exceptions: spell flags of the player affect speed of every
+ * critter (Tempus Fugit), and prototype fields are inherited by instances.
+ */
+void stat_cache_field_changed(int64_t obj, int fld)
+{
+    // Fields which are updated during rendering and animation. The ones that
+    // might affect stats (location, light) only do so via surroundings, and
+    // such stats are never cached anyway.
+    if (fld >= OBJ_F_CURRENT_AID && fld <= OBJ_F_OVERLAY_LIGHT_COLOR) {
+        return;
+    }
+
+    switch (fld) {
+    case OBJ_F_RENDER_FLAGS:
+    case OBJ_F_LIGHT_HANDLE:
+    case OBJ_F_OVERLAY_LIGHT_HANDLES:
+    case OBJ_F_SHADOW_HANDLES:
+    case OBJ_F_FIND_NODE:
+        return;
+    }
+
+    if (stat_cache_size == 0) {
+        return;
+    }
+
+    if (fld == OBJ_F_SPELL_FLAGS || obj_is_proto(obj)) {
+        stat_cache_flush();
+        return;
+    }
+
+    stat_cache_invalidate(obj);
+}
+
+/**
+ * Drops all cached stats.
+ */
+void stat_cache_flush()
+{
+    if (stat_cache_size == 0) {
+        return;
+    }
+
+    stat_cache_epoch++;
+    stat_cache_stats_data.flushes++;
+
+    // Make sure entries from the previous cycle of epochs cannot be mistaken
+    // for fresh ones.
+    if (stat_cache_epoch == 0) {
+        stat_cache_clear();
+    }
+}
+
+/**
+ * Enables cross-checking of cached stats against recomputed values.
+ *
+ * Every cache hit is recomputed and mismatches are reported to the debug
+ * log. This is expensive and is only intended to catch missing invalidations.
+ */
+void stat_cache_verify_enable()
+{
+    stat_cache_verify_enabled = true;
+}
+
+void stat_cache_stats(StatCacheStats* stats)
+{
+    *stats = stat_cache_stats_data;
+}
+
+void stat_cache_reset_stats()
+{
+    memset(&stat_cache_stats_data, 0, sizeof(stat_cache_stats_data));
+}
+
+unsigned int stat_cache_hash(int64_t obj)
+{
+    uint64_t key = (uint64_t)obj;
+
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+
+    return (unsigned int)key & (STAT_CACHE_CAPACITY - 1);
+}
+
+StatCacheEntry* stat_cache_find(int64_t obj, bool create)
+{
+    StatCacheEntry* entry;
+    unsigned int index;
+    int probe;
+
+    index = stat_cache_hash(obj);
+    for (probe = 0; probe < STAT_CACHE_CAPACITY; probe++) {
+        entry = &(stat_cache_entries[index]);
+        if (entry->obj == obj) {
+            if (entry->epoch != stat_cache_epoch) {
+                entry->epoch = stat_cache_epoch;
+                entry->valid = 0;
+            }
+            return entry;
+        }
+
+        if (entry->obj == OBJ_HANDLE_NULL) {
+            if (!create) {
+                return NULL;
+            }
+
+            if (stat_cache_size >= STAT_CACHE_MAX_SIZE) {
+                // Too crowded, start over.
+                stat_cache_clear();
+                stat_cache_stats_data.flushes++;
+                entry = &(stat_cache_entries[stat_cache_hash(obj)]);
+            }
+
+            entry->obj = obj;
+            entry->epoch = stat_cache_epoch;
+            entry->valid = 0;
+            stat_cache_size++;
+            return entry;
+        }
+
+        index = (index + 1) & (STAT_CACHE_CAPACITY - 1);
+    }
+
+    return NULL;
+}
+
+void stat_cache_clear()
+{
+    memset(stat_cache_entries, 0, sizeof(stat_cache_entries));
+    stat_cache_size = 0;
+}
+
+void stat_cache_verify(int64_t obj, int stat, int value)
+{
+    StatCacheEntry* entry;
+    bool uncacheable;
+    int expected;
+
+    uncacheable = stat_cache_uncacheable;
+    expected = stat_level_compute(obj, stat);
+    stat_cache_uncacheable = uncacheable;
+
+    if (expected != value) {
+        tig_debug_printf("stat_cache_verify: Stat %d of object %llu is cached as %d, but should be %d.\n",
+            stat,
+            (unsigned long long)obj,
+            value,
+            expected);
+        stat_cache_stats_data.mismatches++;
+
+        entry = stat_cache_find(obj, false);
+        if (entry != NULL) {
+            entry->values[stat] = expected;
+        }
+    }
+}
@@ -59,9 +59,33 @@ typedef enum Race {
     RACE_COUNT,
 } Race;
 
+// Stat cache counters, see `stat_cache_stats`.
+typedef struct StatCacheStats {
+    // Number of `stat_level_get` calls served from the cache.
+    unsigned int hits;
+
+    // Number of `stat_level_get` calls which had to compute the stat.
+    unsigned int misses;
+
+    // Number of computed stats which could not be cached because they depend
+    // on critter's surroundings (tile, light, time of day).
+    unsigned int uncacheable;
+
+    // Number of times cached stats of a single object were dropped.
+    unsigned int invalidations;
+
+    // Number of times the entire cache was dropped.
+    unsigned int flushes;
+
+    // Number of cached stats which did not match recomputed value (only
+    // tracked when cache verification is enabled).
+    unsigned int mismatches;
+} StatCacheStats;
+
 extern const char* stat_lookup_keys_tbl[STAT_COUNT];
 
 bool stat_init(GameInitInfo* init_info);
+void stat_reset();
 void stat_exit();
 void stat_set_defaults(int64_t obj);
 int stat_level_get(int64_t obj, int stat);
@@ -77,5 +101,11 @@ int stat_level_min(int64_t obj, int stat);
 int stat_level_max(int64_t obj, int stat);
 bool stat_level_set(int64_t obj, int stat, int value);
 bool stat_poison_timeevent_process(TimeEvent* timeevent);
+void stat_cache_invalidate(int64_t obj);
+void stat_cache_field_changed(int64_t obj, int fld);
+void stat_cache_flush();
+void stat_cache_verify_enable();
+void stat_cache_stats(StatCacheStats* stats);
+void stat_cache_reset_stats();
 
 #endif /* ARCANUM_GAME_STAT_H_ */
@@ -6,6 +6,7 @@
 #include "game/a_name.h"
 #include "game/gamelib.h"
 #include "game/light.h"
+#include "game/path.h"
 #include "game/random.h"
 #include "game/roof.h"
 #include "game/sector.h"
@@ -395,6 +396,8 @@ void sub_4D7820(int64_t loc, tig_art_id_t art_id)
         sector->tiles.dif = 1;
         sector_unlock(sector_id);
 
+        path_cluster_invalidate(sector_id);
+
         location_xy(loc, &x, &y);
         if (x > INT_MIN && x < INT_MAX
             && y > INT_MIN && y < INT_MAX) {
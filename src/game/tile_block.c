@@ -1,6 +1,7 @@
 #include "game/tile_block.h"
 
 #include "game/a_name.h"
+#include "game/path.h"
 #include "game/sector.h"
 #include "game/tile.h"
 
@@ -349,6 +350,8 @@ void tileblock_set_tile_blocked(int64_t loc, bool blocked)
         }
         sector->blocks.modified = true;
         sector_unlock(sec);
+
+        path_cluster_invalidate(sec);
     }
 
     // Mark the tile block screen area as dirty.
@@ -44,10 +44,34 @@ typedef unsigned int TimeEventParamTypeFlags;
 typedef struct TimeEventNode {
     TimeEvent te;
     Ryan field_30[TIMEEVENT_PARAM_TYPE_COUNT];
+
+    // Next free node in the pool (see `timeevent_node_create`).
     struct TimeEventNode* next;
     int field_D4;
+
+    // Insertion order, see `timeevent_node_before`.
+    unsigned int seq;
+
+    // Set when the node is about to be removed from its queue by
+    // `timeevent_queue_purge`.
+    bool removed;
 } TimeEventNode;
 
+// Number of nodes allocated at once by `timeevent_node_create`.
+#define TIMEEVENT_NODE_SLAB_SIZE 256
+
+typedef struct TimeEventNodeSlab {
+    struct TimeEventNodeSlab* next;
+    TimeEventNode nodes[TIMEEVENT_NODE_SLAB_SIZE];
+} TimeEventNodeSlab;
+
+// 4-ary min-heap of timeevents ordered by `timeevent_node_before`.
+typedef struct TimeEventQueue {
+    TimeEventNode** nodes;
+    int size;
+    int capacity;
+} TimeEventQueue;
+
 typedef void(TimeEventExitFunc)(TimeEvent* timeevent);
 typedef bool(TimeEventShouldSaveFunc)(TimeEvent* timeevent);
 
@@ -80,6 +104,19 @@ static void timeevent_load_nodes_from_map(const char* name);
 static void timeevent_break_nodes_to_map(const char* name);
 static bool debug_timeevent_process(TimeEvent* timeevent);
 static void timeevent_debug_node(TimeEventNode* timeevent, int node);
+static void timeevent_node_pool_exit();
+static bool timeevent_node_before(TimeEventNode* a, TimeEventNode* b);
+static int timeevent_node_compare(const void* va, const void* vb);
+static void timeevent_queue_push(TimeEventQueue* queue, TimeEventNode* node);
+static TimeEventNode* timeevent_queue_top(TimeEventQueue* queue);
+static TimeEventNode* timeevent_queue_pop(TimeEventQueue* queue);
+static void timeevent_queue_sift_up(TimeEventQueue* queue, int index);
+static void timeevent_queue_sift_down(TimeEventQueue* queue, int index);
+static TimeEventNode** timeevent_queue_sorted(TimeEventQueue* queue, int type, int* count_ptr);
+static void timeevent_queue_purge(TimeEventQueue* queue);
+static void timeevent_queue_remove_typed(TimeEventQueue* queue, int list, TimeEventEnumerateFunc* callback, bool one);
+static bool timeevent_queue_any(TimeEventQueue* queue, int list, TimeEventEnumerateFunc* callback);
+static void timeevent_queue_exit(TimeEventQueue* queue);
 
 // 0x5B2178
 static const char* off_5B2178[TIME_TYPE_COUNT] = {
@@ -100,7 +137,7 @@ static TimeEventTypeInfo stru_5B2188[TIMEEVENT_TYPE_COUNT] = {
     /*             TIMEEVENT_TYPE_RESTING */ { "Resting", true, 10, TIME_TYPE_GAME_TIME, critter_resting_timeevent_process },
     /*             TIMEEVENT_TYPE_FATIGUE */ { "Fatigue", true, P2_INT | P1_OBJ | P0_INT, TIME_TYPE_GAME_TIME, critter_fatigue_timeevent_process },
     /*               TIMEEVENT_TYPE_AGING */ { "Aging", true, 0, TIME_TYPE_GAME_TIME, timeevent_do_nothing, NULL, NULL },
-    /*                  TIMEEVENT_TYPE_AI */ { "AI", false, P1_INT | P0_OBJ, TIME_TYPE_GAME_TIME, ai_timeevent_process },
+    /*                  TIMEEVENT_TYPE_AI */ { "AI", false, P2_INT | P1_INT | P0_OBJ, TIME_TYPE_GAME_TIME, ai_timeevent_process },
     /*              TIMEEVENT_TYPE_COMBAT */ { "Combat", true, 0, TIME_TYPE_GAME_TIME, timeevent_do_nothing, NULL, NULL },
     /*           TIMEEVENT_TYPE_TB_COMBAT */ { "TB Combat", true, 0, TIME_TYPE_REAL_TIME, combat_tb_timeevent_process },
     /*    TIMEEVENT_TYPE_AMBIENT_LIGHTING */ { "Ambient Lighting", true, 0, TIME_TYPE_GAME_TIME, timeevent_do_nothing, NULL, NULL },
@@ -162,10 +199,10 @@ static TimeEventParamTypeFlags dword_5B2794[TIMEEVENT_PARAM_COUNT][TIMEEVENT_PAR
 };
 
 // 0x5E7638
-static TimeEventNode* timeevent_lists[TIME_TYPE_COUNT];
+static TimeEventQueue timeevent_lists[TIME_TYPE_COUNT];
 
 // 0x5E7E14
-static TimeEventNode* timeevent_new_lists[TIME_TYPE_COUNT];
+static TimeEventQueue timeevent_new_lists[TIME_TYPE_COUNT];
 
 // 0x5E85F0
 static bool timeevent_editor;
@@ -198,6 +235,13 @@ static tig_timestamp_t dword_5E8624;
 // 0x5E8628
 static int dword_5E8628;
 
+// Sequence number of the next queued timeevent.
+static unsigned int timeevent_seq;
+
+// Slabs backing timeevent nodes, and the list of free nodes in them.
+static TimeEventNodeSlab* timeevent_node_slabs;
+static TimeEventNode* timeevent_node_free_head;
+
 // 0x5DE6E0
 static bool g_anim_disable_fidgets;
 
@@ -509,13 +553,13 @@ bool timeevent_init(GameInitInfo* init_info)
     timeevent_editor = init_info->editor;
 
     if (!timeevent_initialized) {
-        timeevent_lists[TIME_TYPE_REAL_TIME] = NULL;
-        timeevent_lists[TIME_TYPE_GAME_TIME] = NULL;
-        timeevent_lists[TIME_TYPE_ANIMATIONS] = NULL;
+        timeevent_lists[TIME_TYPE_REAL_TIME].size = 0;
+        timeevent_lists[TIME_TYPE_GAME_TIME].size = 0;
+        timeevent_lists[TIME_TYPE_ANIMATIONS].size = 0;
 
-        timeevent_new_lists[TIME_TYPE_REAL_TIME] = NULL;
-        timeevent_new_lists[TIME_TYPE_GAME_TIME] = NULL;
-        timeevent_new_lists[TIME_TYPE_ANIMATIONS] = NULL;
+        timeevent_new_lists[TIME_TYPE_REAL_TIME].size = 0;
+        timeevent_new_lists[TIME_TYPE_GAME_TIME].size = 0;
+        timeevent_new_lists[TIME_TYPE_ANIMATIONS].size = 0;
 
         DateTimeAddMilliseconds(&timeevent_real_time, 0);
         DateTimeAddMilliseconds(&timeevent_game_time, datetime_start_time_in_milliseconds);
@@ -562,8 +606,17 @@ void timeevent_reset()
 // 0x45AEC0
 void timeevent_exit()
 {
+    int index;
+
     timeevent_initialized = false;
     timeevent_clear();
+
+    for (index = 0; index < TIME_TYPE_COUNT; index++) {
+        timeevent_queue_exit(&(timeevent_lists[index]));
+        timeevent_queue_exit(&(timeevent_new_lists[index]));
+    }
+
+    timeevent_node_pool_exit();
 }
 
 // 0x45AED0
@@ -572,6 +625,9 @@ bool timeevent_save(TigFile* stream)
     int index;
     int count_pos;
     int count;
+    TimeEventNode** nodes;
+    int nodes_count;
+    int node_index;
     TimeEventNode* timeevent;
     int pos;
     TimeEventTypeInfo* info;
@@ -598,21 +654,28 @@ bool timeevent_save(TigFile* stream)
             return false;
         }
 
-        timeevent = timeevent_lists[index];
-        while (timeevent != NULL) {
+        // Nodes are written in queue order to keep the format identical to
+        // the original sorted list.
+        nodes = timeevent_queue_sorted(&(timeevent_lists[index]), -1, &nodes_count);
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            timeevent = nodes[node_index];
             info = &(stru_5B2188[timeevent->te.type]);
             // NOTE: Original code is slightly different. It uses bitwise AND
             // with 0x1 implying `saveable` is a bitfield.
             if (info->saveable) {
                 if (info->should_save_func == NULL || info->should_save_func(&(timeevent->te))) {
                     if (!timeevent_save_node(info, timeevent, stream)) {
+                        FREE(nodes);
                         return false;
                     }
 
                     count++;
                 }
             }
-            timeevent = timeevent->next;
+        }
+
+        if (nodes != NULL) {
+            FREE(nodes);
         }
 
         if (tig_file_fgetpos(stream, &pos) != 0) {
@@ -856,11 +919,11 @@ void timeevent_ping(tig_timestamp_t timestamp)
             assert(0);
         }
 
-        // TimeEventNode objects are sorted by their datetime, so we are only
-        // interested in head node.
-        while ((node = timeevent_lists[time_type]) != NULL
+        // TimeEventNode objects are ordered by their datetime, so we are only
+        // interested in top node.
+        while ((node = timeevent_queue_top(&(timeevent_lists[time_type]))) != NULL
             && datetime_compare(datetime, &(node->te.datetime)) >= 0) {
-            timeevent_lists[time_type] = node->next;
+            timeevent_queue_pop(&(timeevent_lists[time_type]));
 
             info = &(stru_5B2188[node->te.type]);
 
@@ -917,7 +980,8 @@ void timeevent_ping(tig_timestamp_t timestamp)
 // 0x45B600
 void timeevent_node_destroy(TimeEventNode* node)
 {
-    FREE(node);
+    node->next = timeevent_node_free_head;
+    timeevent_node_free_head = node;
 }
 
 // 0x45B610
@@ -972,14 +1036,10 @@ bool timeevent_recover_handles_internal(TimeEventNode* node, bool force)
 void sub_45B750()
 {
     int index;
-    TimeEventNode** node_ptr;
     TimeEventNode* node;
 
     for (index = 0; index < TIME_TYPE_COUNT; index++) {
-        node_ptr = &(timeevent_new_lists[index]);
-        while (*node_ptr != NULL) {
-            node = *node_ptr;
-            *node_ptr = node->next;
+        while ((node = timeevent_queue_pop(&(timeevent_new_lists[index]))) != NULL) {
             if (sub_45B7A0(node)) {
                 sub_45BB40(node);
             } else {
@@ -1050,7 +1110,7 @@ bool timeevent_add_delay_base(TimeEvent* timeevent, DateTime* delay, DateTime* b
 // 0x45B8C0
 bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime* at)
 {
-    TimeEventNode** node_ptr;
+    TimeEventQueue* queue;
     TimeEventNode* node;
     int time_type;
     int index;
@@ -1077,20 +1137,11 @@ bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime*
 
     time_type = stru_5B2188[timeevent->type].time_type;
     if (!timeevent_in_ping || dword_5E8620) {
-        node_ptr = &(timeevent_lists[time_type]);
+        queue = &(timeevent_lists[time_type]);
     } else {
-        node_ptr = &(timeevent_new_lists[time_type]);
-    }
-
-    while (*node_ptr != NULL) {
-        if (datetime_compare(&(timeevent->datetime), &((*node_ptr)->te.datetime)) <= 0) {
-            break;
-        }
-
-        node_ptr = &((*node_ptr)->next);
+        queue = &(timeevent_new_lists[time_type]);
     }
 
-    node->next = *node_ptr;
     node->te = *timeevent;
 
     for (index = 0; index < TIMEEVENT_PARAM_COUNT; index++) {
@@ -1101,7 +1152,7 @@ bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime*
         }
     }
 
-    *node_ptr = node;
+    timeevent_queue_push(queue, node);
 
     if (at != NULL) {
         *at = timeevent->datetime;
@@ -1113,7 +1164,26 @@ bool timeevent_add_base_at_func(TimeEvent* timeevent, DateTime* base, DateTime*
 // 0x45BA20
 TimeEventNode* timeevent_node_create()
 {
-    return (TimeEventNode*)MALLOC(sizeof(TimeEventNode));
+    TimeEventNodeSlab* slab;
+    TimeEventNode* node;
+    int index;
+
+    if (timeevent_node_free_head == NULL) {
+        slab = (TimeEventNodeSlab*)MALLOC(sizeof(*slab));
+        slab->next = timeevent_node_slabs;
+        timeevent_node_slabs = slab;
+
+        for (index = TIMEEVENT_NODE_SLAB_SIZE - 1; index >= 0; index--) {
+            slab->nodes[index].next = timeevent_node_free_head;
+            timeevent_node_free_head = &(slab->nodes[index]);
+        }
+    }
+
+    node = timeevent_node_free_head;
+    timeevent_node_free_head = node->next;
+    node->next = NULL;
+
+    return node;
 }
 
 // 0x45BA30
@@ -1177,7 +1247,7 @@ bool TimeEventAdd(TimeEvent* timeevent)
 // 0x45BB40
 bool sub_45BB40(TimeEventNode* node)
 {
-    TimeEventNode** node_ptr;
+    TimeEventQueue* queue;
     int time_type;
     int index;
 
@@ -1187,20 +1257,11 @@ bool sub_45BB40(TimeEventNode* node)
 
     time_type = stru_5B2188[node->te.type].time_type;
     if (timeevent_in_ping) {
-        node_ptr = &(timeevent_new_lists[time_type]);
+        queue = &(timeevent_new_lists[time_type]);
     } else {
-        node_ptr = &(timeevent_lists[time_type]);
-    }
-
-    while (*node_ptr != NULL) {
-        if (datetime_compare(&(node->te.datetime), &((*node_ptr)->te.datetime)) <= 0) {
-            break;
-        }
-        node_ptr = &((*node_ptr)->next);
+        queue = &(timeevent_lists[time_type]);
     }
 
-    node->next = *node_ptr;
-
     for (index = 0; index < TIMEEVENT_PARAM_COUNT; index++) {
         if ((dword_5B2794[index][TIMEEVENT_PARAM_TYPE_OBJECT] & stru_5B2188[node->te.type].flags) != 0) {
             object_save_ref_init(node->te.params[index].object_value, &(node->field_30[index]));
@@ -1209,7 +1270,7 @@ bool sub_45BB40(TimeEventNode* node)
         }
     }
 
-    *node_ptr = node;
+    timeevent_queue_push(queue, node);
 
     return true;
 }
@@ -1221,10 +1282,7 @@ void timeevent_clear()
     TimeEventNode* node;
 
     for (index = 0; index < TIME_TYPE_COUNT; index++) {
-        while (timeevent_lists[index] != NULL) {
-            node = timeevent_lists[index];
-            timeevent_lists[index] = node->next;
-
+        while ((node = timeevent_queue_pop(&(timeevent_lists[index]))) != NULL) {
             if (stru_5B2188[node->te.type].exit_func != NULL) {
                 stru_5B2188[node->te.type].exit_func(&(node->te));
             }
@@ -1232,10 +1290,7 @@ void timeevent_clear()
             timeevent_node_destroy(node);
         }
 
-        while (timeevent_new_lists[index] != NULL) {
-            node = timeevent_new_lists[index];
-            timeevent_new_lists[index] = node->next;
-
+        while ((node = timeevent_queue_pop(&(timeevent_new_lists[index]))) != NULL) {
             if (stru_5B2188[node->te.type].exit_func != NULL) {
                 stru_5B2188[node->te.type].exit_func(&(node->te));
             }
@@ -1274,44 +1329,12 @@ void timeevent_clear_for_map_close()
 // 0x45BD70
 bool timeevent_clear_all_typed(int list)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
+    timeevent_queue_remove_typed(&(timeevent_lists[stru_5B2188[list].time_type]), list, NULL, false);
+    timeevent_queue_remove_typed(&(timeevent_new_lists[stru_5B2188[list].time_type]), list, NULL, false);
 
     return true;
 }
@@ -1319,48 +1342,12 @@ bool timeevent_clear_all_typed(int list)
 // 0x45BE40
 bool timeevent_clear_one_typed(int list)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
+    timeevent_queue_remove_typed(&(timeevent_lists[stru_5B2188[list].time_type]), list, NULL, true);
+    timeevent_queue_remove_typed(&(timeevent_new_lists[stru_5B2188[list].time_type]), list, NULL, true);
 
     return true;
 }
@@ -1368,44 +1355,12 @@ bool timeevent_clear_one_typed(int list)
 // 0x45BF10
 bool timeevent_clear_all_ex(int list, TimeEventEnumerateFunc* callback)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-        } else {
-            node_ptr = &(node->next);
-        }
-    }
+    timeevent_queue_remove_typed(&(timeevent_lists[stru_5B2188[list].time_type]), list, callback, false);
+    timeevent_queue_remove_typed(&(timeevent_new_lists[stru_5B2188[list].time_type]), list, callback, false);
 
     return true;
 }
@@ -1413,48 +1368,12 @@ bool timeevent_clear_all_ex(int list, TimeEventEnumerateFunc* callback)
 // 0x45BFF0
 bool timeevent_clear_one_ex(int list, TimeEventEnumerateFunc* callback)
 {
-    TimeEventNode** node_ptr;
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node_ptr = &(timeevent_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
-
-    node_ptr = &(timeevent_new_lists[stru_5B2188[list].time_type]);
-    while (*node_ptr != NULL) {
-        node = *node_ptr;
-        if (node->te.type == list && callback(&(node->te))) {
-            *node_ptr = node->next;
-
-            if (stru_5B2188[list].exit_func != NULL) {
-                stru_5B2188[list].exit_func(&(node->te));
-            }
-
-            timeevent_node_destroy(node);
-
-            break;
-        }
-
-        node_ptr = &(node->next);
-    }
+    timeevent_queue_remove_typed(&(timeevent_lists[stru_5B2188[list].time_type]), list, callback, true);
+    timeevent_queue_remove_typed(&(timeevent_new_lists[stru_5B2188[list].time_type]), list, callback, true);
 
     return true;
 }
@@ -1462,28 +1381,26 @@ bool timeevent_clear_one_ex(int list, TimeEventEnumerateFunc* callback)
 // 0x45C0E0
 bool timeevent_is_queued(int list)
 {
-    TimeEventNode* node;
+    TimeEventQueue* queue;
+    int index;
 
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node = timeevent_new_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list) {
+    // Order does not matter here, scan queues as is.
+    queue = &(timeevent_new_lists[stru_5B2188[list].time_type]);
+    for (index = 0; index < queue->size; index++) {
+        if (queue->nodes[index]->te.type == list) {
             return true;
         }
-
-        node = node->next;
     }
 
-    node = timeevent_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list) {
+    queue = &(timeevent_lists[stru_5B2188[list].time_type]);
+    for (index = 0; index < queue->size; index++) {
+        if (queue->nodes[index]->te.type == list) {
             return true;
         }
-
-        node = node->next;
     }
 
     return false;
@@ -1492,28 +1409,16 @@ bool timeevent_is_queued(int list)
 // 0x45C140
 bool timeevent_any(int list, TimeEventEnumerateFunc* callback)
 {
-    TimeEventNode* node;
-
     if (list >= TIMEEVENT_TYPE_COUNT) {
         return false;
     }
 
-    node = timeevent_new_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list && callback(&(node->te))) {
-            return true;
-        }
-
-        node = node->next;
+    if (timeevent_queue_any(&(timeevent_new_lists[stru_5B2188[list].time_type]), list, callback)) {
+        return true;
     }
 
-    node = timeevent_lists[stru_5B2188[list].time_type];
-    while (node != NULL) {
-        if (node->te.type == list && callback(&(node->te))) {
-            return true;
-        }
-
-        node = node->next;
+    if (timeevent_queue_any(&(timeevent_lists[stru_5B2188[list].time_type]), list, callback)) {
+        return true;
     }
 
     return false;
@@ -1560,8 +1465,10 @@ void timeevent_save_nodes_to_map(const char* name)
     bool exists = false;
     int count;
     int time_type;
+    TimeEventNode** nodes;
+    int nodes_count;
+    int node_index;
     TimeEventNode* node;
-    TimeEventNode** node_ptr;
 
     sprintf(path, "Save\\Current\\maps\\%s\\TimeEvent.dat", name);
 
@@ -1605,14 +1512,16 @@ void timeevent_save_nodes_to_map(const char* name)
     }
 
     for (time_type = 0; time_type < TIME_TYPE_COUNT; time_type++) {
-        node_ptr = &(timeevent_lists[time_type]);
-        while (*node_ptr != NULL) {
-            node = *node_ptr;
+        nodes = timeevent_queue_sorted(&(timeevent_lists[time_type]), -1, &nodes_count);
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            node = nodes[node_index];
             if (sub_45C500(node) < 0) {
-                *node_ptr = node->next;
+                node->removed = true;
 
                 if (!timeevent_save_node(&(stru_5B2188[node->te.type]), node, stream)) {
                     tig_debug_printf("TimeEvent: timeevent_save_nodes_to_map: ERROR: Failed to save out nodes!\n");
+                    FREE(nodes);
+                    timeevent_queue_purge(&(timeevent_lists[time_type]));
                     tig_file_fclose(stream);
 
                     // FIXME: Other error-handling code does not remove this
@@ -1627,12 +1536,14 @@ void timeevent_save_nodes_to_map(const char* name)
                 if (stru_5B2188[node->te.type].exit_func != NULL) {
                     stru_5B2188[node->te.type].exit_func(&(node->te));
                 }
-
-                timeevent_node_destroy(node);
-            } else {
-                node_ptr = &(node->next);
             }
         }
+
+        if (nodes != NULL) {
+            FREE(nodes);
+        }
+
+        timeevent_queue_purge(&(timeevent_lists[time_type]));
     }
 
     if (tig_file_fseek(stream, 0, SEEK_SET) != 0) {
@@ -1680,20 +1591,16 @@ int sub_45C500(TimeEventNode* node)
 void sub_45C580()
 {
     int time_type;
-    TimeEventNode* node;
+    int index;
     char* name;
 
     for (time_type = 0; time_type < TIME_TYPE_COUNT; time_type++) {
-        node = timeevent_lists[time_type];
-        while (node != NULL) {
-            timeevent_recover_handles_internal(node, true);
-            node = node->next;
+        for (index = 0; index < timeevent_lists[time_type].size; index++) {
+            timeevent_recover_handles_internal(timeevent_lists[time_type].nodes[index], true);
         }
 
-        node = timeevent_new_lists[time_type];
-        while (node != NULL) {
-            timeevent_recover_handles_internal(node, true);
-            node = node->next;
+        for (index = 0; index < timeevent_new_lists[time_type].size; index++) {
+            timeevent_recover_handles_internal(timeevent_new_lists[time_type].nodes[index], true);
         }
     }
 
@@ -1782,8 +1689,10 @@ void timeevent_break_nodes_to_map(const char* name)
     bool exists = false;
     int count;
     int time_type;
+    TimeEventNode** nodes;
+    int nodes_count;
+    int node_index;
     TimeEventNode* node;
-    TimeEventNode** node_ptr;
 
     sprintf(path, "Save\\Current\\maps\\%s\\TimeEvent.dat", name);
 
@@ -1827,14 +1736,16 @@ void timeevent_break_nodes_to_map(const char* name)
     }
 
     for (time_type = 0; time_type < TIME_TYPE_COUNT; time_type++) {
-        node_ptr = &(timeevent_lists[time_type]);
-        while (*node_ptr != NULL) {
-            node = *node_ptr;
+        nodes = timeevent_queue_sorted(&(timeevent_lists[time_type]), -1, &nodes_count);
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            node = nodes[node_index];
             if (sub_45C500(node) > 0) {
-                *node_ptr = node->next;
+                node->removed = true;
 
                 if (!timeevent_save_node(&(stru_5B2188[node->te.type]), node, stream)) {
                     tig_debug_printf("TimeEvent: timeevent_break_nodes_to_map: ERROR: Failed to save out nodes!\n");
+                    FREE(nodes);
+                    timeevent_queue_purge(&(timeevent_lists[time_type]));
                     tig_file_fclose(stream);
 
                     // FIXME: Other error-handling code does not remove this
@@ -1849,12 +1760,14 @@ void timeevent_break_nodes_to_map(const char* name)
                 if (stru_5B2188[node->te.type].exit_func != NULL) {
                     stru_5B2188[node->te.type].exit_func(&(node->te));
                 }
-
-                timeevent_node_destroy(node);
-            } else {
-                node_ptr = &(node->next);
             }
         }
+
+        if (nodes != NULL) {
+            FREE(nodes);
+        }
+
+        timeevent_queue_purge(&(timeevent_lists[time_type]));
     }
 
     if (tig_file_fseek(stream, 0, SEEK_SET) != 0) {
@@ -1892,6 +1805,9 @@ bool debug_timeevent_process(TimeEvent* timeevent)
 // 0x45CA60
 void timeevent_debug_lists()
 {
+    TimeEventNode** nodes;
+    int nodes_count;
+    int node_index;
     TimeEventNode* node;
     int time_type_counts[TIME_TYPE_COUNT];
     int timeevent_type_counts[TIMEEVENT_TYPE_COUNT];
@@ -1926,20 +1842,28 @@ void timeevent_debug_lists()
         datetime_format_datetime(&time, time_str);
         tig_debug_printf("\t[%s] Game Time: [%s]\n", off_5B2178[index], time_str);
 
-        node = timeevent_new_lists[index];
-        while (node != NULL) {
+        nodes = timeevent_queue_sorted(&(timeevent_new_lists[index]), -1, &nodes_count);
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            node = nodes[node_index];
             time_type_counts[index]++;
             timeevent_type_counts[node->te.type]++;
             timeevent_debug_node(node, time_type_counts[index]);
-            node = node->next;
         }
 
-        node = timeevent_lists[index];
-        while (node != NULL) {
+        if (nodes != NULL) {
+            FREE(nodes);
+        }
+
+        nodes = timeevent_queue_sorted(&(timeevent_lists[index]), -1, &nodes_count);
+        for (node_index = 0; node_index < nodes_count; node_index++) {
+            node = nodes[node_index];
             time_type_counts[index]++;
             timeevent_type_counts[node->te.type]++;
             timeevent_debug_node(node, time_type_counts[index]);
-            node = node->next;
+        }
+
+        if (nodes != NULL) {
+            FREE(nodes);
         }
     }
 
@@ -2007,3 +1931,275 @@ void timeevent_debug_node(TimeEventNode* node, int node_index)
 
     tig_debug_printf("\n");
 }
+
+void timeevent_node_pool_exit()
+{
+    TimeEventNodeSlab* next;
+
+    while (timeevent_node_slabs != NULL) {
+        next = timeevent_node_slabs->next;
+        FREE(timeevent_node_slabs);
+        timeevent_node_slabs = next;
+    }
+
+    timeevent_node_free_head = NULL;
+}
+
+// Defines the order in which timeevents are processed: by datetime, and among
+// events with the same datetime the most recently queued one goes first. This
+// matches the original sorted list where new nodes were inserted in front of
+// nodes with equal datetime.
+bool timeevent_node_before(TimeEventNode* a, TimeEventNode* b)
+{
+    int cmp;
+
+    cmp = datetime_compare(&(a->te.datetime), &(b->te.datetime));
+    if (cmp != 0) {
+        return cmp < 0;
+    }
+
+    return (int)(a->seq - b->seq) > 0;
+}
+
+int timeevent_node_compare(const void* va, const void* vb)
+{
+    TimeEventNode* a = *(TimeEventNode**)va;
+    TimeEventNode* b = *(TimeEventNode**)vb;
+
+    if (timeevent_node_before(a, b)) {
+        return -1;
+    }
+
+    if (timeevent_node_before(b, a)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+void timeevent_queue_push(TimeEventQueue* queue, TimeEventNode* node)
+{
+    if (queue->size == queue->capacity) {
+        queue->capacity = queue->capacity != 0 ? queue->capacity * 2 : 64;
+        queue->nodes = (TimeEventNode**)REALLOC(queue->nodes, sizeof(*queue->nodes) * queue->capacity);
+    }
+
+    node->seq = timeevent_seq++;
+    node->removed = false;
+
+    queue->nodes[queue->size] = node;
+    timeevent_queue_sift_up(queue, queue->size);
+    queue->size++;
+}
+
+TimeEventNode* timeevent_queue_top(TimeEventQueue* queue)
+{
+    return queue->size != 0 ? queue->nodes[0] : NULL;
+}
+
+TimeEventNode* timeevent_queue_pop(TimeEventQueue* queue)
+{
+    TimeEventNode* node;
+
+    if (queue->size == 0) {
+        return NULL;
+    }
+
+    node = queue->nodes[0];
+
+    queue->size--;
+    if (queue->size != 0) {
+        queue->nodes[0] = queue->nodes[queue->size];
+        timeevent_queue_sift_down(queue, 0);
+    }
+
+    return node;
+}
+
+void timeevent_queue_sift_up(TimeEventQueue* queue, int index)
+{
+    TimeEventNode* node;
+    int parent;
+
+    node = queue->nodes[index];
+    while (index > 0) {
+        parent = (index - 1) / 4;
+        if (!timeevent_node_before(node, queue->nodes[parent])) {
+            break;
+        }
+
+        queue->nodes[index] = queue->nodes[parent];
+        index = parent;
+    }
+    queue->nodes[index] = node;
+}
+
+void timeevent_queue_sift_down(TimeEventQueue* queue, int index)
+{
+    TimeEventNode* node;
+    int child;
+    int last;
+    int best;
+
+    node = queue->nodes[index];
+    for (;;) {
+        child = index * 4 + 1;
+        if (child >= queue->size) {
+            break;
+        }
+
+        last = child + 4 < queue->size ? child + 4 : queue->size;
+
+        best = child;
+        for (child++; child < last; child++) {
+            if (timeevent_node_before(queue->nodes[child], queue->nodes[best])) {
+                best = child;
+            }
+        }
+
+        if (!timeevent_node_before(queue->nodes[best], node)) {
+            break;
+        }
+
+        queue->nodes[index] = queue->nodes[best];
+        index = best;
+    }
+    queue->nodes[index] = node;
+}
+
+// Returns queued nodes of the given timeevent type (or all nodes if `type` is
+// -1) in processing order, i.e. in the order of the original sorted list. The
+// returned array is a snapshot which should be released with `FREE` (it's
+// `NULL` when there are no such nodes).
+TimeEventNode** timeevent_queue_sorted(TimeEventQueue* queue, int type, int* count_ptr)
+{
+    TimeEventNode** nodes;
+    int count;
+    int index;
+
+    *count_ptr = 0;
+
+    if (queue->size == 0) {
+        return NULL;
+    }
+
+    nodes = (TimeEventNode**)MALLOC(sizeof(*nodes) * queue->size);
+
+    count = 0;
+    for (index = 0; index < queue->size; index++) {
+        if (type == -1 || queue->nodes[index]->te.type == type) {
+            nodes[count++] = queue->nodes[index];
+        }
+    }
+
+    if (count == 0) {
+        FREE(nodes);
+        return NULL;
+    }
+
+    qsort(nodes, count, sizeof(*nodes), timeevent_node_compare);
+
+    *count_ptr = count;
+
+    return nodes;
+}
+
+// Destroys nodes marked as `removed` and restores heap property for the
+// remaining ones.
+void timeevent_queue_purge(TimeEventQueue* queue)
+{
+    int index;
+    int count;
+
+    count = 0;
+    for (index = 0; index < queue->size; index++) {
+        if (queue->nodes[index]->removed) {
+            timeevent_node_destroy(queue->nodes[index]);
+        } else {
+            queue->nodes[count++] = queue->nodes[index];
+        }
+    }
+
+    if (count == queue->size) {
+        return;
+    }
+
+    queue->size = count;
+
+    if (count > 1) {
+        for (index = (count - 2) / 4; index >= 0; index--) {
+            timeevent_queue_sift_down(queue, index);
+        }
+    }
+}
+
+// Removes timeevents of the given type (which also satisfy `callback`, if any)
+// visiting them in processing order, so that callbacks observe the same order
+// as with the original sorted list. If `one` is set, stops after the first
+// removed timeevent.
+void timeevent_queue_remove_typed(TimeEventQueue* queue, int list, TimeEventEnumerateFunc* callback, bool one)
+{
+    TimeEventNode** nodes;
+    int count;
+    int index;
+    TimeEventNode* node;
+    bool removed = false;
+
+    nodes = timeevent_queue_sorted(queue, list, &count);
+    for (index = 0; index < count; index++) {
+        node = nodes[index];
+        if (callback == NULL || callback(&(node->te))) {
+            node->removed = true;
+            removed = true;
+
+            if (stru_5B2188[list].exit_func != NULL) {
+                stru_5B2188[list].exit_func(&(node->te));
+            }
+
+            if (one) {
+                break;
+            }
+        }
+    }
+
+    if (nodes != NULL) {
+        FREE(nodes);
+    }
+
+    if (removed) {
+        timeevent_queue_purge(queue);
+    }
+}
+
+bool timeevent_queue_any(TimeEventQueue* queue, int list, TimeEventEnumerateFunc* callback)
+{
+    TimeEventNode** nodes;
+    int count;
+    int index;
+    bool found = false;
+
+    nodes = timeevent_queue_sorted(queue, list, &count);
+    for (index = 0; index < count; index++) {
+        if (callback(&(nodes[index]->te))) {
+            found = true;
+            break;
+        }
+    }
+
+    if (nodes != NULL) {
+        FREE(nodes);
+    }
+
+    return found;
+}
+
+void timeevent_queue_exit(TimeEventQueue* queue)
+{
+    if (queue->nodes != NULL) {
+        FREE(queue->nodes);
+        queue->nodes = NULL;
+    }
+
+    queue->size = 0;
+    queue->capacity = 0;
+}
@@ -67,6 +67,7 @@ int main(int argc, char** argv)
     tig_art_id_t cursor_art_id;
     int64_t pc_starting_location;
     char msg[80];
+    bool benchmark_only = false;
 
 #if SDL_PLATFORM_MACOS
     chdir(SDL_GetBasePath());
@@ -114,6 +115,14 @@ int main(int argc, char** argv)
         anim_debug_enable();
     }
 
+    if (strstr(lpCmdLine, "-statdebug") != NULL) {
+        stat_cache_verify_enable();
+    }
+
+    if (strstr(lpCmdLine, "-losdebug") != NULL) {
+        ai_los_cache_verify_enable();
+    }
+
     if (strstr(lpCmdLine, "-norandom") != NULL) {
         wmap_rnd_disable();
     }
@@ -294,7 +303,25 @@ int main(int argc, char** argv)
         (int)LOCATION_GET_Y(pc_starting_location));
     tig_debug_printf("%s\n", msg);
 
-    main_loop();
+    if (strstr(lpCmdLine, "-pathbench") != NULL) {
+        path_benchmark();
+    }
+
+    if (strstr(lpCmdLine, "-scriptbench") != NULL) {
+        script_benchmark();
+
+        // Heartbeats spawn objects, play sounds and schedule events which are
+        // not rolled back, so the session is not a clean game anymore.
+        benchmark_only = true;
+    }
+
+    if (strstr(lpCmdLine, "-aibench") != NULL) {
+        ai_benchmark();
+    }
+
+    if (!benchmark_only) {
+        main_loop();
+    }
 
     gameuilib_mod_unload();
     gamelib_mod_unload();
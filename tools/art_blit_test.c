@@ -0,0 +1,342 @@
+// Blits synthetic art with `tig_art_blit` into an offscreen 32 bpp video
+// buffer for every blend mode which has a span kernel, both as is and
+// mirrored, at several offsets (partially clipped ones included), and checks:
+// - the output with span kernels matches the output of the per-pixel loops
+//   (span kernels disabled with `tig_art_blit_set_span_enabled`);
+// - the per-pixel loops output matches the golden checksums below, so that
+//   the loops themselves do not drift.
+//
+// Usage: art_blit_test [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define DATA_DIR "art_blit_test_data"
+#define ART_FILE_NAME "blit.art"
+
+// Odd sizes exercise the scalar tails of the kernels.
+#define ART_WIDTH 61
+#define ART_HEIGHT 47
+
+// Destination image is a bit wider than the art, so that the art can be
+// blitted at every alignment, and clipped on every side.
+#define IMAGE_WIDTH 64
+#define IMAGE_HEIGHT ART_HEIGHT
+#define MIN_OFFSET -2
+#define MAX_OFFSET 6
+
+typedef struct BlitCase {
+    const char* name;
+    unsigned int flags;
+    int alpha;
+
+    // Checksums of the per-pixel loops output, blitted as is and mirrored.
+    unsigned int golden[2];
+} BlitCase;
+
+static BlitCase cases[] = {
+    { "copy", 0, 255, { 0xA84E1D64, 0x59B43ED4 } },
+    { "add", TIG_ART_BLT_BLEND_ADD, 255, { 0x94523881, 0x620A1CF9 } },
+    { "sub", TIG_ART_BLT_BLEND_SUB, 255, { 0x0F18A50D, 0x6E979E89 } },
+    { "alpha const 0", TIG_ART_BLT_BLEND_ALPHA_CONST, 0, { 0xD459B557, 0xD459B557 } },
+    { "alpha const 77", TIG_ART_BLT_BLEND_ALPHA_CONST, 77, { 0xD50F96A6, 0x8E0BE37F } },
+    { "alpha const 128", TIG_ART_BLT_BLEND_ALPHA_CONST, 128, { 0xAE8B05DE, 0xCEAB2F6A } },
+    { "alpha const 255", TIG_ART_BLT_BLEND_ALPHA_CONST, 255, { 0xD4FC2032, 0xA17AFD96 } },
+    { "stipple src", TIG_ART_BLT_BLEND_ALPHA_STIPPLE_S, 255, { 0xAAB114CE, 0xD8320858 } },
+    { "stipple dst", TIG_ART_BLT_BLEND_ALPHA_STIPPLE_D, 255, { 0xB2FC0927, 0x0E4B88DD } },
+};
+
+#define NUM_CASES (int)(sizeof(cases) / sizeof(cases[0]))
+
+static tig_art_id_t art_id;
+static TigVideoBuffer* video_buffer;
+static uint32_t background[IMAGE_HEIGHT][IMAGE_WIDTH];
+static uint32_t reference_image[IMAGE_HEIGHT][IMAGE_WIDTH];
+static uint32_t span_image[IMAGE_HEIGHT][IMAGE_WIDTH];
+
+static int art_resolve_path(tig_art_id_t art_id, char* path);
+static bool art_create(unsigned int* seed_ptr);
+static bool image_copy(uint32_t image[IMAGE_HEIGHT][IMAGE_WIDTH], bool to_video_buffer);
+static bool blit(BlitCase* blit_case, bool mirrored, int offset, uint32_t image[IMAGE_HEIGHT][IMAGE_WIDTH]);
+static unsigned int image_checksum(uint32_t image[IMAGE_HEIGHT][IMAGE_WIDTH], unsigned int hash);
+
+int main(int argc, char** argv)
+{
+    int iterations = 2000;
+    unsigned int seed = 0x505EC0;
+    TigVideoBufferCreateInfo vb_create_info;
+    char path[TIG_MAX_PATH];
+    BlitCase* blit_case;
+    unsigned int checksum;
+    bool matches;
+    double start;
+    double reference_ms;
+    double span_ms;
+    int mirrored;
+    int offset;
+    int iteration;
+    int x;
+    int y;
+    int idx;
+    int rc = EXIT_SUCCESS;
+
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    bench_art_init(art_resolve_path);
+
+    snprintf(path, sizeof(path), "%s/%s", DATA_DIR, ART_FILE_NAME);
+
+    if (!art_create(&seed) || !tig_file_repository_add(DATA_DIR)) {
+        printf("Cannot write %s\n", path);
+        remove(path);
+        SDL_RemovePath(DATA_DIR);
+        bench_art_exit();
+        return EXIT_FAILURE;
+    }
+
+    vb_create_info.flags = TIG_VIDEO_BUFFER_CREATE_SYSTEM_MEMORY;
+    vb_create_info.width = IMAGE_WIDTH;
+    vb_create_info.height = IMAGE_HEIGHT;
+    vb_create_info.background_color = 0;
+    vb_create_info.color_key = 0;
+    if (tig_video_buffer_create(&vb_create_info, &video_buffer) != TIG_OK) {
+        printf("Cannot create video buffer\n");
+        tig_video_buffer_destroy(video_buffer);
+        video_buffer = NULL;
+        rc = EXIT_FAILURE;
+    }
+
+    for (y = 0; y < IMAGE_HEIGHT; y++) {
+        for (x = 0; x < IMAGE_WIDTH; x++) {
+            background[y][x] = tig_color_make(bench_rand(&seed) % 256, bench_rand(&seed) % 256, bench_rand(&seed) % 256);
+        }
+    }
+
+    for (idx = 0; idx < NUM_CASES && video_buffer != NULL; idx++) {
+        blit_case = &(cases[idx]);
+
+        for (mirrored = 0; mirrored < 2; mirrored++) {
+            checksum = 2166136261u;
+            matches = true;
+
+            for (offset = MIN_OFFSET; offset <= MAX_OFFSET; offset++) {
+                tig_art_blit_set_span_enabled(false);
+                if (!blit(blit_case, mirrored != 0, offset, reference_image)) {
+                    printf("%s: blit failed\n", blit_case->name);
+                    rc = EXIT_FAILURE;
+                    break;
+                }
+                checksum = image_checksum(reference_image, checksum);
+
+                tig_art_blit_set_span_enabled(true);
+                if (!blit(blit_case, mirrored != 0, offset, span_image)) {
+                    printf("%s: blit failed\n", blit_case->name);
+                    rc = EXIT_FAILURE;
+                    break;
+                }
+
+                if (memcmp(reference_image, span_image, sizeof(reference_image)) != 0) {
+                    matches = false;
+                }
+            }
+
+            if (checksum != blit_case->golden[mirrored]) {
+                printf("%s%s: checksum %08X, expected %08X\n",
+                    blit_case->name,
+                    mirrored ? " (mirrored)" : "",
+                    checksum,
+                    blit_case->golden[mirrored]);
+                rc = EXIT_FAILURE;
+            }
+
+            if (!matches) {
+                printf("%s%s: span kernel does not match per-pixel loops\n",
+                    blit_case->name,
+                    mirrored ? " (mirrored)" : "");
+                rc = EXIT_FAILURE;
+            }
+        }
+
+        if (!tig_art_blit_has_span(blit_case->flags)) {
+            printf("%s: no span kernel, checked per-pixel loops only\n", blit_case->name);
+            continue;
+        }
+
+        tig_art_blit_set_span_enabled(false);
+        start = bench_now();
+        for (iteration = 0; iteration < iterations; iteration++) {
+            blit(blit_case, false, iteration % (MAX_OFFSET + 1), NULL);
+        }
+        reference_ms = bench_now() - start;
+
+        tig_art_blit_set_span_enabled(true);
+        start = bench_now();
+        for (iteration = 0; iteration < iterations; iteration++) {
+            blit(blit_case, false, iteration % (MAX_OFFSET + 1), NULL);
+        }
+        span_ms = bench_now() - start;
+
+        printf("%s: per-pixel %.2f ms, span %.2f ms (%.2fx)\n",
+            blit_case->name,
+            reference_ms,
+            span_ms,
+            span_ms > 0 ? reference_ms / span_ms : 0.0);
+    }
+
+    tig_art_blit_set_span_enabled(true);
+
+    if (video_buffer != NULL) {
+        tig_video_buffer_destroy(video_buffer);
+    }
+
+    bench_art_exit();
+
+    tig_file_repository_remove(DATA_DIR);
+    remove(path);
+    SDL_RemovePath(DATA_DIR);
+
+    return rc;
+}
+
+int art_resolve_path(tig_art_id_t art_id, char* path)
+{
+    (void)art_id;
+
+    strcpy(path, ART_FILE_NAME);
+
+    return TIG_OK;
+}
+
+// Writes art file with a single frame and creates interface art id for it
+// (interface art without video buffer flag is always blitted in software).
+// About a third of the art is transparent, which is typical for critters.
+bool art_create(unsigned int* seed_ptr)
+{
+    BenchArtFrame frame;
+    uint32_t palette[256];
+    char path[TIG_MAX_PATH];
+    bool success;
+    int idx;
+
+    for (idx = 0; idx < 256; idx++) {
+        palette[idx] = ((bench_rand(seed_ptr) % 256) << 16)
+            | ((bench_rand(seed_ptr) % 256) << 8)
+            | (bench_rand(seed_ptr) % 256);
+    }
+
+    frame.width = ART_WIDTH;
+    frame.height = ART_HEIGHT;
+    frame.pixels = (uint8_t*)MALLOC(ART_WIDTH * ART_HEIGHT);
+
+    for (idx = 0; idx < ART_WIDTH * ART_HEIGHT; idx++) {
+        frame.pixels[idx] = bench_rand(seed_ptr) % 3 == 0 ? 0 : (uint8_t)(1 + bench_rand(seed_ptr) % 255);
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", DATA_DIR, ART_FILE_NAME);
+    success = SDL_CreateDirectory(DATA_DIR)
+        && bench_art_write(path, &frame, 1, palette);
+
+    FREE(frame.pixels);
+
+    tig_art_interface_id_create(0, 0, 0, 0, &art_id);
+
+    return success;
+}
+
+// Copies image into the video buffer or back.
+bool image_copy(uint32_t image[IMAGE_HEIGHT][IMAGE_WIDTH], bool to_video_buffer)
+{
+    TigVideoBufferData video_buffer_data;
+    uint8_t* pixels;
+    int y;
+
+    if (tig_video_buffer_lock(video_buffer) != TIG_OK) {
+        return false;
+    }
+
+    tig_video_buffer_data(video_buffer, &video_buffer_data);
+
+    pixels = (uint8_t*)video_buffer_data.surface_data.pixels;
+    for (y = 0; y < IMAGE_HEIGHT; y++) {
+        if (to_video_buffer) {
+            memcpy(pixels, image[y], sizeof(image[y]));
+        } else {
+            memcpy(image[y], pixels, sizeof(image[y]));
+        }
+        pixels += video_buffer_data.pitch;
+    }
+
+    tig_video_buffer_unlock(video_buffer);
+
+    return true;
+}
+
+// Blits the art over the background at `offset` and reads the result back
+// into `image` (unless it's `NULL`).
+bool blit(BlitCase* blit_case, bool mirrored, int offset, uint32_t image[IMAGE_HEIGHT][IMAGE_WIDTH])
+{
+    TigArtBlitInfo art_blit_info;
+    TigRect src_rect;
+    TigRect dst_rect;
+
+    if (!image_copy(background, true)) {
+        return false;
+    }
+
+    src_rect.x = 0;
+    src_rect.y = 0;
+    src_rect.width = ART_WIDTH;
+    src_rect.height = ART_HEIGHT;
+
+    // Vertical offset varies along, which clips the art at the top or the
+    // bottom.
+    dst_rect.x = offset;
+    dst_rect.y = offset % 3 - 1;
+    dst_rect.width = ART_WIDTH;
+    dst_rect.height = ART_HEIGHT;
+
+    memset(&art_blit_info, 0, sizeof(art_blit_info));
+    art_blit_info.flags = blit_case->flags;
+    if (mirrored) {
+        art_blit_info.flags |= TIG_ART_BLT_FLIP_X;
+    }
+    art_blit_info.art_id = art_id;
+    art_blit_info.src_rect = &src_rect;
+    art_blit_info.alpha[0] = (uint8_t)blit_case->alpha;
+    art_blit_info.dst_video_buffer = video_buffer;
+    art_blit_info.dst_rect = &dst_rect;
+
+    if (tig_art_blit(&art_blit_info) != TIG_OK) {
+        return false;
+    }
+
+    return image == NULL || image_copy(image, false);
+}
+
+// FNV-1a over pixel bytes (least significant first, so that checksums do not
+// depend on endianness).
+unsigned int image_checksum(uint32_t image[IMAGE_HEIGHT][IMAGE_WIDTH], unsigned int hash)
+{
+    int x;
+    int y;
+    int shift;
+
+    for (y = 0; y < IMAGE_HEIGHT; y++) {
+        for (x = 0; x < IMAGE_WIDTH; x++) {
+            for (shift = 0; shift < 32; shift += 8) {
+                hash = (hash ^ ((image[y][x] >> shift) & 0xFF)) * 16777619u;
+            }
+        }
+    }
+
+    return hash;
+}
@@ -0,0 +1,295 @@
+// Checks `tig_art_rle_decode` against the byte loop it replaced:
+// - every frame of a synthetic art set decodes to the original pixels when
+//   frames are expanded back to back into one buffer, as in `art.c`;
+// - random (mostly malformed) streams are accepted or rejected the same way
+//   and decode to the same pixels;
+// - reports throughput of both decoders in MB/s.
+//
+// Usage: art_rle_test [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define NUM_ROTATIONS 8
+#define NUM_FRAMES 16
+#define NUM_RANDOM_STREAMS 20000
+
+typedef struct BenchFrame {
+    int width;
+    int height;
+    uint8_t* pixels;
+    uint8_t* data;
+    size_t data_size;
+} BenchFrame;
+
+typedef bool(DecodeFunc)(const uint8_t* src, size_t src_size, uint8_t** dst_ptr, uint8_t* dst_end);
+
+static void frame_create(BenchFrame* frame, unsigned int* seed_ptr);
+static size_t rle_encode(const uint8_t* pixels, int cnt, uint8_t* data);
+static bool rle_decode_reference(const uint8_t* src, size_t src_size, uint8_t** dst_ptr, uint8_t* dst_end);
+static bool decode_frames(BenchFrame* frames, int num_frames, uint8_t* buffer, size_t buffer_size, DecodeFunc* func);
+static bool check_random_streams(unsigned int* seed_ptr);
+
+int main(int argc, char** argv)
+{
+    int iterations = 200;
+    unsigned int seed = 0x502830;
+    BenchFrame frames[NUM_ROTATIONS * NUM_FRAMES];
+    int num_frames = NUM_ROTATIONS * NUM_FRAMES;
+    size_t total_pixels = 0;
+    uint8_t* buffer;
+    uint8_t* pixels;
+    double start;
+    double reference_ms;
+    double decode_ms;
+    int iteration;
+    int idx;
+    int rc = EXIT_SUCCESS;
+
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (idx = 0; idx < num_frames; idx++) {
+        frame_create(&(frames[idx]), &seed);
+        total_pixels += (size_t)frames[idx].width * frames[idx].height;
+    }
+
+    // The buffer is sized exactly, so that any write past the last frame is
+    // caught by memory checkers.
+    buffer = (uint8_t*)MALLOC(total_pixels);
+
+    if (!decode_frames(frames, num_frames, buffer, total_pixels, tig_art_rle_decode)) {
+        printf("Failed to decode synthetic art set\n");
+        rc = EXIT_FAILURE;
+    } else {
+        pixels = buffer;
+        for (idx = 0; idx < num_frames; idx++) {
+            if (memcmp(pixels, frames[idx].pixels, (size_t)frames[idx].width * frames[idx].height) != 0) {
+                printf("Frame %d of rotation %d does not match\n",
+                    idx % NUM_FRAMES,
+                    idx / NUM_FRAMES);
+                rc = EXIT_FAILURE;
+            }
+            pixels += (size_t)frames[idx].width * frames[idx].height;
+        }
+    }
+
+    if (!check_random_streams(&seed)) {
+        rc = EXIT_FAILURE;
+    }
+
+    if (rc == EXIT_SUCCESS) {
+        start = bench_now();
+        for (iteration = 0; iteration < iterations; iteration++) {
+            decode_frames(frames, num_frames, buffer, total_pixels, rle_decode_reference);
+        }
+        reference_ms = bench_now() - start;
+
+        start = bench_now();
+        for (iteration = 0; iteration < iterations; iteration++) {
+            decode_frames(frames, num_frames, buffer, total_pixels, tig_art_rle_decode);
+        }
+        decode_ms = bench_now() - start;
+
+        printf("%d frames, %zu pixels: reference %.0f MB/s, decoder %.0f MB/s\n",
+            num_frames,
+            total_pixels,
+            reference_ms > 0 ? (double)total_pixels * iterations / 1000.0 / reference_ms : 0.0,
+            decode_ms > 0 ? (double)total_pixels * iterations / 1000.0 / decode_ms : 0.0);
+    }
+
+    for (idx = 0; idx < num_frames; idx++) {
+        FREE(frames[idx].pixels);
+        FREE(frames[idx].data);
+    }
+    FREE(buffer);
+
+    return rc;
+}
+
+// Creates frame resembling critter art: transparent margins around a body of
+// flat color spans and noisy (shaded) spans.
+void frame_create(BenchFrame* frame, unsigned int* seed_ptr)
+{
+    int cnt;
+    int pos;
+    int len;
+    int kind;
+    uint8_t color;
+
+    frame->width = 1 + bench_rand(seed_ptr) % 160;
+    frame->height = 1 + bench_rand(seed_ptr) % 160;
+    cnt = frame->width * frame->height;
+
+    frame->pixels = (uint8_t*)MALLOC(cnt);
+
+    pos = 0;
+    while (pos < cnt) {
+        len = 1 + bench_rand(seed_ptr) % 300;
+        if (len > cnt - pos) {
+            len = cnt - pos;
+        }
+
+        kind = bench_rand(seed_ptr) % 3;
+        color = (uint8_t)(kind == 0 ? 0 : bench_rand(seed_ptr));
+        while (len > 0) {
+            frame->pixels[pos++] = kind == 2 ? (uint8_t)bench_rand(seed_ptr) : color;
+            len--;
+        }
+    }
+
+    // Worst case is a literal run for every 127 pixels.
+    frame->data = (uint8_t*)MALLOC(cnt + cnt / 127 + 1);
+    frame->data_size = rle_encode(frame->pixels, cnt, frame->data);
+}
+
+size_t rle_encode(const uint8_t* pixels, int cnt, uint8_t* data)
+{
+    size_t size = 0;
+    int pos = 0;
+    int len;
+    int literal;
+
+    while (pos < cnt) {
+        len = 1;
+        while (pos + len < cnt && len < 127 && pixels[pos + len] == pixels[pos]) {
+            len++;
+        }
+
+        if (len >= 3) {
+            data[size++] = (uint8_t)len;
+            data[size++] = pixels[pos];
+            pos += len;
+        } else {
+            // Extend literal run until the next repeat of at least 3 pixels.
+            literal = 0;
+            while (pos + literal < cnt && literal < 127) {
+                if (pos + literal + 2 < cnt
+                    && pixels[pos + literal] == pixels[pos + literal + 1]
+                    && pixels[pos + literal] == pixels[pos + literal + 2]) {
+                    break;
+                }
+                literal++;
+            }
+
+            data[size++] = (uint8_t)(0x80 | literal);
+            memcpy(&(data[size]), &(pixels[pos]), literal);
+            size += literal;
+            pos += literal;
+        }
+    }
+
+    return size;
+}
+
+// Byte loop previously used by `tig_art_file_decode`.
+bool rle_decode_reference(const uint8_t* src, size_t src_size, uint8_t** dst_ptr, uint8_t* dst_end)
+{
+    const uint8_t* src_end = src + src_size;
+    uint8_t* dst = *dst_ptr;
+    uint8_t value;
+    int len;
+
+    while (src < src_end) {
+        value = *src++;
+        len = value & 0x7F;
+
+        if (dst_end - dst < len) {
+            return false;
+        }
+
+        if ((value & 0x80) != 0) {
+            if (src_end - src < len) {
+                return false;
+            }
+
+            memcpy(dst, src, len);
+            src += len;
+        } else {
+            if (src == src_end) {
+                return false;
+            }
+
+            memset(dst, *src++, len);
+        }
+        dst += len;
+    }
+
+    *dst_ptr = dst;
+
+    return true;
+}
+
+bool decode_frames(BenchFrame* frames, int num_frames, uint8_t* buffer, size_t buffer_size, DecodeFunc* func)
+{
+    uint8_t* bytes = buffer;
+    uint8_t* end = buffer + buffer_size;
+    int idx;
+
+    for (idx = 0; idx < num_frames; idx++) {
+        if (!func(frames[idx].data, frames[idx].data_size, &bytes, end)) {
+            return false;
+        }
+    }
+
+    return bytes == end;
+}
+
+// Feeds both decoders with random streams into buffers of random size, both
+// have to either fail or produce the same pixels.
+bool check_random_streams(unsigned int* seed_ptr)
+{
+    uint8_t src[512];
+    uint8_t* expected;
+    uint8_t* actual;
+    uint8_t* expected_end;
+    uint8_t* actual_end;
+    size_t src_size;
+    size_t dst_size;
+    bool expected_ok;
+    bool actual_ok;
+    int stream;
+    size_t idx;
+    int failed = 0;
+
+    for (stream = 0; stream < NUM_RANDOM_STREAMS; stream++) {
+        src_size = bench_rand(seed_ptr) % sizeof(src);
+        for (idx = 0; idx < src_size; idx++) {
+            src[idx] = (uint8_t)bench_rand(seed_ptr);
+        }
+
+        dst_size = bench_rand(seed_ptr) % 4096;
+        expected = (uint8_t*)MALLOC(dst_size + 1);
+        actual = (uint8_t*)MALLOC(dst_size + 1);
+
+        expected_end = expected;
+        actual_end = actual;
+        expected_ok = rle_decode_reference(src, src_size, &expected_end, expected + dst_size);
+        actual_ok = tig_art_rle_decode(src, src_size, &actual_end, actual + dst_size);
+
+        if (expected_ok != actual_ok
+            || (expected_ok
+                && (expected_end - expected != actual_end - actual
+                    || memcmp(expected, actual, expected_end - expected) != 0))) {
+            failed++;
+        }
+
+        FREE(expected);
+        FREE(actual);
+    }
+
+    if (failed != 0) {
+        printf("%d of %d random streams do not match\n", failed, NUM_RANDOM_STREAMS);
+        return false;
+    }
+
+    return true;
+}
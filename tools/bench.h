@@ -0,0 +1,116 @@
+#ifndef ARCANUM_TOOLS_BENCH_H_
+#define ARCANUM_TOOLS_BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <tig/tig.h>
+
+// Returns current time in milliseconds, for measuring intervals only.
+static inline double bench_now()
+{
+    return (double)SDL_GetPerformanceCounter() * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// Returns next pseudo-random number, benchmarks use fixed seeds so that runs
+// are comparable.
+static inline unsigned int bench_rand(unsigned int* seed_ptr)
+{
+    *seed_ptr = *seed_ptr * 1103515245 + 12345;
+    return *seed_ptr >> 16;
+}
+
+// Sets up 8-8-8 colors without initializing video.
+static inline void bench_color_init()
+{
+    TigInitInfo init_info = { 0 };
+
+    init_info.bpp = 32;
+    tig_color_init(&init_info);
+    tig_color_set_rgb_settings(0xFF0000, 0xFF00, 0xFF);
+}
+
+// Frame of synthetic art, see `bench_art_write`.
+typedef struct BenchArtFrame {
+    int width;
+    int height;
+    uint8_t* pixels;
+} BenchArtFrame;
+
+// Sets up 8-8-8 colors, palettes and art cache without initializing video. Art
+// paths are resolved with `resolver` and opened thru file repositories.
+static inline void bench_art_init(TigArtFilePathResolver* resolver)
+{
+    TigInitInfo init_info = { 0 };
+
+    bench_color_init();
+
+    init_info.bpp = 32;
+    init_info.art_file_path_resolver = resolver;
+    tig_palette_init(&init_info);
+    tig_art_init(&init_info);
+}
+
+static inline void bench_art_exit()
+{
+    tig_art_exit();
+    tig_palette_exit();
+    tig_color_exit();
+}
+
+// Writes 8 bpp art file with a single rotation and a single palette of 256
+// 24 bpp colors (the first one is the color key). Frames are stored
+// uncompressed.
+static inline bool bench_art_write(const char* path, const BenchArtFrame* frames, int num_frames, const uint32_t* palette)
+{
+    // Flags, fps, bpp, palettes, action frame, number of frames, then frames,
+    // data sizes and pixels tables (8 rotations each).
+    int32_t hdr[33] = { 0 };
+    int32_t frame_data[7] = { 0 };
+    FILE* stream;
+    int frame;
+    bool success = true;
+
+    stream = fopen(path, "wb");
+    if (stream == NULL) {
+        return false;
+    }
+
+    hdr[0] = TIG_ART_0x01;
+    hdr[1] = 10;
+    hdr[2] = 8;
+    hdr[3] = 1;
+    hdr[8] = num_frames;
+
+    for (frame = 0; frame < num_frames; frame++) {
+        hdr[17] += frames[frame].width * frames[frame].height;
+    }
+
+    if (fwrite(hdr, sizeof(hdr), 1, stream) != 1
+        || fwrite(palette, sizeof(*palette) * 256, 1, stream) != 1) {
+        success = false;
+    }
+
+    for (frame = 0; frame < num_frames && success; frame++) {
+        frame_data[0] = frames[frame].width;
+        frame_data[1] = frames[frame].height;
+        frame_data[2] = frames[frame].width * frames[frame].height;
+        if (fwrite(frame_data, sizeof(frame_data), 1, stream) != 1) {
+            success = false;
+        }
+    }
+
+    for (frame = 0; frame < num_frames && success; frame++) {
+        if (fwrite(frames[frame].pixels, (size_t)frames[frame].width * frames[frame].height, 1, stream) != 1) {
+            success = false;
+        }
+    }
+
+    if (fclose(stream) != 0) {
+        success = false;
+    }
+
+    return success;
+}
+
+#endif /* ARCANUM_TOOLS_BENCH_H_ */
@@ -0,0 +1,331 @@
+// Renders synthetic lights into a light buffer with `tig_color_add_span` and
+// with plain `tig_color_add` loop, checks that both buffers match and reports
+// the time spent by each.
+//
+// Also writes synthetic light art and checks that light masks decoded from raw
+// frame pixels match `tig_art_frame_get_pixel_color` on every pixel.
+//
+// Usage: light_bench [num_lights]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+// Light buffer size in cells, roughly what a 1600x1200 screen needs with
+// 40x20 cells (with some overdraw).
+#define BUFFER_WIDTH 48
+#define BUFFER_HEIGHT 64
+
+#define MAX_RADIUS 24
+#define NUM_PASSES 16
+
+#define DATA_DIR "light_bench_data"
+#define ART_FILE_NAME "light.art"
+#define NUM_ART_FRAMES 6
+
+// Same as in `light.c`.
+#define LIGHT_MASK_OPAQUE 0x80000000u
+
+typedef struct BenchLight {
+    int x;
+    int y;
+    int radius;
+    uint32_t* mask;
+} BenchLight;
+
+typedef void(AccumulateFunc)(uint32_t* dst, const uint32_t* src, int cnt);
+
+static void light_create(BenchLight* light, unsigned int* seed_ptr);
+static void light_render(BenchLight* lights, int num_lights, uint32_t* buffer, AccumulateFunc* func);
+static void accumulate_scalar(uint32_t* dst, const uint32_t* src, int cnt);
+static int light_art_resolve_path(tig_art_id_t art_id, char* path);
+static bool check_light_masks(unsigned int* seed_ptr);
+static bool check_light_mask(tig_art_id_t art_id);
+
+int main(int argc, char** argv)
+{
+    int num_lights = 1000;
+    unsigned int seed = 0x4D7F30;
+    BenchLight* lights;
+    uint32_t* scalar_buffer;
+    uint32_t* simd_buffer;
+    double start;
+    double scalar_ms;
+    double simd_ms;
+    int pass;
+    int idx;
+    int rc;
+
+    if (argc > 1) {
+        num_lights = atoi(argv[1]);
+        if (num_lights <= 0) {
+            fprintf(stderr, "Usage: %s [num_lights]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    bench_art_init(light_art_resolve_path);
+
+    lights = (BenchLight*)MALLOC(sizeof(*lights) * num_lights);
+    for (idx = 0; idx < num_lights; idx++) {
+        light_create(&(lights[idx]), &seed);
+    }
+
+    scalar_buffer = (uint32_t*)MALLOC(sizeof(*scalar_buffer) * BUFFER_WIDTH * BUFFER_HEIGHT);
+    simd_buffer = (uint32_t*)MALLOC(sizeof(*simd_buffer) * BUFFER_WIDTH * BUFFER_HEIGHT);
+
+    start = bench_now();
+    for (pass = 0; pass < NUM_PASSES; pass++) {
+        light_render(lights, num_lights, scalar_buffer, accumulate_scalar);
+    }
+    scalar_ms = bench_now() - start;
+
+    start = bench_now();
+    for (pass = 0; pass < NUM_PASSES; pass++) {
+        light_render(lights, num_lights, simd_buffer, tig_color_add_span);
+    }
+    simd_ms = bench_now() - start;
+
+    if (memcmp(scalar_buffer, simd_buffer, sizeof(*scalar_buffer) * BUFFER_WIDTH * BUFFER_HEIGHT) == 0) {
+        printf("%d lights, %d passes: scalar %.2f ms, span %.2f ms (%.2fx)\n",
+            num_lights,
+            NUM_PASSES,
+            scalar_ms,
+            simd_ms,
+            simd_ms > 0 ? scalar_ms / simd_ms : 0.0);
+        rc = EXIT_SUCCESS;
+    } else {
+        printf("Light buffers do not match\n");
+        rc = EXIT_FAILURE;
+    }
+
+    if (!check_light_masks(&seed)) {
+        rc = EXIT_FAILURE;
+    }
+
+    for (idx = 0; idx < num_lights; idx++) {
+        FREE(lights[idx].mask);
+    }
+    FREE(lights);
+    FREE(scalar_buffer);
+    FREE(simd_buffer);
+
+    bench_art_exit();
+
+    return rc;
+}
+
+// Creates light with tinted radial falloff at random location (partially
+// offscreen lights are intended).
+void light_create(BenchLight* light, unsigned int* seed_ptr)
+{
+    int size;
+    int red;
+    int green;
+    int blue;
+    int x;
+    int y;
+    int dist;
+    int intensity;
+
+    light->radius = 4 + bench_rand(seed_ptr) % (MAX_RADIUS - 4);
+    light->x = (int)(bench_rand(seed_ptr) % (BUFFER_WIDTH + light->radius)) - light->radius;
+    light->y = (int)(bench_rand(seed_ptr) % (BUFFER_HEIGHT + light->radius)) - light->radius;
+
+    red = 128 + bench_rand(seed_ptr) % 128;
+    green = 128 + bench_rand(seed_ptr) % 128;
+    blue = 128 + bench_rand(seed_ptr) % 128;
+
+    size = light->radius * 2 + 1;
+    light->mask = (uint32_t*)MALLOC(sizeof(*light->mask) * size * size);
+
+    for (y = 0; y < size; y++) {
+        for (x = 0; x < size; x++) {
+            dist = abs(x - light->radius) + abs(y - light->radius);
+            intensity = dist < light->radius
+                ? 256 * (light->radius - dist) / light->radius
+                : 0;
+            light->mask[y * size + x] = tig_color_make(red * intensity / 256,
+                green * intensity / 256,
+                blue * intensity / 256);
+        }
+    }
+}
+
+// Accumulates every light into the buffer row by row, the same way
+// `light_render_rect` feeds runs of samples.
+void light_render(BenchLight* lights, int num_lights, uint32_t* buffer, AccumulateFunc* func)
+{
+    BenchLight* light;
+    int size;
+    int min_x;
+    int max_x;
+    int y;
+    int idx;
+
+    memset(buffer, 0, sizeof(*buffer) * BUFFER_WIDTH * BUFFER_HEIGHT);
+
+    for (idx = 0; idx < num_lights; idx++) {
+        light = &(lights[idx]);
+        size = light->radius * 2 + 1;
+
+        min_x = light->x > 0 ? light->x : 0;
+        max_x = light->x + size < BUFFER_WIDTH ? light->x + size : BUFFER_WIDTH;
+        if (min_x >= max_x) {
+            continue;
+        }
+
+        for (y = 0; y < size; y++) {
+            if (light->y + y < 0 || light->y + y >= BUFFER_HEIGHT) {
+                continue;
+            }
+
+            func(&(buffer[(light->y + y) * BUFFER_WIDTH + min_x]),
+                &(light->mask[y * size + min_x - light->x]),
+                max_x - min_x);
+        }
+    }
+}
+
+void accumulate_scalar(uint32_t* dst, const uint32_t* src, int cnt)
+{
+    int index;
+
+    for (index = 0; index < cnt; index++) {
+        dst[index] = tig_color_add(src[index], dst[index]);
+    }
+}
+
+int light_art_resolve_path(tig_art_id_t art_id, char* path)
+{
+    (void)art_id;
+
+    strcpy(path, ART_FILE_NAME);
+
+    return TIG_OK;
+}
+
+// Frames are a few rows high at least, and their widths are not multiples of
+// anything in particular.
+bool check_light_masks(unsigned int* seed_ptr)
+{
+    BenchArtFrame frames[NUM_ART_FRAMES];
+    uint32_t palette[256];
+    char path[TIG_MAX_PATH];
+    tig_art_id_t art_id;
+    int num_checked = 0;
+    int frame;
+    int idx;
+    bool success = true;
+
+    for (idx = 0; idx < 256; idx++) {
+        palette[idx] = ((bench_rand(seed_ptr) % 256) << 16)
+            | ((bench_rand(seed_ptr) % 256) << 8)
+            | (bench_rand(seed_ptr) % 256);
+    }
+
+    for (frame = 0; frame < NUM_ART_FRAMES; frame++) {
+        frames[frame].width = 5 + bench_rand(seed_ptr) % 60;
+        frames[frame].height = 3 + bench_rand(seed_ptr) % 40;
+        frames[frame].pixels = (uint8_t*)MALLOC(frames[frame].width * frames[frame].height);
+
+        for (idx = 0; idx < frames[frame].width * frames[frame].height; idx++) {
+            frames[frame].pixels[idx] = bench_rand(seed_ptr) % 4 == 0 ? 0 : (uint8_t)bench_rand(seed_ptr);
+        }
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", DATA_DIR, ART_FILE_NAME);
+
+    if (SDL_CreateDirectory(DATA_DIR)
+        && bench_art_write(path, frames, NUM_ART_FRAMES, palette)
+        && tig_file_repository_add(DATA_DIR)) {
+        for (frame = 0; frame < NUM_ART_FRAMES; frame++) {
+            tig_art_light_id_create(0, frame, 0, 0, &art_id);
+            if (!check_light_mask(art_id)) {
+                printf("Light mask of frame %d does not match\n", frame);
+                success = false;
+            }
+            num_checked++;
+        }
+
+        tig_file_repository_remove(DATA_DIR);
+    } else {
+        printf("Cannot write %s\n", path);
+        success = false;
+    }
+
+    remove(path);
+    SDL_RemovePath(DATA_DIR);
+
+    for (frame = 0; frame < NUM_ART_FRAMES; frame++) {
+        FREE(frames[frame].pixels);
+    }
+
+    if (success) {
+        printf("%d light masks match pixel colors\n", num_checked);
+    }
+
+    return success;
+}
+
+// Decodes the mask the same way `light_mask_decode` does.
+bool check_light_mask(tig_art_id_t art_id)
+{
+    TigArtFrameData art_frame_data;
+    TigArtAnimData art_anim_data;
+    unsigned int rgb_mask;
+    unsigned int color;
+    uint32_t expected;
+    uint32_t* colors;
+    uint8_t* pixels;
+    int count;
+    int x;
+    int y;
+    int mismatches = 0;
+
+    if (tig_art_frame_data(art_id, &art_frame_data) != TIG_OK
+        || tig_art_anim_data(art_id, &art_anim_data) != TIG_OK) {
+        return false;
+    }
+
+    count = art_frame_data.width * art_frame_data.height;
+    pixels = (uint8_t*)MALLOC(count);
+    colors = (uint32_t*)MALLOC(sizeof(*colors) * count);
+
+    if (tig_art_frame_get_raw_pixels(art_id, pixels, art_frame_data.width) != TIG_OK) {
+        FREE(colors);
+        FREE(pixels);
+        return false;
+    }
+
+    rgb_mask = tig_color_red_mask | tig_color_green_mask | tig_color_blue_mask;
+    for (x = 0; x < count; x++) {
+        color = ((uint32_t*)art_anim_data.palette2)[pixels[x]];
+        colors[x] = color != art_anim_data.color_key
+            ? (color & rgb_mask) | LIGHT_MASK_OPAQUE
+            : 0;
+    }
+
+    for (y = 0; y < art_frame_data.height; y++) {
+        for (x = 0; x < art_frame_data.width; x++) {
+            if (tig_art_frame_get_pixel_color(art_id, x, y, &color) != TIG_OK) {
+                mismatches++;
+                continue;
+            }
+
+            expected = color != art_anim_data.color_key
+                ? (color & rgb_mask) | LIGHT_MASK_OPAQUE
+                : 0;
+            if (colors[y * art_frame_data.width + x] != expected) {
+                mismatches++;
+            }
+        }
+    }
+
+    FREE(colors);
+    FREE(pixels);
+
+    return mismatches == 0;
+}
@@ -0,0 +1,248 @@
+// Writes a synthetic set of message files into a scratch directory, then
+// loads all of them the way the game does at startup and checks that every
+// entry is found with the expected text. Reports the time spent loading the
+// whole set (best of several passes).
+//
+// The set mixes files written in order with files written in reverse (which
+// have to be sorted), CRLF line endings and comments between entries.
+//
+// Usage: mes_bench [num_files]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "game/mes.h"
+
+#define DATA_DIR "mes_bench_data"
+#define NUM_PASSES 5
+
+#define MIN_ENTRIES 20
+#define MAX_ENTRIES 400
+#define MAX_TEXT 160
+
+static int file_num_entries(int file);
+static void entry_make(int file, int entry, int* num_ptr, char* text);
+static void file_name(int file, char* buffer);
+static bool file_write(int file, size_t* size_ptr);
+static bool file_check(int file, mes_file_handle_t mes_file);
+
+int main(int argc, char** argv)
+{
+    int num_files = 2000;
+    mes_file_handle_t* mes_files;
+    char path[TIG_MAX_PATH];
+    size_t total_size = 0;
+    size_t size;
+    int total_entries = 0;
+    double start;
+    double elapsed;
+    double best_ms = 0.0;
+    int pass;
+    int file;
+    int rc = EXIT_SUCCESS;
+
+    if (argc > 1) {
+        num_files = atoi(argv[1]);
+        if (num_files <= 0) {
+            fprintf(stderr, "Usage: %s [num_files]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!SDL_CreateDirectory(DATA_DIR)) {
+        fprintf(stderr, "Cannot create %s\n", DATA_DIR);
+        return EXIT_FAILURE;
+    }
+
+    for (file = 0; file < num_files; file++) {
+        if (!file_write(file, &size)) {
+            fprintf(stderr, "Cannot write message file %d\n", file);
+            rc = EXIT_FAILURE;
+            break;
+        }
+
+        total_size += size;
+        total_entries += file_num_entries(file);
+    }
+
+    mes_files = (mes_file_handle_t*)MALLOC(sizeof(*mes_files) * num_files);
+
+    if (rc == EXIT_SUCCESS && tig_file_repository_add(DATA_DIR)) {
+        for (pass = 0; pass < NUM_PASSES && rc == EXIT_SUCCESS; pass++) {
+            start = bench_now();
+            for (file = 0; file < num_files; file++) {
+                file_name(file, path);
+                if (!mes_load(path, &(mes_files[file]))) {
+                    printf("Cannot load %s\n", path);
+                    rc = EXIT_FAILURE;
+                    break;
+                }
+            }
+            elapsed = bench_now() - start;
+
+            if (pass == 0 || elapsed < best_ms) {
+                best_ms = elapsed;
+            }
+
+            if (rc == EXIT_SUCCESS && pass == 0) {
+                for (file = 0; file < num_files; file++) {
+                    if (!file_check(file, mes_files[file])) {
+                        rc = EXIT_FAILURE;
+                    }
+                }
+            }
+
+            // Unload whatever was loaded, so that the next pass parses every
+            // file again.
+            while (file > 0) {
+                file--;
+                mes_unload(mes_files[file]);
+            }
+        }
+
+        tig_file_repository_remove(DATA_DIR);
+    } else {
+        rc = EXIT_FAILURE;
+    }
+
+    if (rc == EXIT_SUCCESS) {
+        printf("%d files, %d entries, %.1f MB: load %.2f ms (best of %d), %.0f files/s\n",
+            num_files,
+            total_entries,
+            (double)total_size / (1024.0 * 1024.0),
+            best_ms,
+            NUM_PASSES,
+            best_ms > 0 ? num_files * 1000.0 / best_ms : 0.0);
+    }
+
+    for (file = 0; file < num_files; file++) {
+        snprintf(path, sizeof(path), "%s/", DATA_DIR);
+        file_name(file, path + strlen(path));
+        remove(path);
+    }
+    SDL_RemovePath(DATA_DIR);
+
+    FREE(mes_files);
+
+    return rc;
+}
+
+int file_num_entries(int file)
+{
+    unsigned int seed = 0x4D4920 + file;
+
+    return MIN_ENTRIES + bench_rand(&seed) % (MAX_ENTRIES - MIN_ENTRIES + 1);
+}
+
+// Entry numbers increase with gaps, texts vary in length and some span
+// several lines, like dialog files.
+void entry_make(int file, int entry, int* num_ptr, char* text)
+{
+    unsigned int seed = (unsigned int)file * 7919u + (unsigned int)entry * 104729u;
+    int len;
+    int pos;
+    unsigned int ch;
+
+    *num_ptr = entry * 3 + bench_rand(&seed) % 3;
+
+    pos = snprintf(text, MAX_TEXT, "File %d, entry %d:", file, entry);
+    len = pos + bench_rand(&seed) % (MAX_TEXT - pos - 1);
+    while (pos < len) {
+        ch = bench_rand(&seed) % 40;
+        if (ch < 26) {
+            text[pos++] = (char)('a' + ch);
+        } else if (ch == 26) {
+            text[pos++] = '\n';
+        } else {
+            text[pos++] = ' ';
+        }
+    }
+    text[pos] = '\0';
+}
+
+void file_name(int file, char* buffer)
+{
+    sprintf(buffer, "bench%05d.mes", file);
+}
+
+bool file_write(int file, size_t* size_ptr)
+{
+    char path[TIG_MAX_PATH];
+    char text[MAX_TEXT];
+    const char* eol;
+    FILE* stream;
+    int num_entries;
+    int entry;
+    int idx;
+    int num;
+    long size;
+
+    snprintf(path, sizeof(path), "%s/", DATA_DIR);
+    file_name(file, path + strlen(path));
+
+    stream = fopen(path, "wb");
+    if (stream == NULL) {
+        return false;
+    }
+
+    eol = file % 4 == 0 ? "\r\n" : "\n";
+    num_entries = file_num_entries(file);
+
+    fprintf(stream, "// Synthetic message file %d%s%s", file, eol, eol);
+
+    for (idx = 0; idx < num_entries; idx++) {
+        entry = file % 8 == 0 ? num_entries - 1 - idx : idx;
+        entry_make(file, entry, &num, text);
+
+        if (entry % 16 == 0) {
+            fprintf(stream, "%s// Section %d%s", eol, entry / 16, eol);
+        }
+
+        fprintf(stream, "{%d}{%s}%s", num, text, eol);
+    }
+
+    size = ftell(stream);
+    fclose(stream);
+
+    *size_ptr = size > 0 ? (size_t)size : 0;
+
+    return true;
+}
+
+bool file_check(int file, mes_file_handle_t mes_file)
+{
+    MesFileEntry mes_file_entry;
+    char text[MAX_TEXT];
+    int num_entries;
+    int entry;
+    int num;
+    int failed = 0;
+
+    num_entries = file_num_entries(file);
+    if (mes_num_entries(mes_file) != num_entries) {
+        printf("File %d: %d entries, expected %d\n",
+            file,
+            mes_num_entries(mes_file),
+            num_entries);
+        return false;
+    }
+
+    for (entry = 0; entry < num_entries; entry++) {
+        entry_make(file, entry, &num, text);
+
+        mes_file_entry.num = num;
+        if (!mes_search(mes_file, &mes_file_entry)
+            || strcmp(mes_file_entry.str, text) != 0) {
+            failed++;
+        }
+    }
+
+    if (failed != 0) {
+        printf("File %d: %d of %d entries do not match\n", file, failed, num_entries);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,226 @@
+// Populates the object pool and the perm lookup table with synthetic objects
+// and checks the hash indexes behind `objp_perm_lookup` and
+// `objp_perm_get_oid` against a plain model of the table:
+// - every ID resolves to the handle it was last bound to;
+// - every handle resolves to the smallest ID bound to it (in `objid_compare`
+//   order), including handles which lost their best ID to another handle;
+// - both still hold after `objp_perm_lookup_compact`;
+// - reports the time spent populating the table and resolving IDs both ways.
+//
+// Usage: obj_perm_bench [num_objects]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "game/obj_pool.h"
+
+// Stays well below the pool cap.
+#define MAX_OBJECTS 1000000
+
+// Every n-th object gets two additional IDs (like objects which were assigned
+// GUID after being referenced by load order ID).
+#define EXTRA_OID_STEP 8
+
+// Every n-th object with additional IDs then loses one of them to the next
+// object.
+#define REBIND_STEP 2
+
+typedef struct BenchBinding {
+    ObjectID oid;
+    int owner;
+} BenchBinding;
+
+static ObjectID oid_create(int index, unsigned int* seed_ptr);
+static bool check_bindings(BenchBinding* bindings, int num_bindings, int64_t* objs, int num_objects);
+
+int main(int argc, char** argv)
+{
+    int num_objects = 100000;
+    unsigned int seed = 0x4E4FD0;
+    int64_t* objs;
+    BenchBinding* bindings;
+    int num_bindings;
+    int num_extra;
+    int num_kept;
+    double start;
+    double populate_ms;
+    double lookup_ms;
+    double get_oid_ms;
+    int idx;
+    int rc = EXIT_SUCCESS;
+
+    if (argc > 1) {
+        num_objects = atoi(argv[1]);
+        if (num_objects <= 1 || num_objects > MAX_OBJECTS) {
+            fprintf(stderr, "Usage: %s [num_objects]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    obj_pool_init(16, false);
+
+    objs = (int64_t*)MALLOC(sizeof(*objs) * num_objects);
+    bindings = (BenchBinding*)MALLOC(sizeof(*bindings) * (num_objects + 2 * (num_objects / EXTRA_OID_STEP + 1)));
+
+    for (idx = 0; idx < num_objects; idx++) {
+        obj_pool_allocate(&(objs[idx]));
+        bindings[idx].oid = oid_create(idx, &seed);
+        bindings[idx].owner = idx;
+    }
+    num_bindings = num_objects;
+
+    start = bench_now();
+    for (idx = 0; idx < num_bindings; idx++) {
+        objp_perm_lookup_set(bindings[idx].oid, objs[bindings[idx].owner]);
+    }
+    populate_ms = bench_now() - start;
+
+    // The first additional ID is unique load order ID which sorts after the
+    // object's own load order ID (but before GUID). The second one sorts
+    // before every other ID, so it takes over handle to ID resolution, until
+    // it is rebound and the object has to pick the best of the remaining IDs.
+    num_extra = 0;
+    for (idx = 0; idx < num_objects; idx += EXTRA_OID_STEP) {
+        bindings[num_bindings].oid = objid_create_a(idx * 3 + 2);
+        bindings[num_bindings].owner = idx;
+        objp_perm_lookup_set(bindings[num_bindings].oid, objs[idx]);
+        num_bindings++;
+
+        bindings[num_bindings].oid = objid_create_a(-1 - idx);
+        bindings[num_bindings].owner = idx;
+        objp_perm_lookup_set(bindings[num_bindings].oid, objs[idx]);
+        num_bindings++;
+
+        num_extra += 2;
+    }
+
+    for (idx = num_objects + 1; idx < num_bindings; idx += 2 * REBIND_STEP) {
+        bindings[idx].owner = (bindings[idx].owner + 1) % num_objects;
+        objp_perm_lookup_set(bindings[idx].oid, objs[bindings[idx].owner]);
+    }
+
+    if (!check_bindings(bindings, num_bindings, objs, num_objects)) {
+        rc = EXIT_FAILURE;
+    }
+
+    start = bench_now();
+    for (idx = 0; idx < num_bindings; idx++) {
+        objp_perm_lookup(bindings[idx].oid);
+    }
+    lookup_ms = bench_now() - start;
+
+    start = bench_now();
+    for (idx = 0; idx < num_objects; idx++) {
+        objp_perm_get_oid(objs[idx]);
+    }
+    get_oid_ms = bench_now() - start;
+
+    printf("%d objects, %d extra IDs: populate %.2f ms, lookup %.2f ms, get oid %.2f ms\n",
+        num_objects,
+        num_extra,
+        populate_ms,
+        lookup_ms,
+        get_oid_ms);
+
+    // Compacting keeps load order IDs only.
+    objp_perm_lookup_compact();
+
+    num_kept = 0;
+    for (idx = 0; idx < num_bindings; idx++) {
+        if (bindings[idx].oid.type == OID_TYPE_A) {
+            bindings[num_kept++] = bindings[idx];
+        } else if (objp_perm_lookup(bindings[idx].oid) != OBJ_HANDLE_NULL) {
+            printf("ID %d is still bound after compacting\n", idx);
+            rc = EXIT_FAILURE;
+        }
+    }
+
+    if (!check_bindings(bindings, num_kept, objs, num_objects)) {
+        printf("Bindings do not match after compacting\n");
+        rc = EXIT_FAILURE;
+    }
+
+    for (idx = 0; idx < num_objects; idx++) {
+        obj_pool_deallocate(objs[idx]);
+    }
+
+    FREE(bindings);
+    FREE(objs);
+
+    obj_pool_exit();
+
+    return rc;
+}
+
+// Mixes load order IDs and GUIDs the way a saved game does, load order IDs
+// are sparse so that they do not resolve in insertion order.
+ObjectID oid_create(int index, unsigned int* seed_ptr)
+{
+    ObjectID oid;
+    int pos;
+
+    if (index % 2 == 0) {
+        oid = objid_create_a(index * 3 + 1);
+    } else {
+        memset(&oid, 0, sizeof(oid));
+        oid.type = OID_TYPE_GUID;
+        for (pos = 0; pos < 16; pos++) {
+            oid.d.g.data[pos] = (uint8_t)bench_rand(seed_ptr);
+        }
+
+        // Keeps GUIDs unique regardless of the generator.
+        memcpy(&(oid.d.g.data[12]), &index, sizeof(index));
+    }
+
+    return oid;
+}
+
+// Compares both lookups against the model. The smallest ID of every handle
+// is found with a single pass over the model.
+bool check_bindings(BenchBinding* bindings, int num_bindings, int64_t* objs, int num_objects)
+{
+    int* best;
+    ObjectID oid;
+    int lookup_failed = 0;
+    int get_oid_failed = 0;
+    int idx;
+
+    best = (int*)MALLOC(sizeof(*best) * num_objects);
+    for (idx = 0; idx < num_objects; idx++) {
+        best[idx] = -1;
+    }
+
+    for (idx = 0; idx < num_bindings; idx++) {
+        if (objp_perm_lookup(bindings[idx].oid) != objs[bindings[idx].owner]) {
+            lookup_failed++;
+        }
+
+        if (best[bindings[idx].owner] == -1
+            || objid_compare(bindings[idx].oid, bindings[best[bindings[idx].owner]].oid)) {
+            best[bindings[idx].owner] = idx;
+        }
+    }
+
+    for (idx = 0; idx < num_objects; idx++) {
+        oid = objp_perm_get_oid(objs[idx]);
+        if (best[idx] != -1
+                ? !objid_is_equal(oid, bindings[best[idx]].oid)
+                : oid.type != OID_TYPE_NULL) {
+            get_oid_failed++;
+        }
+    }
+
+    FREE(best);
+
+    if (lookup_failed != 0) {
+        printf("%d of %d IDs resolve to wrong handle\n", lookup_failed, num_bindings);
+    }
+
+    if (get_oid_failed != 0) {
+        printf("%d of %d handles resolve to wrong ID\n", get_oid_failed, num_objects);
+    }
+
+    return lookup_failed == 0 && get_oid_failed == 0;
+}